@@ -0,0 +1,533 @@
+//===========================================================
+// bfCPU Running Tool
+//-----------------------------------------------------------
+// File Name   : console.c
+// Description : UART Console Bridge
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+//
+#include "console.h"
+#include "mapfile.h"
+#include "utility.h"
+
+//-----------------------------------------------------------
+// Console Bridge
+//     While the bfCPU runs, bfRun sleeps in epoll_pwait()
+//     until Ctrl-C or an I/O event. SIGINT is blocked except
+//     inside epoll_pwait(), so ctrl_c set by the handler is
+//     never missed between the check and the sleep.
+//     If a UART tty is given, it is opened in raw mode and
+//     bridged to stdin/stdout through a buffer for each
+//     direction. Regular files, which epoll can't watch,
+//     are treated as always ready.
+//     In Test Mode, a file is sent instead of stdin, and
+//     the output is compared with the expected file until
+//     a stop condition, measuring the time to the first
+//     byte and the bytes per second.
+//-----------------------------------------------------------
+extern int ctrl_c;
+
+//-------------------------
+// Buffer (data[pos..len))
+//-------------------------
+typedef struct
+{
+    unsigned char data[CONSOLE_BUF_SIZE];
+    int pos;
+    int len;
+} sCONSOLE_BUF;
+
+//-------------------------
+// Watched File
+//-------------------------
+typedef struct
+{
+    int fd;
+    int polled;      // 0 if epoll can't watch it
+    uint32_t events; // events registered in epoll
+} sCONSOLE_FD;
+
+//-------------------------
+// Console State
+//-------------------------
+static sCONSOLE_FD  con_tty = {-1, 1, 0};
+static sCONSOLE_FD  con_in  = {STDIN_FILENO , 1, 0};
+static sCONSOLE_FD  con_out = {STDOUT_FILENO, 1, 0};
+static sCONSOLE_BUF con_tx; // stdin -> tty
+static sCONSOLE_BUF con_rx; // tty -> stdout
+static struct termios con_tty_save;
+static FILE  *con_log = NULL;
+static double con_time_start;
+//
+// Test Mode State
+static struct
+{
+    sMAPFILE expect;
+    int    opened;       // 1 if expect is opened
+    long   bytes;        // stop after bytes received (-1 for none)
+    long   received;     // bytes received
+    long   bad;          // first mismatch (-1 for none)
+    unsigned char data_bad;
+    double time_first;   // first byte received
+    double time_last;    // last byte received
+} con_test;
+
+//-------------------------
+// Standard Baud Rates
+//-------------------------
+static const struct
+{
+    int baud;
+    speed_t speed;
+} console_speeds[] =
+{
+    {   9600, B9600  },
+    {  19200, B19200 },
+    {  38400, B38400 },
+    {  57600, B57600 },
+    { 115200, B115200},
+    { 230400, B230400},
+    { 460800, B460800},
+    { 921600, B921600},
+    {      0, B0     }
+};
+
+//------------------------------
+// Open UART tty in Raw Mode
+//     tty may be NULL (no bridge).
+//     Returns 0 if OK.
+//------------------------------
+int Console_Open(const char *tty, int baud, const char *log)
+{
+    struct termios tio;
+    int i;
+    //
+    if (log != NULL)
+    {
+        if ((con_log = fopen(log, "w")) == NULL)
+        {
+            fprintf(stderr, "Can't open \"%s\".\n", log);
+            return 1;
+        }
+        fprintf(con_log, "# Time[s] Dir Byte (TX: Console to bfCPU, RX: bfCPU to Console)\n");
+    }
+    if (tty == NULL) return 0;
+    //
+    for (i = 0; console_speeds[i].baud != 0; i++)
+    {
+        if (console_speeds[i].baud == baud) break;
+    }
+    if (console_speeds[i].baud == 0)
+    {
+        fprintf(stderr, "Unsupported Baud Rate %d.\n", baud);
+        return 1;
+    }
+    if ((con_tty.fd = open(tty, O_RDWR | O_NOCTTY | O_NONBLOCK)) < 0)
+    {
+        fprintf(stderr, "Can't open \"%s\".\n", tty);
+        return 1;
+    }
+    if (tcgetattr(con_tty.fd, &con_tty_save) < 0)
+    {
+        fprintf(stderr, "\"%s\" is not a tty.\n", tty);
+        close(con_tty.fd);
+        con_tty.fd = -1;
+        return 1;
+    }
+    tio = con_tty_save;
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN]  = 1;
+    tio.c_cc[VTIME] = 0;
+    cfsetispeed(&tio, console_speeds[i].speed);
+    cfsetospeed(&tio, console_speeds[i].speed);
+    tcsetattr(con_tty.fd, TCSANOW, &tio);
+    tcflush(con_tty.fd, TCIOFLUSH);
+    return 0;
+}
+
+//------------------------------
+// Close UART tty
+//------------------------------
+void Console_Close(void)
+{
+    if (con_tty.fd >= 0)
+    {
+        tcsetattr(con_tty.fd, TCSANOW, &con_tty_save);
+        close(con_tty.fd);
+        con_tty.fd = -1;
+    }
+    if (con_log)
+    {
+        fclose(con_log);
+        con_log = NULL;
+    }
+}
+
+//------------------------------
+// Log Byte Timing
+//------------------------------
+static void Console_Log(const char *dir, const unsigned char *data, int size)
+{
+    double time;
+    int i;
+    //
+    if (con_log == NULL) return;
+    time = Get_Time() - con_time_start;
+    for (i = 0; i < size; i++)
+    {
+        fprintf(con_log, "%12.6f %s 0x%02x %c\n",
+            time, dir, data[i], isprint(data[i])? data[i] : '.');
+    }
+}
+
+//------------------------------
+// Free Space in Buffer
+//     Moves pending bytes to the top.
+//------------------------------
+static int Console_Buf_Space(sCONSOLE_BUF *psBUF)
+{
+    if (psBUF->pos > 0)
+    {
+        memmove(psBUF->data, &psBUF->data[psBUF->pos], psBUF->len - psBUF->pos);
+        psBUF->len -= psBUF->pos;
+        psBUF->pos  = 0;
+    }
+    return CONSOLE_BUF_SIZE - psBUF->len;
+}
+
+//------------------------------
+// Read into Buffer
+//     Returns read() result.
+//------------------------------
+static int Console_Read(int fd, sCONSOLE_BUF *psBUF, const char *dir)
+{
+    int size;
+    //
+    errno = 0;
+    size = read(fd, &psBUF->data[psBUF->len], Console_Buf_Space(psBUF));
+    if (size > 0)
+    {
+        if (dir) Console_Log(dir, &psBUF->data[psBUF->len], size);
+        psBUF->len += size;
+    }
+    return size;
+}
+
+//------------------------------
+// Write from Buffer
+//     Returns write() result.
+//------------------------------
+static int Console_Write(int fd, sCONSOLE_BUF *psBUF, const char *dir)
+{
+    int size;
+    //
+    size = write(fd, &psBUF->data[psBUF->pos], psBUF->len - psBUF->pos);
+    if (size > 0)
+    {
+        if (dir) Console_Log(dir, &psBUF->data[psBUF->pos], size);
+        psBUF->pos += size;
+        if (psBUF->pos == psBUF->len) psBUF->pos = psBUF->len = 0;
+    }
+    return size;
+}
+
+//------------------------------
+// Update Events to be Watched
+//------------------------------
+static void Console_Watch(int epfd, sCONSOLE_FD *psFD, uint32_t events)
+{
+    struct epoll_event ev;
+    int result;
+    //
+    if ((psFD->fd < 0) || (psFD->polled == 0) || (psFD->events == events)) return;
+    ev.events = events;
+    ev.data.ptr = psFD;
+    if (events == 0)
+        result = epoll_ctl(epfd, EPOLL_CTL_DEL, psFD->fd, NULL);
+    else if (psFD->events == 0)
+        result = epoll_ctl(epfd, EPOLL_CTL_ADD, psFD->fd, &ev);
+    else
+        result = epoll_ctl(epfd, EPOLL_CTL_MOD, psFD->fd, &ev);
+    if ((result < 0) && (errno == EPERM))
+        psFD->polled = 0;
+    else
+        psFD->events = events;
+}
+
+//------------------------------
+// Ready Events
+//------------------------------
+static uint32_t Console_Ready(sCONSOLE_FD *psFD, uint32_t want, struct epoll_event *evs, int num)
+{
+    uint32_t ready = 0;
+    int i;
+    //
+    if (psFD->polled == 0) return want;
+    for (i = 0; i < num; i++)
+    {
+        if (evs[i].data.ptr != psFD) continue;
+        ready = evs[i].events;
+        // Hang-up or Error is found by read() or write()
+        if (ready & (EPOLLHUP | EPOLLERR)) ready |= want;
+    }
+    return ready & want;
+}
+
+//------------------------------
+// Test Mode: Open Files
+//     Returns 0 if OK.
+//------------------------------
+static int Console_Test_Open(const sCONSOLE_TEST *psTEST)
+{
+    memset(&con_test, 0, sizeof(con_test));
+    con_test.bad = -1;
+    if (psTEST == NULL) return 0;
+    //
+    if (psTEST->input)
+    {
+        if ((con_in.fd = open(psTEST->input, O_RDONLY)) < 0)
+        {
+            fprintf(stderr, "Can't open \"%s\".\n", psTEST->input);
+            con_in.fd = STDIN_FILENO;
+            return 1;
+        }
+    }
+    if (psTEST->expect)
+    {
+        if (MAP_File_Open(&con_test.expect, psTEST->expect))
+        {
+            fprintf(stderr, "Can't open \"%s\".\n", psTEST->expect);
+            return 1;
+        }
+        con_test.opened = 1;
+    }
+    con_test.bytes = psTEST->bytes;
+    if ((psTEST->expect) && (con_test.bytes < 0) && (psTEST->term < 0))
+    {
+        con_test.bytes = (long)con_test.expect.size;
+    }
+    return 0;
+}
+
+//------------------------------
+// Test Mode: Check Received Bytes
+//     Returns 1 at a stop condition.
+//------------------------------
+static int Console_Test_Check(const sCONSOLE_TEST *psTEST, const unsigned char *data, int size)
+{
+    int i;
+    //
+    if (psTEST == NULL) return 0;
+    if (con_test.received == 0) con_test.time_first = Get_Time() - con_time_start;
+    con_test.time_last = Get_Time() - con_time_start;
+    for (i = 0; i < size; i++)
+    {
+        if ((con_test.opened) && (con_test.bad < 0))
+        {
+            if ((con_test.received >= (long)con_test.expect.size)
+             || (con_test.expect.data[con_test.received] != data[i]))
+            {
+                con_test.bad = con_test.received;
+                con_test.data_bad = data[i];
+            }
+        }
+        con_test.received++;
+        if ((con_test.bytes >= 0) && (con_test.received >= con_test.bytes)) return 1;
+        if ((psTEST->term >= 0) && (data[i] == psTEST->term)) return 1;
+    }
+    return 0;
+}
+
+//------------------------------
+// Test Mode: Report and Close
+//     Returns 0 if passed.
+//------------------------------
+static int Console_Test_Close(const sCONSOLE_TEST *psTEST, int stop)
+{
+    double rate;
+    int fail = 0;
+    //
+    if (psTEST == NULL) return 0;
+    if (con_in.fd != STDIN_FILENO)
+    {
+        close(con_in.fd);
+        con_in.fd = STDIN_FILENO;
+    }
+    //
+    printf("Test Result...");
+    if (con_test.received == 0)
+    {
+        printf("No Output");
+        fail = 1;
+    }
+    else if (con_test.bad >= 0)
+    {
+        if (con_test.bad < (long)con_test.expect.size)
+            printf("NG at Byte %ld (Expected 0x%02x, Received 0x%02x)", con_test.bad,
+                con_test.expect.data[con_test.bad], con_test.data_bad);
+        else
+            printf("NG at Byte %ld (Expected End, Received 0x%02x)", con_test.bad, con_test.data_bad);
+        fail = 1;
+    }
+    else if ((con_test.opened) && (con_test.received < (long)con_test.expect.size))
+    {
+        printf("NG at Byte %ld (Expected 0x%02x, Received None)", con_test.received,
+            con_test.expect.data[con_test.received]);
+        fail = 1;
+    }
+    else if ((stop == 0) && ((con_test.bytes >= 0) || (psTEST->term >= 0)))
+    {
+        printf("NG (Stopped before the Condition)");
+        fail = 1;
+    }
+    else
+    {
+        printf("OK");
+    }
+    //
+    // Measured Speed
+    rate = (con_test.time_last > con_test.time_first)?
+        (double)con_test.received / (con_test.time_last - con_test.time_first) : 0.0;
+    printf(" (%ld bytes, First Output %.3fs, %.1f bytes/s).\n",
+        con_test.received, con_test.time_first, rate);
+    //
+    if (con_test.opened) MAP_File_Close(&con_test.expect);
+    con_test.opened = 0;
+    return fail;
+}
+
+//------------------------------
+// Run Console until Ctrl-C
+//     or Hang-up of the tty
+//     (or a Stop Condition in Test Mode)
+//     Returns 0 if OK.
+//------------------------------
+int Console_Run(const sCONSOLE_TEST *psTEST)
+{
+    struct epoll_event evs[3];
+    struct termios tio_in, tio_in_save;
+    sigset_t sig_block, sig_save;
+    uint32_t want_tty, want_in, want_out;
+    uint32_t rdy_tty, rdy_in, rdy_out;
+    int in_raw, in_eof, hangup, stop;
+    int epfd, num, size, timeout, remain;
+    //
+    if ((epfd = epoll_create1(0)) < 0)
+    {
+        fprintf(stderr, "Can't create epoll instance.\n");
+        return 1;
+    }
+    if (Console_Test_Open(psTEST))
+    {
+        close(epfd);
+        return 1;
+    }
+    fflush(stdout);
+    //
+    // Block SIGINT except in epoll_pwait()
+    sigemptyset(&sig_block);
+    sigaddset(&sig_block, SIGINT);
+    sigprocmask(SIG_BLOCK, &sig_block, &sig_save);
+    //
+    // Keys are sent one by one without Echo (Ctrl-C still works)
+    in_raw = (con_tty.fd >= 0) && isatty(con_in.fd) && (tcgetattr(con_in.fd, &tio_in_save) == 0);
+    if (in_raw)
+    {
+        tio_in = tio_in_save;
+        tio_in.c_lflag &= ~(ICANON | ECHO);
+        tio_in.c_cc[VMIN]  = 1;
+        tio_in.c_cc[VTIME] = 0;
+        tcsetattr(con_in.fd, TCSANOW, &tio_in);
+    }
+    //
+    in_eof = (con_tty.fd < 0);
+    hangup = 0;
+    stop   = 0;
+    con_time_start = Get_Time();
+    while ((ctrl_c == 0) && (hangup == 0) && (stop == 0))
+    {
+        // Events to be Watched
+        want_tty = 0;
+        if (con_tty.fd >= 0)
+        {
+            want_tty |= (Console_Buf_Space(&con_rx) > 0)? EPOLLIN : 0;
+            want_tty |= (con_tx.len > con_tx.pos)? EPOLLOUT : 0;
+        }
+        want_in  = ((in_eof == 0) && (Console_Buf_Space(&con_tx) > 0))? EPOLLIN : 0;
+        want_out = (con_rx.len > con_rx.pos)? EPOLLOUT : 0;
+        Console_Watch(epfd, &con_tty, want_tty);
+        Console_Watch(epfd, &con_in , want_in );
+        Console_Watch(epfd, &con_out, want_out);
+        //
+        // Sleep
+        timeout = ((con_in.polled == 0) && want_in) || ((con_out.polled == 0) && want_out)? 0 : -1;
+        if ((psTEST) && (psTEST->timeout > 0))
+        {
+            remain = (int)((psTEST->timeout - (Get_Time() - con_time_start)) * 1000.0);
+            if (remain <= 0) break;
+            if ((timeout < 0) || (remain < timeout)) timeout = remain;
+        }
+        num = epoll_pwait(epfd, evs, 3, timeout, &sig_save);
+        if ((num < 0) && (errno == EINTR)) continue;
+        if (num < 0) break;
+        rdy_tty = Console_Ready(&con_tty, want_tty, evs, num);
+        rdy_in  = Console_Ready(&con_in , want_in , evs, num);
+        rdy_out = Console_Ready(&con_out, want_out, evs, num);
+        //
+        // bfCPU to Console
+        if (rdy_tty & EPOLLIN)
+        {
+            size = Console_Read(con_tty.fd, &con_rx, "RX");
+            if (size > 0)
+                stop = Console_Test_Check(psTEST, &con_rx.data[con_rx.len - size], size);
+            else if ((errno != EAGAIN) && (errno != EINTR))
+                hangup = 1;
+        }
+        if ((rdy_out & EPOLLOUT) && (Console_Write(con_out.fd, &con_rx, NULL) < 0))
+        {
+            if (errno != EINTR) con_rx.pos = con_rx.len = 0;
+        }
+        //
+        // Console to bfCPU
+        if ((rdy_in & EPOLLIN) && (Console_Read(con_in.fd, &con_tx, NULL) <= 0))
+        {
+            if (errno != EINTR) in_eof = 1;
+        }
+        if ((rdy_tty & EPOLLOUT) && (Console_Write(con_tty.fd, &con_tx, "TX") < 0))
+        {
+            if ((errno != EAGAIN) && (errno != EINTR)) hangup = 1;
+        }
+    }
+    //
+    // Flush Output
+    while ((con_rx.len > con_rx.pos) && (Console_Write(con_out.fd, &con_rx, NULL) > 0));
+    if (hangup) printf("\nUART Console Hung Up.\n");
+    //
+    // Restore
+    if (in_raw) tcsetattr(con_in.fd, TCSANOW, &tio_in_save);
+    sigprocmask(SIG_SETMASK, &sig_save, NULL);
+    close(epfd);
+    //
+    if (psTEST) printf("\n");
+    return Console_Test_Close(psTEST, stop);
+}
+
+//===========================================================
+// End of File
+//===========================================================
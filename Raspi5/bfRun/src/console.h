@@ -0,0 +1,47 @@
+//===========================================================
+// bfCPU Running Tool
+//-----------------------------------------------------------
+// File Name   : console.h
+// Description : UART Console Bridge Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#ifndef __CONSOLE_H__
+#define __CONSOLE_H__
+
+//-------------------------------
+// Parameters
+//-------------------------------
+#define CONSOLE_BUF_SIZE     4096 // bytes buffered in each direction
+#define CONSOLE_TEST_TIMEOUT 10 // seconds, default in Test Mode
+
+//-------------------------------
+// Test Mode
+//     The input file is sent instead
+//     of stdin, and the run stops at
+//     one of the conditions.
+//-------------------------------
+typedef struct
+{
+    const char *input;  // file sent to UART (NULL for stdin)
+    const char *expect; // file compared with output (NULL for none)
+    long   bytes;       // stop after bytes received (-1 for none)
+    int    term;        // stop at this byte received (-1 for none)
+    double timeout;     // stop after seconds (0 for none)
+} sCONSOLE_TEST;
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+int  Console_Open(const char *tty, int baud, const char *log);
+int  Console_Run(const sCONSOLE_TEST *psTEST);
+void Console_Close(void);
+
+#endif
+//===========================================================
+// End of File
+//===========================================================
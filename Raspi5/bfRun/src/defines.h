@@ -23,6 +23,7 @@
 // Architecture
 #define MAXROM (32768*1) // width 8bit
 #define MAXRAM (32768  ) // width 8bit
+#define RAM_BAUD_ADDR (MAXRAM - 2) // DIV0 and DIV1 at the top of RAM
 //
 #define CODE_NOP   15
 
@@ -30,6 +31,10 @@
 // Clock Frequency
 #define CLKFREQ_DEFAULT 10000000 //Hz
 
+//-----------------------------------------------------------------------
+// UART Baud Rate of bfCPU System
+#define UART_BAUD 115200 //bps, Default
+
 //-----------------------------------------------------------------------
 // Miscellaneous
 #define MAXLEN_WORD  256
@@ -51,12 +56,42 @@ enum DEBUG_LVL {DEBUG_NONE, DEBUG_MIN, DEBUG_MID, DEBUG_MAX};
 
 //-----------------------------------------------------------------------
 // Command Line Option
-enum BF_OPT    {OPT_CLK};
+enum BF_OPT    {OPT_CLK, OPT_GPIO, OPT_DELTA, OPT_VERIFY, OPT_PRE, OPT_DUMP, OPT_TTY, OPT_LOG, OPT_PERIOD, OPT_DUTY, OPT_BAUD,
+                OPT_INPUT, OPT_EXPECT, OPT_BYTES, OPT_TERM, OPT_TIMEOUT};
 enum BF_OPTARG {OPT_NO, OPT_YES};
 typedef struct
 {
     int opt_clk;
     char *opt_clk_freq;
+    int opt_gpio;
+    char *opt_gpio_name;
+    int opt_delta;
+    int opt_verify;
+    char *opt_verify_level;
+    int opt_pre;
+    char *opt_pre_name;
+    int opt_dump;
+    char *opt_dump_name;
+    int opt_tty;
+    char *opt_tty_name;
+    int opt_log;
+    char *opt_log_name;
+    int opt_period;
+    char *opt_period_ns;
+    int opt_duty;
+    char *opt_duty_ns;
+    int opt_baud;
+    char *opt_baud_rate;
+    int opt_input;
+    char *opt_input_name;
+    int opt_expect;
+    char *opt_expect_name;
+    int opt_bytes;
+    char *opt_bytes_num;
+    int opt_term;
+    char *opt_term_byte;
+    int opt_timeout;
+    char *opt_timeout_sec;
     char *input_file_name;
 } sOPTION;
 
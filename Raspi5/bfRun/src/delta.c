@@ -0,0 +1,254 @@
+//===========================================================
+// bfCPU Running Tool
+//-----------------------------------------------------------
+// File Name   : delta.c
+// Description : Differential SRAM Programming
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+//
+#include "binfile.h"
+#include "defines.h"
+#include "delta.h"
+#include "gpio.h"
+#include "sram.h"
+
+//-----------------------------------------------------------
+// Image Cache
+//     The image written last time is kept in
+//     $XDG_CACHE_HOME/bfRun (or $HOME/.cache/bfRun), one file
+//     per GPIO backend and clock frequency. Only the pages
+//     which differ from it are written and read back.
+//     Before that, a few pages which are not going to be
+//     written are read and their CRC is compared with the
+//     cache. If one differs, the SRAM has been changed (or
+//     powered off) since then, and all pages are written.
+//
+//     File Format
+//         Offset  Size
+//         0       8    Magic "bfRunIMG"
+//         8       4    addr_max
+//         12      4    CRC32 of Image
+//         16      n    Image (addr_max + 1 bytes)
+//-----------------------------------------------------------
+#define DELTA_MAGIC "bfRunIMG"
+#define DELTA_PAGES (MAXROM / SRAM_PAGE_SIZE)
+
+//-------------------------
+// Cache State
+//-------------------------
+static unsigned char delta_cache[MAXROM];
+static unsigned char delta_sample[MAXROM];
+static int  delta_cache_max = -1; // addr_max of cached image, -1 if none
+static char delta_dirty[DELTA_PAGES];
+static char delta_path[MAXLEN_LINE];
+
+//------------------------------
+// Cache File Path
+//     Creates the directory if needed.
+//     Returns 0 if no path is available.
+//------------------------------
+static int Delta_Path(int freq)
+{
+    const char *base;
+    char dir[MAXLEN_LINE];
+    //
+    base = getenv("XDG_CACHE_HOME");
+    if ((base != NULL) && (base[0] != '\0'))
+    {
+        mkdir(base, 0755);
+        snprintf(dir, sizeof(dir), "%s/bfRun", base);
+    }
+    else
+    {
+        base = getenv("HOME");
+        if ((base == NULL) || (base[0] == '\0')) return 0;
+        snprintf(dir, sizeof(dir), "%s/.cache", base);
+        mkdir(dir, 0755);
+        snprintf(dir, sizeof(dir), "%s/.cache/bfRun", base);
+    }
+    mkdir(dir, 0755);
+    snprintf(delta_path, sizeof(delta_path), "%s/%s_%d.img", dir, GPIO_Backend_Name(), freq);
+    return 1;
+}
+
+//------------------------------
+// Load Cache File
+//------------------------------
+static void Delta_Load(int freq)
+{
+    FILE *fp;
+    char magic[8];
+    uint32_t addr_max, crc;
+    int ok;
+    //
+    delta_cache_max = -1;
+    if (Delta_Path(freq) == 0) return;
+    if ((fp = fopen(delta_path, "rb")) == NULL) return;
+    //
+    ok = (fread(magic, 1, 8, fp) == 8)
+      && (memcmp(magic, DELTA_MAGIC, 8) == 0)
+      && (fread(&addr_max, 4, 1, fp) == 1)
+      && (fread(&crc, 4, 1, fp) == 1)
+      && (addr_max < MAXROM)
+      && (fread(delta_cache, 1, addr_max + 1, fp) == addr_max + 1)
+      && (BIN_CRC32(0, delta_cache, addr_max + 1) == crc);
+    fclose(fp);
+    if (ok) delta_cache_max = (int)addr_max;
+}
+
+//------------------------------
+// Save Cache File
+//     If create is 0, only an existing
+//     cache is updated.
+//------------------------------
+void Delta_Save(unsigned char *rom_src, int addr_max, int freq, int create)
+{
+    FILE *fp;
+    uint32_t size = (uint32_t)addr_max;
+    uint32_t crc;
+    //
+    if (Delta_Path(freq) == 0) return;
+    if ((create == 0) && (access(delta_path, F_OK) != 0)) return;
+    if ((fp = fopen(delta_path, "wb")) == NULL)
+    {
+        fprintf(stderr, "Can't save SRAM Image Cache \"%s\".\n", delta_path);
+        return;
+    }
+    crc = BIN_CRC32(0, rom_src, addr_max + 1);
+    fwrite(DELTA_MAGIC, 1, 8, fp);
+    fwrite(&size, 4, 1, fp);
+    fwrite(&crc, 4, 1, fp);
+    fwrite(rom_src, 1, addr_max + 1, fp);
+    fclose(fp);
+}
+
+//------------------------------
+// Remove Cache File
+//------------------------------
+void Delta_Remove(int freq)
+{
+    if (Delta_Path(freq)) unlink(delta_path);
+}
+
+//------------------------------
+// Last Address of Page
+//------------------------------
+static int Delta_Page_End(int page, int addr_max)
+{
+    int end = page * SRAM_PAGE_SIZE + SRAM_PAGE_SIZE - 1;
+    return (end < addr_max)? end : addr_max;
+}
+
+//------------------------------
+// Page Differs from Cache?
+//------------------------------
+static int Delta_Page_Changed(unsigned char *rom_src, int page, int addr_max)
+{
+    int start = page * SRAM_PAGE_SIZE;
+    int end   = Delta_Page_End(page, addr_max);
+    //
+    if (end > delta_cache_max) return 1;
+    return memcmp(&rom_src[start], &delta_cache[start], end - start + 1) != 0;
+}
+
+//------------------------------
+// Check Sampled Pages
+//     Returns 1 if the cache is stale.
+//------------------------------
+static int Delta_Check_Samples(int pages, int addr_max)
+{
+    int clean[DELTA_PAGES];
+    int num = 0;
+    int page, i, pick, start, end;
+    //
+    for (page = 0; page < pages; page++)
+    {
+        if (delta_dirty[page] == 0) clean[num++] = page;
+    }
+    srand((unsigned int)time(NULL) ^ (unsigned int)getpid());
+    for (i = 0; (i < DELTA_SAMPLES) && (num > 0); i++)
+    {
+        pick  = rand() % num;
+        page  = clean[pick];
+        clean[pick] = clean[--num];
+        start = page * SRAM_PAGE_SIZE;
+        end   = Delta_Page_End(page, addr_max);
+        SRAM_Read_Range(delta_sample, start, end, NULL);
+        if (BIN_CRC32(0, &delta_sample[start], end - start + 1)
+         != BIN_CRC32(0, &delta_cache[start],  end - start + 1)) return 1;
+    }
+    return 0;
+}
+
+//------------------------------
+// Write Changed Pages
+//     Returns number of bytes written.
+//------------------------------
+int Delta_Write(unsigned char *rom_src, int addr_max, int freq)
+{
+    int pages = addr_max / SRAM_PAGE_SIZE + 1;
+    int page, first, changed;
+    int bytes = 0;
+    //
+    Delta_Load(freq);
+    //
+    changed = 0;
+    for (page = 0; page < pages; page++)
+    {
+        delta_dirty[page] = (char)Delta_Page_Changed(rom_src, page, addr_max);
+        changed += delta_dirty[page];
+    }
+    //
+    if (delta_cache_max < 0)
+    {
+        printf("(Full, No Cache)...");
+        memset(delta_dirty, 1, pages);
+    }
+    else if (Delta_Check_Samples(pages, addr_max))
+    {
+        printf("(Full, Cache Stale)...");
+        memset(delta_dirty, 1, pages);
+    }
+    else
+    {
+        printf("(Delta, %d/%d Pages)...", changed, pages);
+    }
+    //
+    // Write Runs of Changed Pages
+    page = 0;
+    while (page < pages)
+    {
+        if (delta_dirty[page] == 0) {page++; continue;}
+        first = page;
+        while ((page < pages) && delta_dirty[page]) page++;
+        SRAM_Write_Range(rom_src, first * SRAM_PAGE_SIZE, Delta_Page_End(page - 1, addr_max));
+        bytes += Delta_Page_End(page - 1, addr_max) - first * SRAM_PAGE_SIZE + 1;
+    }
+    return bytes;
+}
+
+//------------------------------
+// Changed Pages of Last Delta_Write
+//     (for SRAM_Verify)
+//------------------------------
+const char *Delta_Pages(void)
+{
+    return delta_dirty;
+}
+
+//===========================================================
+// End of File
+//===========================================================
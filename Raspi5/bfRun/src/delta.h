@@ -0,0 +1,32 @@
+//===========================================================
+// bfCPU Running Tool
+//-----------------------------------------------------------
+// File Name   : delta.h
+// Description : Differential SRAM Programming Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#ifndef __DELTA_H__
+#define __DELTA_H__
+
+//-------------------------------
+// Parameters
+//-------------------------------
+#define DELTA_SAMPLES 4 // pages read back to check the cache
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+int  Delta_Write(unsigned char *rom_src, int addr_max, int freq);
+const char *Delta_Pages(void);
+void Delta_Save(unsigned char *rom_src, int addr_max, int freq, int create);
+void Delta_Remove(int freq);
+
+#endif
+//===========================================================
+// End of File
+//===========================================================
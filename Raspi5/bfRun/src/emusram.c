@@ -0,0 +1,394 @@
+//===========================================================
+// bfCPU Running Tool
+//-----------------------------------------------------------
+// File Name   : emusram.c
+// Description : 23LC512 Serial SRAM Emulator (GPIO Backend)
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "emusram.h"
+#include "gpio.h"
+#include "pwmclk.h"
+
+//-----------------------------------------------------------
+// Model
+//     Cycle level model of RTL/QSPI_SRAM/23LC512.v driven by
+//     the pin operations of bfRun instead of a test bench.
+//     Every always block of the RTL is evaluated at the same
+//     clock edge with the register values before the edge,
+//     as the non-blocking assignments do.
+//     Pins are open drain with pull-ups, so the level of each
+//     SIO line is the AND of the host and the SRAM drivers.
+//-----------------------------------------------------------
+
+//-------------------------
+// Instruction
+//-------------------------
+#define EMU_READ  0x03
+#define EMU_WRMR  0x01
+#define EMU_WRITE 0x02
+#define EMU_RDMR  0x05
+#define EMU_EDIO  0x3b
+#define EMU_EQIO  0x38
+#define EMU_RSTIO 0xff
+//
+// Operation Mode
+#define EMU_BYTEMODE 0
+#define EMU_SEQMODE  1
+#define EMU_PAGEMODE 2
+//
+// I/O Mode
+#define EMU_SPIMODE 0
+#define EMU_SDIMODE 1
+#define EMU_SQIMODE 2
+
+//-------------------------
+// SRAM State
+//-------------------------
+typedef struct
+{
+    unsigned char mem[EMU_SRAM_SIZE];
+    uint8_t  shifter_i;  // DataShifterI
+    uint8_t  shifter_o;  // DataShifterO
+    uint32_t counter;    // ClockCounter
+    uint8_t  inst;       // InstRegister
+    uint16_t addr;       // AddrRegister
+    int      op_mode;    // OpMode
+    int      io_mode;    // IOMode
+    int      so_enable;  // SO_Enable
+    //
+    // Pins
+    int      csn;        // CS_N level
+    int      sck;        // SCK level
+    int      host_sio;   // SIO[3:0] driven by host (1 = released)
+    //
+    uint64_t clocks;     // SCK rising edges while selected
+} sEMU_SRAM;
+//
+static sEMU_SRAM emu;
+
+//------------------------------
+// Power On
+//     The memory array is loaded from the
+//     file in $BFRUN_EMU_SRAM if it exists,
+//     as if the SRAM kept its power.
+//------------------------------
+void EMU_SRAM_Power_On(void)
+{
+    const char *fname = getenv(EMU_SRAM_IMAGE_ENV);
+    FILE *fp;
+    //
+    memset(&emu, 0, sizeof(emu));
+    emu.op_mode  = EMU_SEQMODE;
+    emu.io_mode  = EMU_SPIMODE;
+    emu.csn      = 1;
+    emu.sck      = 1;
+    emu.host_sio = 0xf;
+    //
+    if ((fname != NULL) && ((fp = fopen(fname, "rb")) != NULL))
+    {
+        if (fread(emu.mem, 1, EMU_SRAM_SIZE, fp) != EMU_SRAM_SIZE) memset(emu.mem, 0, EMU_SRAM_SIZE);
+        fclose(fp);
+    }
+}
+
+//------------------------------
+// Power Off
+//     The memory array is saved to the
+//     file in $BFRUN_EMU_SRAM.
+//------------------------------
+void EMU_SRAM_Power_Off(void)
+{
+    const char *fname = getenv(EMU_SRAM_IMAGE_ENV);
+    FILE *fp;
+    //
+    if (fname == NULL) return;
+    if ((fp = fopen(fname, "wb")) == NULL)
+    {
+        fprintf(stderr, "Can't save Emulated SRAM \"%s\".\n", fname);
+        return;
+    }
+    fwrite(emu.mem, 1, EMU_SRAM_SIZE, fp);
+    fclose(fp);
+}
+
+//------------------------------
+// Memory Array and Statistics
+//------------------------------
+unsigned char *EMU_SRAM_Memory(void)
+{
+    return emu.mem;
+}
+//
+uint64_t EMU_SRAM_Clock_Count(void)
+{
+    return emu.clocks;
+}
+
+//------------------------------
+// Next Address by Operation Mode
+//------------------------------
+static uint16_t EMU_Next_Addr(uint16_t addr)
+{
+    if (emu.op_mode == EMU_PAGEMODE) return (uint16_t)((addr & 0xffe0) | ((addr + 1) & 0x001f));
+    if (emu.op_mode == EMU_SEQMODE ) return (uint16_t)(addr + 1);
+    return addr;
+}
+
+//------------------------------
+// SIO Level driven by SRAM
+//------------------------------
+static int EMU_SRAM_Drive(void)
+{
+    int hold_n = (emu.host_sio >> 3) & 0x01;
+    int oe;
+    //
+    oe = emu.so_enable && (emu.csn == 0) && (hold_n || (emu.io_mode != EMU_SPIMODE));
+    if (oe == 0) return 0xf;
+    if (emu.io_mode == EMU_SPIMODE) return 0xd | (((emu.shifter_o >> 7) & 0x01) << 1);
+    if (emu.io_mode == EMU_SDIMODE) return 0xc | ((emu.shifter_o >> 6) & 0x03);
+    return (emu.shifter_o >> 4) & 0x0f;
+}
+
+//------------------------------
+// SIO Level on the Wire
+//------------------------------
+static int EMU_SIO_Level(void)
+{
+    return emu.host_sio & EMU_SRAM_Drive();
+}
+
+//------------------------------
+// Clock Counts per I/O Mode
+//     Index is 0=SPI, 1=SDI, 2=SQI
+//------------------------------
+static const uint32_t emu_inst_cc[3] = { 7,  3, 1}; // instruction complete
+static const uint32_t emu_addh_cc[3] = {15,  7, 3}; // address high complete
+static const uint32_t emu_addl_cc[3] = {23, 11, 5}; // address low complete
+static const uint32_t emu_data_cc[3] = {31, 15, 7}; // first write data complete
+static const uint32_t emu_read_cc[3] = {24, 16, 8}; // first read data loaded
+static const uint32_t emu_byte_cc[3] = { 7,  3, 1}; // clocks per byte - 1
+static const int      emu_bits[3]    = { 1,  2, 4}; // bits per clock
+
+//------------------------------
+// SCK Rising Edge
+//------------------------------
+static void EMU_SCK_Rise(void)
+{
+    int      sio  = EMU_SIO_Level();
+    int      mode = emu.io_mode;
+    int      hold = (((sio >> 3) & 0x01) == 0) && (mode == EMU_SPIMODE);
+    uint32_t cc   = emu.counter;
+    uint8_t  inst = emu.inst;
+    uint8_t  full;
+    //
+    // Byte shifted in at this edge ({DataShifterI, SIO})
+    full = (uint8_t)((emu.shifter_i << emu_bits[mode]) | (sio & ((1 << emu_bits[mode]) - 1)));
+    //
+    // 1.07 : I/O Mode Instructions
+    if (cc == emu_inst_cc[mode])
+    {
+        if      ((mode != EMU_SDIMODE) && (full == EMU_EDIO )) emu.io_mode = EMU_SDIMODE;
+        else if ((mode != EMU_SQIMODE) && (full == EMU_EQIO )) emu.io_mode = EMU_SQIMODE;
+        else if ((mode != EMU_SPIMODE) && (full == EMU_RSTIO)) emu.io_mode = EMU_SPIMODE;
+    }
+    if (hold) return;
+    //
+    // 1.02, 1.03 : Input Data Shifter and Clock Counter
+    if (emu.csn == 0)
+    {
+        emu.shifter_i = full;
+        emu.counter   = cc + 1;
+        emu.clocks++;
+    }
+    //
+    // 1.04 : Instruction Register
+    if (cc == emu_inst_cc[mode]) emu.inst = full;
+    //
+    // 1.05 : Address Register
+    if ((inst == EMU_READ) || (inst == EMU_WRITE))
+    {
+        if      (cc == emu_addh_cc[mode]) emu.addr = (uint16_t)((emu.addr & 0x00ff) | (full << 8));
+        else if (cc == emu_addl_cc[mode]) emu.addr = (uint16_t)((emu.addr & 0xff00) | full);
+    }
+    //
+    // 1.06 : Mode Register Write (the shifter is one transfer behind)
+    if ((inst == EMU_WRMR) && (cc == emu_addh_cc[mode]))
+    {
+        emu.op_mode = (emu.shifter_i >> (6 - emu_bits[mode])) & 0x03;
+    }
+    //
+    // 1.08 : Array Write
+    if ((inst == EMU_WRITE) && (cc >= emu_data_cc[mode]) && ((cc & emu_byte_cc[mode]) == emu_byte_cc[mode]))
+    {
+        emu.mem[emu.addr] = full;
+        emu.addr = EMU_Next_Addr(emu.addr);
+    }
+}
+
+//------------------------------
+// SCK Falling Edge
+//------------------------------
+static void EMU_SCK_Fall(void)
+{
+    int      mode = emu.io_mode;
+    int      hold = (((EMU_SIO_Level() >> 3) & 0x01) == 0) && (mode == EMU_SPIMODE);
+    uint32_t cc   = emu.counter;
+    int      load;
+    //
+    if (hold) return;
+    //
+    // 1.09 : Output Data Shifter
+    if (emu.inst == EMU_READ)
+    {
+        load = (cc >= emu_read_cc[mode]) && ((cc & emu_byte_cc[mode]) == 0);
+        if (load)
+        {
+            emu.shifter_o = emu.mem[emu.addr];
+            emu.so_enable = 1;
+            emu.addr = EMU_Next_Addr(emu.addr);
+        }
+        else emu.shifter_o = (uint8_t)(emu.shifter_o << emu_bits[mode]);
+    }
+    else if (emu.inst == EMU_RDMR)
+    {
+        load = (cc > emu_inst_cc[mode]) && ((cc & emu_byte_cc[mode]) == 0);
+        if (load)
+        {
+            emu.shifter_o = (uint8_t)(emu.op_mode << 6);
+            emu.so_enable = 1;
+        }
+        else emu.shifter_o = (uint8_t)(emu.shifter_o << emu_bits[mode]);
+    }
+}
+
+//==============================
+// GPIO Backend
+//==============================
+
+//------------------------------
+// Clock, Chip and Reset
+//     No PWM clock nor bfCPU is
+//     attached to the emulator.
+//     The PWM is driven only on a
+//     fake sysfs tree, for test.
+//------------------------------
+static int  Emu_SysClk_Output(int start)
+{
+    return (getenv(PWM_SYSFS_ENV))? Raspi_SysClk_Output(start) : EXIT_SUCCESS;
+}
+//
+static void Emu_CHIP_Open(void)          {EMU_SRAM_Power_On();}
+static void Emu_CHIP_Close(void)         {EMU_SRAM_Power_Off();}
+static void Emu_RESN_Init(void)          {}
+static void Emu_RESN_CleanUp(void)       {}
+static void Emu_RESN_Set_Value(int value) {(void)value;}
+
+//------------------------------
+// Pin Values
+//------------------------------
+static void Emu_CSN_Set_Value(int value)
+{
+    value = value & 0x01;
+    if ((emu.csn == 1) && (value == 0))
+    {
+        // Internal Reset Logic
+        emu.counter   = 0;
+        emu.so_enable = 0;
+    }
+    emu.csn = value;
+}
+//
+static void Emu_SCK_Set_Value(int value)
+{
+    value = value & 0x01;
+    if (value == emu.sck) return;
+    emu.sck = value;
+    if (value) EMU_SCK_Rise();
+    else       EMU_SCK_Fall();
+}
+//
+static void Emu_SIO_Set_Value(int value)
+{
+    emu.host_sio = value & 0x0f;
+}
+//
+static void Emu_SIO_Get_Value(int *value)
+{
+    *value = EMU_SIO_Level();
+}
+//
+static void Emu_SI_Set_Value(int value)
+{
+    emu.host_sio = (emu.host_sio & 0x0e) | (value & 0x01);
+}
+//
+static void Emu_SI_Get_Value(int *value)
+{
+    *value = EMU_SIO_Level() & 0x01;
+}
+//
+static void Emu_BUS_Set_Value(int csn, int sck, int sio)
+{
+    Emu_CSN_Set_Value(csn);
+    Emu_SIO_Set_Value(sio);
+    Emu_SCK_Set_Value(sck);
+}
+
+//------------------------------
+// Line Requests
+//     Released lines are pulled up.
+//------------------------------
+static void Emu_Release(void)
+{
+    Emu_SIO_Set_Value(0xf);
+    Emu_CSN_Set_Value(1);
+    Emu_SCK_Set_Value(1);
+}
+static void Emu_QSPI_Init(void)    {}
+static void Emu_QSPI_CleanUp(void) {Emu_Release();}
+static void Emu_SPI_Init(void)     {}
+static void Emu_SPI_CleanUp(void)  {Emu_Release();}
+static void Emu_Set_Direction(int direction) {(void)direction;}
+
+//-----------------------------
+// Emulator Backend
+//-----------------------------
+const sGPIO_BACKEND GPIO_Backend_Emu =
+{
+    "emu",
+    0,
+    Emu_SysClk_Output,
+    Emu_CHIP_Open,
+    Emu_CHIP_Close,
+    Emu_RESN_Init,
+    Emu_RESN_CleanUp,
+    Emu_QSPI_Init,
+    Emu_QSPI_CleanUp,
+    Emu_SPI_Init,
+    Emu_SPI_CleanUp,
+    Emu_Set_Direction,
+    Emu_Set_Direction,
+    Emu_Set_Direction,
+    Emu_Set_Direction,
+    Emu_RESN_Set_Value,
+    Emu_CSN_Set_Value,
+    Emu_SCK_Set_Value,
+    Emu_SIO_Set_Value,
+    Emu_SIO_Get_Value,
+    Emu_SI_Set_Value,
+    Emu_SI_Get_Value,
+    Emu_BUS_Set_Value
+};
+
+//===========================================================
+// End of File
+//===========================================================
@@ -0,0 +1,37 @@
+//===========================================================
+// bfCPU Running Tool
+//-----------------------------------------------------------
+// File Name   : emusram.h
+// Description : 23LC512 Serial SRAM Emulator Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+
+#ifndef __EMUSRAM_H__
+#define __EMUSRAM_H__
+
+//-----------------------------------
+// 23LC512 Parameters
+//-----------------------------------
+#define EMU_SRAM_SIZE 65536
+//
+// Memory Array kept in this File between Runs
+#define EMU_SRAM_IMAGE_ENV "BFRUN_EMU_SRAM"
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+void EMU_SRAM_Power_On(void);
+void EMU_SRAM_Power_Off(void);
+unsigned char *EMU_SRAM_Memory(void);
+uint64_t EMU_SRAM_Clock_Count(void);
+
+#endif
+//===========================================================
+// End of File
+//===========================================================
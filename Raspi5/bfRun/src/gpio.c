@@ -0,0 +1,111 @@
+//===========================================================
+// bfCPU Running Tool
+//-----------------------------------------------------------
+// File Name   : gpio.c
+// Description : GPIO Backend Dispatcher
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "gpio.h"
+#include "raspi.h"
+
+//-------------------------
+// Backend Table
+//-------------------------
+static const sGPIO_BACKEND *gpio_backends[] =
+{
+#ifndef NO_GPIOD
+    &GPIO_Backend_Gpiod,
+#endif
+    &GPIO_Backend_Emu,
+    &GPIO_Backend_Rp1,
+    &GPIO_Backend_Rp1Emu,
+    NULL
+};
+//
+// Selected Backend (the first one is default)
+static const sGPIO_BACKEND *psGPIO = NULL;
+//
+// Number of Pin Value Operations
+//     (one ioctl each on libgpiod)
+static uint64_t gpio_ops = 0;
+
+//------------------------------
+// Select Backend by Name
+//     Returns 0 if found.
+//------------------------------
+int GPIO_Select_Backend(const char *name)
+{
+    int i;
+    //
+    for (i = 0; gpio_backends[i] != NULL; i++)
+    {
+        if (strcmp(gpio_backends[i]->name, name) == 0)
+        {
+            psGPIO = gpio_backends[i];
+            return 0;
+        }
+    }
+    return 1;
+}
+
+//------------------------------
+// Current Backend
+//------------------------------
+static const sGPIO_BACKEND *GPIO_Backend(void)
+{
+    if (psGPIO == NULL) psGPIO = gpio_backends[0];
+    return psGPIO;
+}
+//
+const char *GPIO_Backend_Name(void)
+{
+    return GPIO_Backend()->name;
+}
+//
+uint64_t GPIO_Op_Count(void)
+{
+    return gpio_ops;
+}
+//
+int GPIO_Backend_Hardware(void)
+{
+    return GPIO_Backend()->hardware;
+}
+
+//------------------------------
+// Dispatchers (raspi.h API)
+//------------------------------
+int  SysClk_Output(int start)                {return GPIO_Backend()->sysclk_output(start);}
+void CHIP_Open(void)                         {GPIO_Backend()->chip_open();}
+void CHIP_Close(void)                        {GPIO_Backend()->chip_close();}
+void RESN_Init(void)                         {GPIO_Backend()->resn_init();}
+void RESN_CleanUp(void)                      {GPIO_Backend()->resn_cleanup();}
+void QSPI_Init(void)                         {GPIO_Backend()->qspi_init();}
+void QSPI_CleanUp(void)                      {GPIO_Backend()->qspi_cleanup();}
+void SPI_Init(void)                          {GPIO_Backend()->spi_init();}
+void SPI_CleanUp(void)                       {GPIO_Backend()->spi_cleanup();}
+void GPIO_CS_N_Set_Direction(int direction)  {GPIO_Backend()->csn_set_direction(direction);}
+void GPIO_SCK_Set_Direction(int direction)   {GPIO_Backend()->sck_set_direction(direction);}
+void GPIO_SIO_Set_Direction(int direction)   {GPIO_Backend()->sio_set_direction(direction);}
+void GPIO_SI_Set_Direction(int direction)    {GPIO_Backend()->si_set_direction(direction);}
+void GPIO_RESN_Set_Value(int value)          {gpio_ops++; GPIO_Backend()->resn_set_value(value);}
+void GPIO_CSN_Set_Value(int value)           {gpio_ops++; GPIO_Backend()->csn_set_value(value);}
+void GPIO_SCK_Set_Value(int value)           {gpio_ops++; GPIO_Backend()->sck_set_value(value);}
+void GPIO_SIO_Set_Value(int value)           {gpio_ops++; GPIO_Backend()->sio_set_value(value);}
+void GPIO_SIO_Get_Value(int *value)          {gpio_ops++; GPIO_Backend()->sio_get_value(value);}
+void GPIO_SI_Set_Value(int value)            {gpio_ops++; GPIO_Backend()->si_set_value(value);}
+void GPIO_SI_Get_Value(int *value)           {gpio_ops++; GPIO_Backend()->si_get_value(value);}
+void GPIO_BUS_Set_Value(int csn, int sck, int sio)
+                                             {gpio_ops++; GPIO_Backend()->bus_set_value(csn, sck, sio);}
+
+//===========================================================
+// End of File
+//===========================================================
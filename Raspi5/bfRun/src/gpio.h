@@ -0,0 +1,73 @@
+//===========================================================
+// bfCPU Running Tool
+//-----------------------------------------------------------
+// File Name   : gpio.h
+// Description : GPIO Backend Interface Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+
+#ifndef __GPIO_H__
+#define __GPIO_H__
+
+//-----------------------------------
+// GPIO Backend
+//     Every pin operation in raspi.h
+//     is dispatched to the selected
+//     backend through this table.
+//-----------------------------------
+typedef struct
+{
+    const char *name;
+    int  hardware; // 1 if a bfCPU board is attached
+    int  (*sysclk_output)(int start);
+    void (*chip_open)(void);
+    void (*chip_close)(void);
+    void (*resn_init)(void);
+    void (*resn_cleanup)(void);
+    void (*qspi_init)(void);
+    void (*qspi_cleanup)(void);
+    void (*spi_init)(void);
+    void (*spi_cleanup)(void);
+    void (*csn_set_direction)(int direction);
+    void (*sck_set_direction)(int direction);
+    void (*sio_set_direction)(int direction);
+    void (*si_set_direction)(int direction);
+    void (*resn_set_value)(int value);
+    void (*csn_set_value)(int value);
+    void (*sck_set_value)(int value);
+    void (*sio_set_value)(int value);
+    void (*sio_get_value)(int *value);
+    void (*si_set_value)(int value);
+    void (*si_get_value)(int *value);
+    void (*bus_set_value)(int csn, int sck, int sio);
+} sGPIO_BACKEND;
+
+//-----------------------------------
+// Available Backends
+//-----------------------------------
+#ifndef NO_GPIOD
+extern const sGPIO_BACKEND GPIO_Backend_Gpiod;  // raspi.c
+#endif
+extern const sGPIO_BACKEND GPIO_Backend_Emu;    // emusram.c
+extern const sGPIO_BACKEND GPIO_Backend_Rp1;    // rp1gpio.c
+extern const sGPIO_BACKEND GPIO_Backend_Rp1Emu; // rp1gpio.c
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+int  GPIO_Select_Backend(const char *name);
+const char *GPIO_Backend_Name(void);
+int  GPIO_Backend_Hardware(void);
+uint64_t GPIO_Op_Count(void);
+int  Raspi_SysClk_Output(int start); // pwmclk.c
+
+#endif
+//===========================================================
+// End of File
+//===========================================================
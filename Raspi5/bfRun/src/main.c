@@ -23,7 +23,11 @@
 #include <string.h>
 #include <sys/types.h>
 //
+#include "console.h"
 #include "defines.h"
+#include "delta.h"
+#include "gpio.h"
+#include "pwmclk.h"
 #include "raspi.h"
 #include "sram.h"
 #include "utility.h"
@@ -32,7 +36,17 @@
 // Globals
 //=====================
 int CLKFREQ = CLKFREQ_DEFAULT;
+int VERIFY_LEVEL = SRAM_VERIFY_FULL;
+int BAUD_RATE = UART_BAUD;
+sBAUD BAUD; // UART Divider Setting for BAUD_RATE at CLKFREQ
+//
+// Verify Level Names (order of enum SRAM_VERIFY)
+static const char *verify_level_names[] = {"full", "sample", "none"};
 extern int ctrl_c;
+//
+// Test Mode (NULL if not)
+static sCONSOLE_TEST  test_mode;
+static sCONSOLE_TEST *psTEST = NULL;
 
 //=============================================================
 //-------------------------------------------------------------
@@ -48,11 +62,49 @@ void Print_Usage(void)
     printf("---------------------------------------------------------------\n");
     printf("bfCPU Running Tool Rev.%02d\n", REVISION);
     printf("---------------------------------------------------------------\n");
-    printf("$ bfRun [options] InputHexFile.hex                             \n");
+    printf("$ bfRun [options] InputFile.hex (or InputFile.bin)             \n");
     printf("    --clk freq, -c freq : Clock Frequency in Hz (Default 10MHz)\n");
+    printf("    --gpio name, -g name: GPIO Backend (Default %-5s)         \n", GPIO_Backend_Name());
+    printf("                          gpiod : libgpiod, bfCPU Board        \n");
+    printf("                          emu   : 23LC512 Emulator, no Board   \n");
+    printf("                          rp1   : RP1 Registers, bfCPU Board   \n");
+    printf("                          rp1emu: RP1 Fake Registers, Emulator \n");
+    printf("    --delta, -d         : Write only Pages changed since the   \n");
+    printf("                          last Run (Image Cache in ~/.cache)   \n");
+    printf("    --verify lvl, -v lvl: Read Back Verify Level (Default full)\n");
+    printf("                          full, sample (Some Pages), none      \n");
+    printf("    --preload f, -p f   : Raw Data File to be preloaded in RAM \n");
+    printf("    --dump f, -u f      : Dump RAM to a File after the Run     \n");
+    printf("    --tty dev, -s dev   : Bridge UART tty to the Console       \n");
+    printf("                          (e.g. /dev/ttyAMA0)                  \n");
+    printf("    --log f, -l f       : Log UART Byte Timing to a File       \n");
+    printf("    --period ns, -e ns  : PWM Clock Period (Default 100ns),    \n");
+    printf("                          also Clock Frequency if no --clk     \n");
+    printf("    --duty ns, -y ns    : PWM Clock High Time (Default 1/2)    \n");
+    printf("    --baud rate, -b rate: UART Baud Rate (Default %6d), or max \n", UART_BAUD);
+    printf("                          max : Highest within %.0f%% Error      \n", BAUD_ERROR_MAX);
+    printf("Test Mode (needs --tty):                                       \n");
+    printf("    --input f, -i f     : Send a File to UART instead of stdin \n");
+    printf("    --expect f, -x f    : Compare UART Output with a File      \n");
+    printf("    --bytes n, -n n     : Stop after n Bytes received          \n");
+    printf("                          (Default Size of --expect File)      \n");
+    printf("    --term c, -z c      : Stop at Byte c received (e.g. 0x0a)  \n");
+    printf("    --timeout s, -w s   : Stop after s Seconds (Default %2d)    \n", CONSOLE_TEST_TIMEOUT);
     printf("---------------------------------------------------------------\n");
 }
 
+//=====================
+// Print Throughput
+//=====================
+void Print_Throughput(const char *result, int bytes, double seconds, uint64_t ops)
+{
+    if (seconds > 0.0)
+        printf("%s (%dbytes, %.1fKB/s, %llu GPIO ops).\n",
+            result, bytes, (double)bytes / seconds / 1024.0, (unsigned long long)ops);
+    else
+        printf("%s (%dbytes, %llu GPIO ops).\n", result, bytes, (unsigned long long)ops);
+}
+
 //=====================
 // Parse Command Line
 //=====================
@@ -64,21 +116,67 @@ uint32_t Parse_Command_Line(int argc, char **argv, sOPTION *psOPTION)
     //
     char *endptr;
     long long_num;
+    int period = PWM_PERIOD_DEFAULT;
+    int duty   = -1;
     //
     // Define Long Option
     static struct option long_option[] =
     {
-        {"clk", required_argument, NULL, 'c'},
-        {NULL , no_argument      , NULL, 0  }
+        {"clk"   , required_argument, NULL, 'c'},
+        {"gpio"  , required_argument, NULL, 'g'},
+        {"delta" , no_argument      , NULL, 'd'},
+        {"verify", required_argument, NULL, 'v'},
+        {"preload",required_argument, NULL, 'p'},
+        {"dump"  , required_argument, NULL, 'u'},
+        {"tty"   , required_argument, NULL, 's'},
+        {"log"   , required_argument, NULL, 'l'},
+        {"period", required_argument, NULL, 'e'},
+        {"duty"  , required_argument, NULL, 'y'},
+        {"baud"  , required_argument, NULL, 'b'},
+        {"input" , required_argument, NULL, 'i'},
+        {"expect", required_argument, NULL, 'x'},
+        {"bytes" , required_argument, NULL, 'n'},
+        {"term"  , required_argument, NULL, 'z'},
+        {"timeout",required_argument, NULL, 'w'},
+        {NULL    , no_argument      , NULL, 0  }
     };
     //
     // Initialize
     psOPTION->opt_clk = OPT_NO;
     psOPTION->opt_clk_freq = NULL;
+    psOPTION->opt_gpio = OPT_NO;
+    psOPTION->opt_gpio_name = NULL;
+    psOPTION->opt_delta = OPT_NO;
+    psOPTION->opt_verify = OPT_NO;
+    psOPTION->opt_verify_level = NULL;
+    psOPTION->opt_pre = OPT_NO;
+    psOPTION->opt_pre_name = NULL;
+    psOPTION->opt_dump = OPT_NO;
+    psOPTION->opt_dump_name = NULL;
+    psOPTION->opt_tty = OPT_NO;
+    psOPTION->opt_tty_name = NULL;
+    psOPTION->opt_log = OPT_NO;
+    psOPTION->opt_log_name = NULL;
+    psOPTION->opt_period = OPT_NO;
+    psOPTION->opt_period_ns = NULL;
+    psOPTION->opt_duty = OPT_NO;
+    psOPTION->opt_duty_ns = NULL;
+    psOPTION->opt_baud = OPT_NO;
+    psOPTION->opt_baud_rate = NULL;
+    psOPTION->opt_input = OPT_NO;
+    psOPTION->opt_input_name = NULL;
+    psOPTION->opt_expect = OPT_NO;
+    psOPTION->opt_expect_name = NULL;
+    psOPTION->opt_bytes = OPT_NO;
+    psOPTION->opt_bytes_num = NULL;
+    psOPTION->opt_term = OPT_NO;
+    psOPTION->opt_term_byte = NULL;
+    psOPTION->opt_timeout = OPT_NO;
+    psOPTION->opt_timeout_sec = NULL;
     psOPTION->input_file_name = NULL;
     //
     // Parse Option Line
-    while ((c = getopt_long(argc, argv, "c:", long_option, &long_option_index)) != -1)
+    while ((c = getopt_long(argc, argv, "c:g:dv:p:u:s:l:e:y:b:i:x:n:z:w:", long_option, &long_option_index)) != -1)
     {
         switch(c)
         {
@@ -88,6 +186,95 @@ uint32_t Parse_Command_Line(int argc, char **argv, sOPTION *psOPTION)
                 psOPTION->opt_clk_freq = optarg;
                 break;
             }
+            case 'g' :
+            {
+                psOPTION->opt_gpio = OPT_YES;
+                psOPTION->opt_gpio_name = optarg;
+                break;
+            }
+            case 'd' :
+            {
+                psOPTION->opt_delta = OPT_YES;
+                break;
+            }
+            case 'v' :
+            {
+                psOPTION->opt_verify = OPT_YES;
+                psOPTION->opt_verify_level = optarg;
+                break;
+            }
+            case 'p' :
+            {
+                psOPTION->opt_pre = OPT_YES;
+                psOPTION->opt_pre_name = optarg;
+                break;
+            }
+            case 'u' :
+            {
+                psOPTION->opt_dump = OPT_YES;
+                psOPTION->opt_dump_name = optarg;
+                break;
+            }
+            case 's' :
+            {
+                psOPTION->opt_tty = OPT_YES;
+                psOPTION->opt_tty_name = optarg;
+                break;
+            }
+            case 'l' :
+            {
+                psOPTION->opt_log = OPT_YES;
+                psOPTION->opt_log_name = optarg;
+                break;
+            }
+            case 'e' :
+            {
+                psOPTION->opt_period = OPT_YES;
+                psOPTION->opt_period_ns = optarg;
+                break;
+            }
+            case 'y' :
+            {
+                psOPTION->opt_duty = OPT_YES;
+                psOPTION->opt_duty_ns = optarg;
+                break;
+            }
+            case 'b' :
+            {
+                psOPTION->opt_baud = OPT_YES;
+                psOPTION->opt_baud_rate = optarg;
+                break;
+            }
+            case 'i' :
+            {
+                psOPTION->opt_input = OPT_YES;
+                psOPTION->opt_input_name = optarg;
+                break;
+            }
+            case 'x' :
+            {
+                psOPTION->opt_expect = OPT_YES;
+                psOPTION->opt_expect_name = optarg;
+                break;
+            }
+            case 'n' :
+            {
+                psOPTION->opt_bytes = OPT_YES;
+                psOPTION->opt_bytes_num = optarg;
+                break;
+            }
+            case 'z' :
+            {
+                psOPTION->opt_term = OPT_YES;
+                psOPTION->opt_term_byte = optarg;
+                break;
+            }
+            case 'w' :
+            {
+                psOPTION->opt_timeout = OPT_YES;
+                psOPTION->opt_timeout_sec = optarg;
+                break;
+            }
             default  :
             {
                 fprintf(stderr, "Undefined Option \"%c\", ignored.\n", c);
@@ -127,7 +314,149 @@ uint32_t Parse_Command_Line(int argc, char **argv, sOPTION *psOPTION)
         CLKFREQ = CLKFREQ_DEFAULT;
     }
     //
+    // Decode PWM Clock Period and Duty Cycle
+    if (psOPTION->opt_period)
+    {
+        long_num = strtol(psOPTION->opt_period_ns, &endptr, 10);
+        if ((errno == ERANGE) || (*endptr != '\0') || (long_num <= 0) || (long_num > INT_MAX))
+        {
+            fprintf(stderr, "PWM Clock Period is Illegal.\n");
+            error = 1;
+        }
+        period = (int)long_num;
+        if (psOPTION->opt_clk == OPT_NO) CLKFREQ = (int)((1000000000L + period / 2) / period);
+    }
+    if (psOPTION->opt_duty)
+    {
+        long_num = strtol(psOPTION->opt_duty_ns, &endptr, 10);
+        if ((errno == ERANGE) || (*endptr != '\0') || (long_num <= 0) || (long_num >= period))
+        {
+            fprintf(stderr, "PWM Clock High Time is Illegal.\n");
+            error = 1;
+        }
+        duty = (int)long_num;
+    }
+    PWM_Clock_Config(period, duty);
+    //
+    // Decode Baud Rate and Search UART Divider
+    if ((psOPTION->opt_baud) && (strcmp(psOPTION->opt_baud_rate, "max") == 0))
+    {
+        BAUD_RATE = BAUD_Highest((double)CLKFREQ, &BAUD);
+        if (BAUD_RATE == 0)
+        {
+            fprintf(stderr, "No Standard Baud Rate is available at %dHz.\n", CLKFREQ);
+            error = 1;
+        }
+    }
+    else
+    {
+        if (psOPTION->opt_baud)
+        {
+            long_num = strtol(psOPTION->opt_baud_rate, &endptr, 10);
+            if ((errno == ERANGE) || (*endptr != '\0') || (long_num <= 0) || (long_num > INT_MAX))
+            {
+                fprintf(stderr, "Baud Rate is Illegal.\n");
+                error = 1;
+                long_num = UART_BAUD;
+            }
+            BAUD_RATE = (int)long_num;
+        }
+        if (BAUD_Search((double)CLKFREQ, (double)BAUD_RATE, &BAUD))
+        {
+            fprintf(stderr, "Baud Rate %d is not available at %dHz (Error %+.2f%%).\n",
+                BAUD_RATE, CLKFREQ, BAUD.error);
+            error = 1;
+        }
+    }
+    //
+    // Decode Test Mode
+    if (psOPTION->opt_input || psOPTION->opt_expect || psOPTION->opt_bytes
+     || psOPTION->opt_term  || psOPTION->opt_timeout)
+    {
+        psTEST = &test_mode;
+        psTEST->input   = psOPTION->opt_input_name;
+        psTEST->expect  = psOPTION->opt_expect_name;
+        psTEST->bytes   = -1;
+        psTEST->term    = -1;
+        psTEST->timeout = CONSOLE_TEST_TIMEOUT;
+        if (psOPTION->opt_tty == OPT_NO)
+        {
+            fprintf(stderr, "Test Mode needs --tty.\n");
+            error = 1;
+        }
+        if (psOPTION->opt_bytes)
+        {
+            long_num = strtol(psOPTION->opt_bytes_num, &endptr, 0);
+            if ((errno == ERANGE) || (*endptr != '\0') || (long_num <= 0))
+            {
+                fprintf(stderr, "Byte Count is Illegal.\n");
+                error = 1;
+            }
+            psTEST->bytes = long_num;
+        }
+        if (psOPTION->opt_term)
+        {
+            long_num = strtol(psOPTION->opt_term_byte, &endptr, 0);
+            if ((errno == ERANGE) || (*endptr != '\0') || (long_num < 0) || (long_num > 255))
+            {
+                fprintf(stderr, "Terminator Byte is Illegal.\n");
+                error = 1;
+            }
+            psTEST->term = (int)long_num;
+        }
+        if (psOPTION->opt_timeout)
+        {
+            psTEST->timeout = strtod(psOPTION->opt_timeout_sec, &endptr);
+            if ((*endptr != '\0') || (psTEST->timeout < 0.0))
+            {
+                fprintf(stderr, "Timeout is Illegal.\n");
+                error = 1;
+            }
+        }
+    }
+    //
+    //
+    // Select GPIO Backend
+    if (psOPTION->opt_gpio)
+    {
+        if (GPIO_Select_Backend(psOPTION->opt_gpio_name))
+        {
+            fprintf(stderr, "GPIO Backend \"%s\" is not Available.\n", psOPTION->opt_gpio_name);
+            error = 1;
+        }
+    }
+    //
+    // Decode Verify Level
+    if (psOPTION->opt_verify)
+    {
+        for (VERIFY_LEVEL = SRAM_VERIFY_NONE; VERIFY_LEVEL >= 0; VERIFY_LEVEL--)
+        {
+            if (strcmp(psOPTION->opt_verify_level, verify_level_names[VERIFY_LEVEL]) == 0) break;
+        }
+        if (VERIFY_LEVEL < 0)
+        {
+            fprintf(stderr, "Verify Level \"%s\" is Illegal.\n", psOPTION->opt_verify_level);
+            VERIFY_LEVEL = SRAM_VERIFY_FULL;
+            error = 1;
+        }
+    }
+    //
     DEBUG_printf(DEBUG_MAX, "psOPTION->opt_clk = %d, freq = %d\n", psOPTION->opt_clk, CLKFREQ);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_gpio = %d, name = %s\n", psOPTION->opt_gpio, GPIO_Backend_Name());
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_delta = %d\n", psOPTION->opt_delta);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_verify = %d, level = %s\n", psOPTION->opt_verify, verify_level_names[VERIFY_LEVEL]);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_pre = %d, name = %s\n", psOPTION->opt_pre, psOPTION->opt_pre_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_dump = %d, name = %s\n", psOPTION->opt_dump, psOPTION->opt_dump_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_tty = %d, name = %s\n", psOPTION->opt_tty, psOPTION->opt_tty_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_log = %d, name = %s\n", psOPTION->opt_log, psOPTION->opt_log_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_period = %d, ns = %d\n", psOPTION->opt_period, period);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_duty = %d, ns = %d\n", psOPTION->opt_duty, duty);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_baud = %d, rate = %d\n", psOPTION->opt_baud, BAUD_RATE);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_input = %d, name = %s\n", psOPTION->opt_input, psOPTION->opt_input_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_expect = %d, name = %s\n", psOPTION->opt_expect, psOPTION->opt_expect_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_bytes = %d, num = %s\n", psOPTION->opt_bytes, psOPTION->opt_bytes_num);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_term = %d, byte = %s\n", psOPTION->opt_term, psOPTION->opt_term_byte);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_timeout = %d, sec = %s\n", psOPTION->opt_timeout, psOPTION->opt_timeout_sec);
     DEBUG_printf(DEBUG_MAX, "psOPTION->input_file_name = %s\n", psOPTION->input_file_name);
     //
     return error;
@@ -139,11 +468,15 @@ uint32_t Parse_Command_Line(int argc, char **argv, sOPTION *psOPTION)
 int main (int argc, char **argv)
 {
     sOPTION option;
-    char *obj_str;
-    unsigned char *rom_src; // 8bit width
-    unsigned char *rom_dst; // 8bit width
+    unsigned char *rom_src; // 8bit width, SRAM Image (ROM and RAM)
+    unsigned char *rom_dst; // 8bit width, SRAM Image (ROM and RAM)
     int addr_max;
+    int ram_max;
+    int bytes;
+    int bad_addr;
     int error = 0;
+    double time_start;
+    uint64_t ops_start;
     //
     // Configure Interrupt (Ctrl-C)
     signal(SIGINT, Interrupt_Handler);
@@ -156,22 +489,18 @@ int main (int argc, char **argv)
     }
     //
     // Allocate ROM
-    rom_src = (unsigned char*)malloc(sizeof(unsigned char) * MAXROM);
-    rom_dst = (unsigned char*)malloc(sizeof(unsigned char) * MAXROM);
+    rom_src = (unsigned char*)malloc(sizeof(unsigned char) * SRAM_SIZE);
+    rom_dst = (unsigned char*)malloc(sizeof(unsigned char) * SRAM_SIZE);
     if ((rom_src == NULL) || (rom_dst == NULL))
     {
         fprintf(stderr, "======== ERROR: Can't allocate ROM area.\n");
         exit(EXIT_FAILURE);
     }
     //
-    // Get Hex File as String
-    printf("Read Hex File...");
-    obj_str = Get_InputFile_as_String(&option);
-    printf("Done.\n");
-    //
-    // Decode Hex Format
-    printf("Decode Hex Format...");
-    addr_max = Read_Hex_File(rom_src, obj_str);
+    // Read Object File (Binary or Hex)
+    printf("Read Object File...");
+    addr_max = Read_Object_File(rom_src, rom_src + SRAM_DATA_BASE, &ram_max, option.input_file_name);
+    if (option.opt_pre) ram_max = Read_Preload_File(rom_src + SRAM_DATA_BASE, option.opt_pre_name);
     printf("Done.\n");
     for (int addr = 0; addr < 16; addr++) DEBUG_printf(DEBUG_MAX, "0x%02x 0x%02x\n", addr, rom_src[addr]);
     //
@@ -184,8 +513,15 @@ int main (int argc, char **argv)
     //
     // Start Clock
     printf("Start System Clock...");
-    SysClk_Output(1);
-    printf("Done.\n");
+    if (SysClk_Output(1))
+    {
+        printf("NG.\n");
+        error = 1;
+    }
+    else
+    {
+        printf("Done.\n");
+    }
     //
     // Configure SRAM as QSPI
     printf("Set Serial SRAM in QSPI Mode...");
@@ -199,31 +535,75 @@ int main (int argc, char **argv)
     printf("Done.\n");
     //
     // SRAM Write
-    printf("Write Hex Data to SRAM...");
-    SRAM_Write_Burst(rom_src, addr_max);
-    printf("Done.\n");
-    //
-    // SRAM Read
-    printf("Read Hex Data from SRAM...");
-    SRAM_Read_Burst(rom_dst, addr_max);
-    for (int addr = 0; addr < 16; addr++) DEBUG_printf(DEBUG_MAX, "0x%02x 0x%02x\n", addr, rom_dst[addr]);
-    printf("Done.\n");
+    printf((option.opt_delta)? "Write Hex Data to SRAM " : "Write Hex Data to SRAM...");
+    time_start = Get_Time();
+    ops_start  = GPIO_Op_Count();
+    if (option.opt_delta)
+    {
+        bytes = Delta_Write(rom_src, addr_max, CLKFREQ);
+    }
+    else
+    {
+        SRAM_Write_Burst(rom_src, addr_max);
+        bytes = addr_max + 1;
+    }
+    Print_Throughput("Done", bytes, Get_Time() - time_start, GPIO_Op_Count() - ops_start);
     //
-    // SRAM Data Verify
-    printf("Verify Hex Data in SRAM...");
-    if (SRAM_Verify(rom_src, rom_dst, addr_max))
+    // SRAM Read and Verify
+    printf("Verify Hex Data in SRAM (%s)...", verify_level_names[VERIFY_LEVEL]);
+    time_start = Get_Time();
+    ops_start  = GPIO_Op_Count();
+    bad_addr = SRAM_Verify(rom_src, rom_dst, addr_max, VERIFY_LEVEL,
+        (option.opt_delta)? Delta_Pages() : NULL, &bytes);
+    if (bad_addr >= 0)
     {
-        printf("NG.\n");
+        printf("NG at 0x%04x (Wrote 0x%02x, Read 0x%02x).\n",
+            bad_addr, rom_src[bad_addr], rom_dst[bad_addr]);
+        Delta_Remove(CLKFREQ);
         error = 1;
     }
     else
     {
-        printf("OK.\n");
+        if (VERIFY_LEVEL == SRAM_VERIFY_NONE)
+            printf("Skipped.\n");
+        else
+            Print_Throughput("OK", bytes, Get_Time() - time_start, GPIO_Op_Count() - ops_start);
+        Delta_Save(rom_src, addr_max, CLKFREQ, option.opt_delta);
+    }
+    //
+    // Data Preload
+    if (ram_max >= 0)
+    {
+        printf("Write Data Preload to SRAM...");
+        time_start = Get_Time();
+        ops_start  = GPIO_Op_Count();
+        SRAM_Write_Range(rom_src, SRAM_DATA_BASE, SRAM_DATA_BASE + ram_max);
+        Print_Throughput("Done", ram_max + 1, Get_Time() - time_start, GPIO_Op_Count() - ops_start);
+        //
+        printf("Verify Data Preload in SRAM...");
+        time_start = Get_Time();
+        ops_start  = GPIO_Op_Count();
+        if (VERIFY_LEVEL == SRAM_VERIFY_NONE)
+        {
+            printf("Skipped.\n");
+        }
+        else if ((bad_addr = SRAM_Read_Range(rom_dst, SRAM_DATA_BASE, SRAM_DATA_BASE + ram_max, rom_src)) >= 0)
+        {
+            printf("NG at 0x%04x (Wrote 0x%02x, Read 0x%02x).\n",
+                bad_addr, rom_src[bad_addr], rom_dst[bad_addr]);
+            error = 1;
+        }
+        else
+        {
+            Print_Throughput("OK", ram_max + 1, Get_Time() - time_start, GPIO_Op_Count() - ops_start);
+        }
     }
     //
     // Set Baud Rate data
     printf("Set Baud Rate Data in SRAM ");
-    if (SRAM_Set_BaudRate_Data(CLKFREQ))
+    printf("(Freq=%d Baud=%d div0=%d div1=%d Error=%+.2f%%)...",
+        CLKFREQ, BAUD_RATE, BAUD.div0, BAUD.div1, BAUD.error);
+    if (SRAM_Set_BaudRate_Data(&BAUD))
     {
         printf("NG.\n");
         error = 1;
@@ -238,19 +618,48 @@ int main (int argc, char **argv)
     {
         printf("Can not start the bfCPU System due to the error.\n");
     }
+    else if ((GPIO_Backend_Hardware() == 0) && (option.opt_tty == OPT_NO))
+    {
+        printf("No bfCPU System on GPIO Backend \"%s\".\n", GPIO_Backend_Name());
+    }
+    else if (Console_Open(option.opt_tty_name, BAUD_RATE, option.opt_log_name))
+    {
+        printf("Can not open the UART Console.\n");
+        error = 1;
+    }
     else
     {
-        printf("Start the bfCPU System (Ctrl-C to Quit).\n");
+        if (option.opt_tty) printf("UART Console on %s (%dbps).\n", option.opt_tty_name, BAUD_RATE);
+        printf((psTEST)? "Start the bfCPU System in Test Mode.\n" : "Start the bfCPU System (Ctrl-C to Quit).\n");
         //
         // Negate RES_N
         GPIO_RESN_Set_Value(1);
-        while(1)
-        {
-            if (ctrl_c) break;
-        }
+        //
+        // Sleep until Ctrl-C, bridging the UART if opened
+        if (Console_Run(psTEST)) error = 1;
+        Console_Close();
+        //
         // Assert RES_N
         GPIO_RESN_Set_Value(0);
     }
+    //
+    // Dump RAM (the bfCPU is in reset, the QSPI bus is released)
+    if (option.opt_dump)
+    {
+        printf("Dump RAM from SRAM...");
+        time_start = Get_Time();
+        ops_start  = GPIO_Op_Count();
+        SRAM_Read_Range(rom_dst, SRAM_DATA_BASE, SRAM_SIZE - 1, NULL);
+        if (Write_Dump_File(rom_dst + SRAM_DATA_BASE, MAXRAM, option.opt_dump_name))
+        {
+            printf("NG.\n");
+            error = 1;
+        }
+        else
+        {
+            Print_Throughput("Done", MAXRAM, Get_Time() - time_start, GPIO_Op_Count() - ops_start);
+        }
+    }
     // Clean Up
     printf("Clean Up all\n");    
     //
@@ -0,0 +1,177 @@
+//===========================================================
+// bfCPU Running Tool
+//-----------------------------------------------------------
+// File Name   : pwmclk.c
+// Description : PWM System Clock
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "defines.h"
+#include "gpio.h"
+#include "pwmclk.h"
+
+//-----------------------------------------------------------
+// PWM System Clock
+//     The sysfs PWM files are written directly, without
+//     shell, sudo nor tee. Each value is read first and
+//     written only if it differs, so starting an already
+//     running clock writes nothing. Write access is checked
+//     once; bfRun needs to run as root, or as a member of
+//     the group which udev gives the PWM files to (gpio on
+//     Raspberry Pi OS).
+//-----------------------------------------------------------
+static int pwm_period = PWM_PERIOD_DEFAULT; // ns
+static int pwm_duty   = -1;                 // ns, -1 for half of period
+
+//------------------------------
+// Set Period and Duty Cycle
+//------------------------------
+void PWM_Clock_Config(int period, int duty)
+{
+    pwm_period = period;
+    pwm_duty   = duty;
+}
+
+//------------------------------
+// sysfs Directory of PWM Chip
+//------------------------------
+static const char *PWM_Root(void)
+{
+    const char *root = getenv(PWM_SYSFS_ENV);
+    //
+    return ((root == NULL) || (root[0] == '\0'))? PWM_SYSFS_DEFAULT : root;
+}
+
+//------------------------------
+// Path of sysfs File
+//     name == NULL for Channel Directory
+//------------------------------
+static void PWM_Path(char *path, const char *name)
+{
+    const char *root = PWM_Root();
+    //
+    if (name == NULL)
+        snprintf(path, MAXLEN_LINE, "%s/pwm%d", root, PWM_CHANNEL);
+    else
+        snprintf(path, MAXLEN_LINE, "%s/pwm%d/%s", root, PWM_CHANNEL, name);
+}
+
+//------------------------------
+// Read a Value
+//     Returns -1 if unreadable.
+//------------------------------
+static long PWM_Read(const char *path)
+{
+    FILE *fp;
+    long value;
+    //
+    if ((fp = fopen(path, "r")) == NULL) return -1;
+    if (fscanf(fp, "%ld", &value) != 1) value = -1;
+    fclose(fp);
+    return value;
+}
+
+//------------------------------
+// Write a Value
+//     Returns 0 if OK.
+//------------------------------
+static int PWM_Write(const char *path, long value)
+{
+    FILE *fp;
+    int error;
+    //
+    if ((fp = fopen(path, "w")) == NULL) return 1;
+    error = (fprintf(fp, "%ld\n", value) < 0);
+    error = (fclose(fp) != 0) || error;
+    if (error) fprintf(stderr, "Can't write %ld to \"%s\".\n", value, path);
+    return error;
+}
+
+//------------------------------
+// Set a Value if it differs
+//------------------------------
+static int PWM_Set(const char *name, long value)
+{
+    char path[MAXLEN_LINE];
+    //
+    PWM_Path(path, name);
+    if (PWM_Read(path) == value) return 0;
+    return PWM_Write(path, value);
+}
+
+//------------------------------
+// Export PWM Channel
+//     Returns 0 if OK.
+//------------------------------
+static int PWM_Export(void)
+{
+    char path[MAXLEN_LINE];
+    int i;
+    //
+    PWM_Path(path, NULL);
+    if (access(path, F_OK) == 0) return 0;
+    //
+    snprintf(path, MAXLEN_LINE, "%s/export", PWM_Root());
+    if (PWM_Write(path, PWM_CHANNEL)) return 1;
+    //
+    // Wait for the Channel (and its Permission by udev)
+    PWM_Path(path, "enable");
+    for (i = 0; i < PWM_EXPORT_WAIT; i++)
+    {
+        if (access(path, W_OK) == 0) return 0;
+        usleep(10000);
+    }
+    return 1;
+}
+
+//------------------------------
+// System Clock Output (GPIO18)
+//     Common to the hardware backends
+//------------------------------
+int Raspi_SysClk_Output(int start)
+{
+    char path[MAXLEN_LINE];
+    int  duty;
+    //
+    // Nothing to Stop if not exported
+    PWM_Path(path, NULL);
+    if ((start == 0) && (access(path, F_OK) != 0)) return EXIT_SUCCESS;
+    //
+    // Export and Check Privilege
+    PWM_Path(path, "enable");
+    if (PWM_Export() || (access(path, W_OK) != 0))
+    {
+        fprintf(stderr, "Can't access \"%s\".\n", path);
+        fprintf(stderr, "Run as root (or group gpio) with \"dtoverlay=pwm-2chan\" in config.txt.\n");
+        return EXIT_FAILURE;
+    }
+    //
+    // Stop
+    if (start == 0) return (PWM_Set("enable", 0))? EXIT_FAILURE : EXIT_SUCCESS;
+    //
+    // Period and Duty Cycle
+    //     duty_cycle can't exceed period at any time.
+    duty = (pwm_duty < 0)? pwm_period / 2 : pwm_duty;
+    PWM_Path(path, "duty_cycle");
+    if (PWM_Read(path) > pwm_period)
+    {
+        if (PWM_Set("duty_cycle", duty)) return EXIT_FAILURE;
+    }
+    if (PWM_Set("period", pwm_period))   return EXIT_FAILURE;
+    if (PWM_Set("duty_cycle", duty))     return EXIT_FAILURE;
+    //
+    // Start
+    if (PWM_Set("enable", 1))            return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
+
+//===========================================================
+// End of File
+//===========================================================
@@ -0,0 +1,38 @@
+//===========================================================
+// bfCPU Running Tool
+//-----------------------------------------------------------
+// File Name   : pwmclk.h
+// Description : PWM System Clock Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#ifndef __PWMCLK_H__
+#define __PWMCLK_H__
+
+//-----------------------------------
+// PWM Parameters
+//     GPIO18 is PWM0-CHAN2, enabled by
+//     "dtoverlay=pwm-2chan" in
+//     /boot/firmware/config.txt
+//-----------------------------------
+#define PWM_SYSFS_DEFAULT  "/sys/class/pwm/pwmchip0"
+#define PWM_CHANNEL        2
+#define PWM_PERIOD_DEFAULT 100 // ns (10MHz)
+#define PWM_EXPORT_WAIT    100 // x10ms, until udev gives access to the channel
+//
+// Fake sysfs Directory used instead (for test)
+#define PWM_SYSFS_ENV "BFRUN_PWM_SYSFS"
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+void PWM_Clock_Config(int period, int duty);
+
+#endif
+//===========================================================
+// End of File
+//===========================================================
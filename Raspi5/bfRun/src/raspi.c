@@ -2,7 +2,7 @@
 // bfCPU Running Tool
 //-----------------------------------------------------------
 // File Name   : raspi.c
-// Description : Raspberry Pi Control Routine
+// Description : Raspberry Pi Control Routine (libgpiod Backend)
 //-----------------------------------------------------------
 // History :
 // Rev.01 2025.11.03 M.Maruyama First Release
@@ -13,9 +13,12 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
-#include <gpiod.h>
+#include "gpio.h"
 #include "raspi.h"
 
+#ifndef NO_GPIOD
+#include <gpiod.h>
+
 // CLK       : GPIO18
 // RES_N     : GPIO23
 // QSPI_CS_N : GPIO0
@@ -27,18 +30,21 @@
 
 //-------------------------
 // GPIO Configurations
+//     CS_N, SCK and SIO0-3 are requested as one
+//     bus, so that data and clock edges can be
+//     driven by a single set_values call.
 //-------------------------
 #define GPIO_RESN_NUM_LINES 1
-#define GPIO_CSN_NUM_LINES  1
-#define GPIO_SCK_NUM_LINES  1
+#define GPIO_BUS_NUM_LINES  6
 #define GPIO_SIO_NUM_LINES  4
-#define GPIO_SI_NUM_LINES   1
 //
 static const unsigned int gpio_resn_offsets[] = {23};
-static const unsigned int gpio_csn_offsets[]  = {0};
-static const unsigned int gpio_sck_offsets[]  = {5};
-static const unsigned int gpio_sio_offsets[]  = {6, 13, 19, 26};
-static const unsigned int gpio_si_offsets[]   = {6};
+static const unsigned int gpio_bus_offsets[]  = {0, 5, 6, 13, 19, 26};
+//
+// Position in the Bus
+#define GPIO_BUS_CSN 0
+#define GPIO_BUS_SCK 1
+#define GPIO_BUS_SIO 2 // SIO0(SI)..SIO3
 //
 struct gpiod_chip *chip;
 //
@@ -49,88 +55,17 @@ struct gpiod_line_request   *gpio_resn_request;
 enum   gpiod_line_value      gpio_resn_values[GPIO_RESN_NUM_LINES];
 //
 struct gpiod_line_settings  *gpio_csn_settings;
-struct gpiod_line_config    *gpio_csn_config;
-struct gpiod_request_config *gpio_csn_req_cfg;
-struct gpiod_line_request   *gpio_csn_request;
-enum   gpiod_line_value      gpio_csn_values[GPIO_CSN_NUM_LINES];
-//
 struct gpiod_line_settings  *gpio_sck_settings;
-struct gpiod_line_config    *gpio_sck_config;
-struct gpiod_request_config *gpio_sck_req_cfg;
-struct gpiod_line_request   *gpio_sck_request;
-enum   gpiod_line_value      gpio_sck_values[GPIO_SCK_NUM_LINES];
-//
 struct gpiod_line_settings  *gpio_sio_settings;
-struct gpiod_line_config    *gpio_sio_config;
-struct gpiod_request_config *gpio_sio_req_cfg;
-struct gpiod_line_request   *gpio_sio_request;
-enum   gpiod_line_value      gpio_sio_values[GPIO_SIO_NUM_LINES];
-//
-struct gpiod_line_settings  *gpio_si_settings;
-struct gpiod_line_config    *gpio_si_config;
-struct gpiod_request_config *gpio_si_req_cfg;
-struct gpiod_line_request   *gpio_si_request;
-enum   gpiod_line_value      gpio_si_values[GPIO_SI_NUM_LINES];
-
-//------------------------------
-// System Clock Output (GPIO18)
-//------------------------------
-int SysClk_Output(int start)
-{
-    FILE *fp;
-    char buffer[256];
-    const char *cmd_check = "[ -d \"/sys/class/pwm/pwmchip0/pwm2\" ] && echo 1 || echo 0";
-    int  exist;
-    //
-    // Check existence of the directory "/sys/class/pwm/pwmchip0/pwm2"
-    fp = popen(cmd_check, "r");
-    if (fp == NULL)
-    {
-        perror("popen failed");
-        return EXIT_FAILURE;
-    }
-    //
-    // Read 1st Line
-    fgets(buffer, sizeof(buffer), fp);
-    //
-    // Close Pipe
-    if (pclose(fp) == -1)
-    {
-        perror("pclose failed");
-        return EXIT_FAILURE;
-    }
-    //
-    // Exsistence
-    exist = (buffer[0] == '1')? 1 : 0;
-    //    
-    // Create PWM Clock from GPIO18(PWM0-CHAN2)
-    //     You need to add following line at bottom of /boot/firmware/config.txt
-    //         dtoverlay=pwm-2chan
-    if (exist == 0)
-    {
-	    system("echo   2 | sudo tee /sys/class/pwm/pwmchip0/export > /dev/null");
-	    system("echo 100 | sudo tee /sys/class/pwm/pwmchip0/pwm2/period > /dev/null");
-	    system("echo  50 | sudo tee /sys/class/pwm/pwmchip0/pwm2/duty_cycle > /dev/null");
-    }
-    // Start
-    if (start)
-    {
-		system("echo   1 | sudo tee /sys/class/pwm/pwmchip0/pwm2/enable > /dev/null");
-	}
-	// Stop
-	else
-	{
-		system("echo   0 | sudo tee /sys/class/pwm/pwmchip0/pwm2/enable > /dev/null");
-	}
-    //
-    // Success
-    return EXIT_SUCCESS;
-}
+struct gpiod_line_config    *gpio_bus_config;
+struct gpiod_request_config *gpio_bus_req_cfg;
+struct gpiod_line_request   *gpio_bus_request;
+enum   gpiod_line_value      gpio_bus_values[GPIO_BUS_NUM_LINES];
 
 //------------------------------
 // CHIP Open
 //------------------------------
-void CHIP_Open(void)
+static void Gpiod_CHIP_Open(void)
 {
     chip = gpiod_chip_open("/dev/gpiochip4");
 }
@@ -138,7 +73,7 @@ void CHIP_Open(void)
 //------------------------------
 // CHIP Close
 //------------------------------
-void CHIP_Close(void)
+static void Gpiod_CHIP_Close(void)
 {
     gpiod_chip_close(chip);
 }
@@ -146,7 +81,7 @@ void CHIP_Close(void)
 //------------------------------
 // RES_N Initializaton
 //------------------------------
-void RESN_Init(void)
+static void Gpiod_RESN_Init(void)
 {
     gpio_resn_settings = gpiod_line_settings_new();
     gpio_resn_config   = gpiod_line_config_new();
@@ -166,7 +101,7 @@ void RESN_Init(void)
 //------------------------------
 // RES_N Clean Up
 //------------------------------
-void RESN_CleanUp(void)
+static void Gpiod_RESN_CleanUp(void)
 {
     gpiod_line_request_release(gpio_resn_request);
     gpiod_request_config_free(gpio_resn_req_cfg);
@@ -176,81 +111,60 @@ void RESN_CleanUp(void)
 //-----------------------------
 // GPIO_RES_N Set Value
 //-----------------------------
-void GPIO_RESN_Set_Value(int value)
+static void Gpiod_RESN_Set_Value(int value)
 {
 	gpio_resn_values[0] = value & 0x01;
 	gpiod_line_request_set_values(gpio_resn_request, gpio_resn_values);	
 }
 
+//------------------------------
+// Open Drain Output Settings
+//------------------------------
+static struct gpiod_line_settings *Gpiod_Open_Drain_Settings(void)
+{
+    struct gpiod_line_settings *settings;
+    //
+    settings = gpiod_line_settings_new();
+    gpiod_line_settings_set_bias(settings, GPIOD_LINE_BIAS_PULL_UP);
+    gpiod_line_settings_set_drive(settings, GPIOD_LINE_DRIVE_OPEN_DRAIN);    
+    gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_OUTPUT);
+    gpiod_line_settings_set_output_value(settings, 1); // default Hi-Z
+    return settings;
+}
+
 //------------------------------
 // QSPI Initializaton
+//     CS_N, SCK and SIO0-3 in one request.
 //------------------------------
-void QSPI_Init(void)
+static void Gpiod_QSPI_Init(void)
 {
-    //---------------------------------------------
-    // Initializaion of GPIO_CS_N (1bit)
-    //---------------------------------------------
-    gpio_csn_settings = gpiod_line_settings_new();
-    gpio_csn_config   = gpiod_line_config_new();
-    gpio_csn_req_cfg  = gpiod_request_config_new();
+    int i;
     //
-    gpiod_line_settings_set_bias(gpio_csn_settings, GPIOD_LINE_BIAS_PULL_UP);
-    gpiod_line_settings_set_drive(gpio_csn_settings, GPIOD_LINE_DRIVE_OPEN_DRAIN);    
-    gpiod_line_settings_set_direction(gpio_csn_settings, GPIOD_LINE_DIRECTION_OUTPUT);
-    gpiod_line_settings_set_output_value(gpio_csn_settings, 1); // default Hi-Z
+    gpio_csn_settings = Gpiod_Open_Drain_Settings();
+    gpio_sck_settings = Gpiod_Open_Drain_Settings();
+    gpio_sio_settings = Gpiod_Open_Drain_Settings();
+    gpio_bus_config   = gpiod_line_config_new();
+    gpio_bus_req_cfg  = gpiod_request_config_new();
     //
     gpiod_line_config_add_line_settings(
-        gpio_csn_config, gpio_csn_offsets, GPIO_RESN_NUM_LINES, gpio_csn_settings);
-    //
-    gpio_csn_request = gpiod_chip_request_lines(chip, gpio_csn_req_cfg, gpio_csn_config);
-    //
-    //---------------------------------------------
-    // Initializaion of GPIO_SCK (1bit)
-    //---------------------------------------------
-    gpio_sck_settings = gpiod_line_settings_new();
-    gpio_sck_config   = gpiod_line_config_new();
-    gpio_sck_req_cfg  = gpiod_request_config_new();
-    //
-    gpiod_line_settings_set_bias(gpio_sck_settings, GPIOD_LINE_BIAS_PULL_UP);
-    gpiod_line_settings_set_drive(gpio_sck_settings, GPIOD_LINE_DRIVE_OPEN_DRAIN);    
-    gpiod_line_settings_set_direction(gpio_sck_settings, GPIOD_LINE_DIRECTION_OUTPUT);
-    gpiod_line_settings_set_output_value(gpio_sck_settings, 1); // default Hi-Z
-    //
+        gpio_bus_config, &gpio_bus_offsets[GPIO_BUS_CSN], 1, gpio_csn_settings);
     gpiod_line_config_add_line_settings(
-        gpio_sck_config, gpio_sck_offsets, GPIO_RESN_NUM_LINES, gpio_sck_settings);
-    //
-    gpio_sck_request = gpiod_chip_request_lines(chip, gpio_sck_req_cfg, gpio_sck_config);
-    //    
-    //---------------------------------------------
-    // Initializaion of GPIO_SIO (4bit)
-    //---------------------------------------------
-    gpio_sio_settings = gpiod_line_settings_new();
-    gpio_sio_config   = gpiod_line_config_new();
-    gpio_sio_req_cfg  = gpiod_request_config_new();
-    //
-    gpiod_line_settings_set_bias(gpio_sio_settings, GPIOD_LINE_BIAS_PULL_UP);
-    gpiod_line_settings_set_drive(gpio_sio_settings, GPIOD_LINE_DRIVE_OPEN_DRAIN);    
-    gpiod_line_settings_set_direction(gpio_sio_settings, GPIOD_LINE_DIRECTION_OUTPUT);
-    gpiod_line_settings_set_output_value(gpio_sio_settings, 1); // default Hi-Z
-    //
+        gpio_bus_config, &gpio_bus_offsets[GPIO_BUS_SCK], 1, gpio_sck_settings);
     gpiod_line_config_add_line_settings(
-        gpio_sio_config, gpio_sio_offsets, GPIO_SIO_NUM_LINES, gpio_sio_settings);
+        gpio_bus_config, &gpio_bus_offsets[GPIO_BUS_SIO], GPIO_SIO_NUM_LINES, gpio_sio_settings);
     //
-    gpio_sio_request = gpiod_chip_request_lines(
-        chip, gpio_sio_req_cfg, gpio_sio_config);
+    gpio_bus_request = gpiod_chip_request_lines(chip, gpio_bus_req_cfg, gpio_bus_config);
+    for (i = 0; i < GPIO_BUS_NUM_LINES; i++) gpio_bus_values[i] = 1;
 }
 
 //------------------------------
 // QSPI Cleanup
 //------------------------------
-void QSPI_CleanUp(void)
+static void Gpiod_QSPI_CleanUp(void)
 {
-    gpiod_line_request_release(gpio_csn_request);
-    gpiod_line_request_release(gpio_sck_request);
-    gpiod_line_request_release(gpio_sio_request);
-    gpiod_request_config_free(gpio_csn_req_cfg);
-    gpiod_request_config_free(gpio_sck_req_cfg);
-    gpiod_request_config_free(gpio_sio_req_cfg);
+    gpiod_line_request_release(gpio_bus_request);
+    gpiod_request_config_free(gpio_bus_req_cfg);
+    gpiod_line_config_free(gpio_bus_config);
     gpiod_line_settings_free(gpio_csn_settings);
     gpiod_line_settings_free(gpio_sck_settings);
     gpiod_line_settings_free(gpio_sio_settings);
@@ -258,212 +172,177 @@ void QSPI_CleanUp(void)
 
 //------------------------------
 // SPI Initializaton
+//     Same bus as QSPI, SIO1-3 stay released
+//     (SIO3 is HOLD_N, pulled up).
 //------------------------------
-void SPI_Init(void)
+static void Gpiod_SPI_Init(void)
 {
-    //---------------------------------------------
-    // Initializaion of GPIO_CS_N (1bit)
-    //---------------------------------------------
-    gpio_csn_settings = gpiod_line_settings_new();
-    gpio_csn_config   = gpiod_line_config_new();
-    gpio_csn_req_cfg  = gpiod_request_config_new();
-    //
-    gpiod_line_settings_set_bias(gpio_csn_settings, GPIOD_LINE_BIAS_PULL_UP);
-    gpiod_line_settings_set_drive(gpio_csn_settings, GPIOD_LINE_DRIVE_OPEN_DRAIN);    
-    gpiod_line_settings_set_direction(gpio_csn_settings, GPIOD_LINE_DIRECTION_OUTPUT);
-    gpiod_line_settings_set_output_value(gpio_csn_settings, 1); // default Hi-Z
-    //
-    gpiod_line_config_add_line_settings(
-        gpio_csn_config, gpio_csn_offsets, GPIO_RESN_NUM_LINES, gpio_csn_settings);
-    //
-    gpio_csn_request = gpiod_chip_request_lines(chip, gpio_csn_req_cfg, gpio_csn_config);
-    //
-    //---------------------------------------------
-    // Initializaion of GPIO_SCK (1bit)
-    //---------------------------------------------
-    gpio_sck_settings = gpiod_line_settings_new();
-    gpio_sck_config   = gpiod_line_config_new();
-    gpio_sck_req_cfg  = gpiod_request_config_new();
-    //
-    gpiod_line_settings_set_bias(gpio_sck_settings, GPIOD_LINE_BIAS_PULL_UP);
-    gpiod_line_settings_set_drive(gpio_sck_settings, GPIOD_LINE_DRIVE_OPEN_DRAIN);    
-    gpiod_line_settings_set_direction(gpio_sck_settings, GPIOD_LINE_DIRECTION_OUTPUT);
-    gpiod_line_settings_set_output_value(gpio_sck_settings, 1); // default Hi-Z
-    //
-    gpiod_line_config_add_line_settings(
-        gpio_sck_config, gpio_sck_offsets, GPIO_RESN_NUM_LINES, gpio_sck_settings);
-    //
-    gpio_sck_request = gpiod_chip_request_lines(chip, gpio_sck_req_cfg, gpio_sck_config);
-    //---------------------------------------------
-    // Initializaion of GPIO_SI (1bit)
-    //---------------------------------------------
-    gpio_si_settings = gpiod_line_settings_new();
-    gpio_si_config   = gpiod_line_config_new();
-    gpio_si_req_cfg  = gpiod_request_config_new();
-    //
-    gpiod_line_settings_set_bias(gpio_si_settings, GPIOD_LINE_BIAS_PULL_UP);
-    gpiod_line_settings_set_drive(gpio_si_settings, GPIOD_LINE_DRIVE_OPEN_DRAIN);    
-    gpiod_line_settings_set_direction(gpio_si_settings, GPIOD_LINE_DIRECTION_OUTPUT);
-    gpiod_line_settings_set_output_value(gpio_si_settings, 1); // default Hi-Z
-    //
-    gpiod_line_config_add_line_settings(
-        gpio_si_config, gpio_si_offsets, GPIO_SI_NUM_LINES, gpio_si_settings);
-    //
-    gpio_si_request = gpiod_chip_request_lines(chip, gpio_si_req_cfg, gpio_si_config);
+    Gpiod_QSPI_Init();
 }
 
 //------------------------------
 // SPI Cleanup
 //------------------------------
-void SPI_CleanUp(void)
+static void Gpiod_SPI_CleanUp(void)
 {
-    gpiod_line_request_release(gpio_csn_request);
-    gpiod_line_request_release(gpio_sck_request);
-    gpiod_line_request_release(gpio_si_request);
-    gpiod_request_config_free(gpio_csn_req_cfg);
-    gpiod_request_config_free(gpio_sck_req_cfg);
-    gpiod_request_config_free(gpio_si_req_cfg);
-    gpiod_line_settings_free(gpio_csn_settings);
-    gpiod_line_settings_free(gpio_sck_settings);
-    gpiod_line_settings_free(gpio_si_settings);
+    Gpiod_QSPI_CleanUp();
 }
 
 //----------------------------
-// GPIO_CS_N Set Direction
+// Bus Line Set Direction
 //----------------------------
-void GPIO_CS_N_Set_Direction(int direction)
+static void Gpiod_Bus_Set_Direction(struct gpiod_line_settings *settings,
+    int pos, int num, int direction, int value)
 {
-	direction = (direction == 0)? GPIOD_LINE_DIRECTION_INPUT
-	          : GPIOD_LINE_DIRECTION_OUTPUT;
-    gpiod_line_settings_set_direction(gpio_csn_settings, direction);
+    int i;
+    //
+    direction = (direction == 0)? GPIOD_LINE_DIRECTION_INPUT
+              : GPIOD_LINE_DIRECTION_OUTPUT;
+    gpiod_line_settings_set_direction(settings, direction);
     //
     gpiod_line_config_add_line_settings(
-        gpio_csn_config, gpio_csn_offsets, GPIO_CSN_NUM_LINES, gpio_csn_settings);
+        gpio_bus_config, &gpio_bus_offsets[pos], num, settings);
     //
-    gpio_csn_values[0] = 1;
-    gpiod_line_request_set_values(gpio_csn_request, gpio_csn_values);
+    for (i = 0; i < num; i++) gpio_bus_values[pos + i] = value;
+    gpiod_line_request_set_values(gpio_bus_request, gpio_bus_values);
     //
-    gpiod_line_request_reconfigure_lines(gpio_csn_request, gpio_csn_config);
+    gpiod_line_request_reconfigure_lines(gpio_bus_request, gpio_bus_config);
 }
-
-//----------------------------
-// GPIO_SCK Set Direction
-//----------------------------
-void GPIO_SCK_Set_Direction(int direction)
+//
+static void Gpiod_CS_N_Set_Direction(int direction)
 {
-	direction = (direction == 0)? GPIOD_LINE_DIRECTION_INPUT
-	          : GPIOD_LINE_DIRECTION_OUTPUT;
-    gpiod_line_settings_set_direction(gpio_sck_settings, direction);
-    //
-    gpiod_line_config_add_line_settings(
-        gpio_sck_config, gpio_sck_offsets, GPIO_SCK_NUM_LINES, gpio_sck_settings);
-    //
-    gpio_sck_values[0] = 0;
-    gpiod_line_request_set_values(gpio_sck_request, gpio_sck_values);
-    //
-    gpiod_line_request_reconfigure_lines(gpio_sck_request, gpio_sck_config);
+    Gpiod_Bus_Set_Direction(gpio_csn_settings, GPIO_BUS_CSN, 1, direction, 1);
 }
-
-//----------------------------
-// GPIO_SIO Set Direction
-//----------------------------
-void GPIO_SIO_Set_Direction(int direction)
+//
+static void Gpiod_SCK_Set_Direction(int direction)
 {
-	direction = (direction == 0)? GPIOD_LINE_DIRECTION_INPUT
-	          : GPIOD_LINE_DIRECTION_OUTPUT;
-    gpiod_line_settings_set_direction(gpio_sio_settings, direction);
-    //
-    gpiod_line_config_add_line_settings(
-        gpio_sio_config, gpio_sio_offsets, GPIO_SIO_NUM_LINES, gpio_sio_settings);
-    //
-    gpio_sio_values[0] = 0;
-    gpio_sio_values[1] = 0;
-    gpio_sio_values[2] = 0;
-    gpio_sio_values[3] = 0;
-    gpiod_line_request_set_values(gpio_sio_request, gpio_sio_values);
-    //
-    gpiod_line_request_reconfigure_lines(gpio_sio_request, gpio_sio_config);
+    Gpiod_Bus_Set_Direction(gpio_sck_settings, GPIO_BUS_SCK, 1, direction, 0);
+}
+//
+static void Gpiod_SIO_Set_Direction(int direction)
+{
+    Gpiod_Bus_Set_Direction(gpio_sio_settings, GPIO_BUS_SIO, GPIO_SIO_NUM_LINES, direction, 0);
+}
+//
+static void Gpiod_SI_Set_Direction(int direction)
+{
+    Gpiod_Bus_Set_Direction(gpio_sio_settings, GPIO_BUS_SIO, 1, direction, 0);
 }
 
-//----------------------------
-// GPIO_SI Set Direction
-//----------------------------
-void GPIO_SI_Set_Direction(int direction)
+//-----------------------------
+// GPIO_BUS Set Value
+//     CS_N, SCK and SIO0-3 at once
+//-----------------------------
+static void Gpiod_BUS_Set_Value(int csn, int sck, int sio)
 {
-	direction = (direction == 0)? GPIOD_LINE_DIRECTION_INPUT
-	          : GPIOD_LINE_DIRECTION_OUTPUT;
-    gpiod_line_settings_set_direction(gpio_si_settings, direction);
-    //
-    gpiod_line_config_add_line_settings(
-        gpio_si_config, gpio_si_offsets, GPIO_SI_NUM_LINES, gpio_si_settings);
-    //
-    gpio_si_values[0] = 0;
-    gpiod_line_request_set_values(gpio_si_request, gpio_si_values);
-    //
-    gpiod_line_request_reconfigure_lines(gpio_si_request, gpio_si_config);
+	gpio_bus_values[GPIO_BUS_CSN    ] = csn & 0x01;
+	gpio_bus_values[GPIO_BUS_SCK    ] = sck & 0x01;
+	gpio_bus_values[GPIO_BUS_SIO + 0] = (sio >> 0) & 0x01;
+	gpio_bus_values[GPIO_BUS_SIO + 1] = (sio >> 1) & 0x01;
+	gpio_bus_values[GPIO_BUS_SIO + 2] = (sio >> 2) & 0x01;
+	gpio_bus_values[GPIO_BUS_SIO + 3] = (sio >> 3) & 0x01;
+	gpiod_line_request_set_values(gpio_bus_request, gpio_bus_values);	
 }
 
 //-----------------------------
 // GPIO_CS_N Set Value
 //-----------------------------
-void GPIO_CSN_Set_Value(int value)
+static void Gpiod_CSN_Set_Value(int value)
 {
-	gpio_csn_values[0] = value & 0x01;
-	gpiod_line_request_set_values(gpio_csn_request, gpio_csn_values);	
+	gpio_bus_values[GPIO_BUS_CSN] = value & 0x01;
+	gpiod_line_request_set_values(gpio_bus_request, gpio_bus_values);	
 }
 
 //-----------------------------
 // GPIO_SCK Set Value
 //-----------------------------
-void GPIO_SCK_Set_Value(int value)
+static void Gpiod_SCK_Set_Value(int value)
 {
-	gpio_sck_values[0] = value & 0x01;
-	gpiod_line_request_set_values(gpio_sck_request, gpio_sck_values);	
+	gpio_bus_values[GPIO_BUS_SCK] = value & 0x01;
+	gpiod_line_request_set_values(gpio_bus_request, gpio_bus_values);	
 }
 
 //-----------------------------
 // GPIO_SIO Set Value
 //-----------------------------
-void GPIO_SIO_Set_Value(int value)
+static void Gpiod_SIO_Set_Value(int value)
 {
-	gpio_sio_values[0] = (value >> 0) & 0x01;
-	gpio_sio_values[1] = (value >> 1) & 0x01;
-	gpio_sio_values[2] = (value >> 2) & 0x01;
-	gpio_sio_values[3] = (value >> 3) & 0x01;
-	gpiod_line_request_set_values(gpio_sio_request, gpio_sio_values);	
+	gpio_bus_values[GPIO_BUS_SIO + 0] = (value >> 0) & 0x01;
+	gpio_bus_values[GPIO_BUS_SIO + 1] = (value >> 1) & 0x01;
+	gpio_bus_values[GPIO_BUS_SIO + 2] = (value >> 2) & 0x01;
+	gpio_bus_values[GPIO_BUS_SIO + 3] = (value >> 3) & 0x01;
+	gpiod_line_request_set_values(gpio_bus_request, gpio_bus_values);	
 }
 
 //-----------------------------
 // GPIO_SIO Get Value
 //-----------------------------
-void GPIO_SIO_Get_Value(int *value)
+static void Gpiod_SIO_Get_Value(int *value)
 {
-	gpiod_line_request_get_values(gpio_sio_request, gpio_sio_values);
+    enum gpiod_line_value values[GPIO_SIO_NUM_LINES];
+    //
+	gpiod_line_request_get_values_subset(gpio_bus_request,
+	    GPIO_SIO_NUM_LINES, &gpio_bus_offsets[GPIO_BUS_SIO], values);
 	*value = 0;
-	*value = *value | (gpio_sio_values[0] << 0);
-	*value = *value | (gpio_sio_values[1] << 1);
-	*value = *value | (gpio_sio_values[2] << 2);
-	*value = *value | (gpio_sio_values[3] << 3);
+	*value = *value | (values[0] << 0);
+	*value = *value | (values[1] << 1);
+	*value = *value | (values[2] << 2);
+	*value = *value | (values[3] << 3);
 }
 
 //-----------------------------
 // GPIO_SI Set Value
 //-----------------------------
-void GPIO_SI_Set_Value(int value)
+static void Gpiod_SI_Set_Value(int value)
 {
-	gpio_si_values[0] = value & 0x01;
-	gpiod_line_request_set_values(gpio_si_request, gpio_si_values);	
+	gpio_bus_values[GPIO_BUS_SIO] = value & 0x01;
+	gpiod_line_request_set_values(gpio_bus_request, gpio_bus_values);	
 }
 
 //-----------------------------
 // GPIO_SI Get Value
 //-----------------------------
-void GPIO_SI_Get_Value(int *value)
+static void Gpiod_SI_Get_Value(int *value)
 {
-	gpiod_line_request_get_values(gpio_si_request, gpio_si_values);
-	*value = gpio_si_values[0];
+    enum gpiod_line_value values[1];
+    //
+	gpiod_line_request_get_values_subset(gpio_bus_request,
+	    1, &gpio_bus_offsets[GPIO_BUS_SIO], values);
+	*value = values[0];
 }
 
+//-----------------------------
+// libgpiod Backend
+//-----------------------------
+const sGPIO_BACKEND GPIO_Backend_Gpiod =
+{
+    "gpiod",
+    1,
+    Raspi_SysClk_Output,
+    Gpiod_CHIP_Open,
+    Gpiod_CHIP_Close,
+    Gpiod_RESN_Init,
+    Gpiod_RESN_CleanUp,
+    Gpiod_QSPI_Init,
+    Gpiod_QSPI_CleanUp,
+    Gpiod_SPI_Init,
+    Gpiod_SPI_CleanUp,
+    Gpiod_CS_N_Set_Direction,
+    Gpiod_SCK_Set_Direction,
+    Gpiod_SIO_Set_Direction,
+    Gpiod_SI_Set_Direction,
+    Gpiod_RESN_Set_Value,
+    Gpiod_CSN_Set_Value,
+    Gpiod_SCK_Set_Value,
+    Gpiod_SIO_Set_Value,
+    Gpiod_SIO_Get_Value,
+    Gpiod_SI_Set_Value,
+    Gpiod_SI_Get_Value,
+    Gpiod_BUS_Set_Value
+};
+
+#endif // NO_GPIOD
+
 //===========================================================
 // End of File
 //===========================================================
@@ -41,6 +41,7 @@ void GPIO_SIO_Set_Value(int value);
 void GPIO_SIO_Get_Value(int *value);
 void GPIO_SI_Set_Value(int value);
 void GPIO_SI_Get_Value(int *value);
+void GPIO_BUS_Set_Value(int csn, int sck, int sio);
 
 
 #endif
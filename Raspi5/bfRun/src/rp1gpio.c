@@ -0,0 +1,501 @@
+//===========================================================
+// bfCPU Running Tool
+//-----------------------------------------------------------
+// File Name   : rp1gpio.c
+// Description : RP1 GPIO Register Backend (/dev/gpiomem0)
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "gpio.h"
+#include "raspi.h"
+
+//-----------------------------------------------------------
+// RP1 Registers
+//     /dev/gpiomem0 maps IO_BANK0, SYS_RIO0 and PADS_BANK0
+//     of RP1 (0x400d0000-0x400fffff). The pins are switched
+//     to the RIO function and driven by register writes,
+//     without any system call per edge.
+//     Open drain is made by RIO_OUT=0 and RIO_OE
+//     (1 = drive Low, 0 = released to the pull-up).
+//     Writes to RP1 go over PCIe and are posted, so every
+//     change is followed by a barrier and read backs, which
+//     also give the setup and hold time to the lines.
+//-----------------------------------------------------------
+#define RP1_GPIOMEM      "/dev/gpiomem0"
+#define RP1_GPIOMEM_SIZE 0x30000
+//
+#define RP1_IO_BANK0 0x00000
+#define RP1_RIO0     0x10000
+#define RP1_PADS0    0x20000
+//
+// Atomic Access Aliases (for every block)
+#define RP1_ALIAS 0x3000
+#define RP1_XOR   0x1000
+#define RP1_SET   0x2000
+#define RP1_CLR   0x3000
+//
+// IO_BANK0
+#define RP1_GPIO_CTRL(n)  (RP1_IO_BANK0 + (n) * 8 + 4)
+#define RP1_FUNCSEL_MASK  0x1f
+#define RP1_FUNCSEL_RIO   0x05
+#define RP1_FUNCSEL_NULL  0x1f
+//
+// SYS_RIO0
+#define RP1_RIO_OUT (RP1_RIO0 + 0x00)
+#define RP1_RIO_OE  (RP1_RIO0 + 0x04)
+#define RP1_RIO_IN  (RP1_RIO0 + 0x08)
+//
+// PADS_BANK0
+#define RP1_PADS(n)  (RP1_PADS0 + 4 + (n) * 4)
+#define RP1_PADS_OD  (1 << 7) // Output Disable
+#define RP1_PADS_IE  (1 << 6) // Input Enable
+#define RP1_PADS_PUE (1 << 3) // Pull Up Enable
+#define RP1_PADS_PDE (1 << 2) // Pull Down Enable
+//
+// Read Backs after each Change
+#define RP1_SETTLE_READS 2
+
+//-------------------------
+// Pin Assignment
+//-------------------------
+#define RP1_NUM_PINS 7
+#define RP1_PIN_RESN 0 // index in rp1_pins[]
+#define RP1_PIN_BUS  1
+//
+static const int rp1_pins[RP1_NUM_PINS] = {23, 0, 5, 6, 13, 19, 26};
+static const int rp1_sio_pins[4] = {6, 13, 19, 26};
+//
+#define RP1_MASK_RESN (1u << 23)
+#define RP1_MASK_CSN  (1u <<  0)
+#define RP1_MASK_SCK  (1u <<  5)
+#define RP1_MASK_SI   (1u <<  6)
+#define RP1_MASK_SIO  ((1u << 6) | (1u << 13) | (1u << 19) | (1u << 26))
+#define RP1_MASK_BUS  (RP1_MASK_CSN | RP1_MASK_SCK | RP1_MASK_SIO)
+
+//-------------------------
+// Backend State
+//-------------------------
+static volatile uint32_t *rp1_reg = NULL;
+static int      rp1_fake = 0; // 1 if registers are in a plain buffer
+static uint32_t rp1_sio_table[16];
+static uint32_t rp1_saved_ctrl[RP1_NUM_PINS];
+static uint32_t rp1_saved_pads[RP1_NUM_PINS];
+//
+static void Rp1Emu_Write(uint32_t offset);
+static void Rp1Emu_Read(uint32_t offset);
+
+//------------------------------
+// Register Access
+//------------------------------
+static inline uint32_t RP1_Read(uint32_t offset)
+{
+    if (rp1_fake) Rp1Emu_Read(offset);
+    return rp1_reg[offset >> 2];
+}
+//
+static inline void RP1_Write(uint32_t offset, uint32_t value)
+{
+    rp1_reg[offset >> 2] = value;
+    if (rp1_fake) Rp1Emu_Write(offset);
+}
+
+//------------------------------
+// Wait until Writes Reach Pins
+//------------------------------
+static inline void RP1_Settle(void)
+{
+    int i;
+    //
+    __sync_synchronize();
+    for (i = 0; i < RP1_SETTLE_READS; i++) (void)RP1_Read(RP1_RIO_IN);
+}
+
+//------------------------------
+// Drive Open Drain Lines
+//     Lines in mask are released if the
+//     bit in high is 1, or driven Low.
+//------------------------------
+static inline void RP1_Drive(uint32_t mask, uint32_t high)
+{
+    RP1_Write(RP1_RIO_OE + RP1_CLR, mask & high);
+    RP1_Write(RP1_RIO_OE + RP1_SET, mask & ~high);
+    RP1_Settle();
+}
+
+//------------------------------
+// Pin Open (select RIO function)
+//------------------------------
+static void RP1_Pin_Open(int index)
+{
+    int pin = rp1_pins[index];
+    uint32_t pads;
+    //
+    rp1_saved_ctrl[index] = RP1_Read(RP1_GPIO_CTRL(pin));
+    rp1_saved_pads[index] = RP1_Read(RP1_PADS(pin));
+    //
+    RP1_Write(RP1_RIO_OE  + RP1_CLR, 1u << pin); // released
+    RP1_Write(RP1_RIO_OUT + RP1_CLR, 1u << pin); // Low when driven
+    pads = rp1_saved_pads[index] & ~(RP1_PADS_OD | RP1_PADS_PDE);
+    RP1_Write(RP1_PADS(pin), pads | RP1_PADS_IE | RP1_PADS_PUE);
+    RP1_Write(RP1_GPIO_CTRL(pin), (rp1_saved_ctrl[index] & ~RP1_FUNCSEL_MASK) | RP1_FUNCSEL_RIO);
+    RP1_Settle();
+}
+
+//------------------------------
+// Pin Close (restore function)
+//------------------------------
+static void RP1_Pin_Close(int index)
+{
+    int pin = rp1_pins[index];
+    //
+    RP1_Write(RP1_RIO_OE + RP1_CLR, 1u << pin);
+    RP1_Write(RP1_GPIO_CTRL(pin), rp1_saved_ctrl[index]);
+    RP1_Write(RP1_PADS(pin), rp1_saved_pads[index]);
+    RP1_Settle();
+}
+
+//------------------------------
+// Nibble to SIO Pin Mask
+//------------------------------
+static void RP1_Make_SIO_Table(void)
+{
+    int value, i;
+    //
+    for (value = 0; value < 16; value++)
+    {
+        rp1_sio_table[value] = 0;
+        for (i = 0; i < 4; i++)
+        {
+            if ((value >> i) & 0x01) rp1_sio_table[value] |= 1u << rp1_sio_pins[i];
+        }
+    }
+}
+
+//==============================
+// GPIO Backend
+//==============================
+
+//------------------------------
+// CHIP Open
+//------------------------------
+static void Rp1_CHIP_Open(void)
+{
+    int   fd;
+    void *map;
+    //
+    fd = open(RP1_GPIOMEM, O_RDWR | O_SYNC);
+    if (fd < 0)
+    {
+        fprintf(stderr, "======== ERROR: Can't open %s.\n", RP1_GPIOMEM);
+        exit(EXIT_FAILURE);
+    }
+    map = mmap(NULL, RP1_GPIOMEM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        fprintf(stderr, "======== ERROR: Can't map %s.\n", RP1_GPIOMEM);
+        exit(EXIT_FAILURE);
+    }
+    rp1_reg  = (volatile uint32_t *)map;
+    rp1_fake = 0;
+    RP1_Make_SIO_Table();
+}
+
+//------------------------------
+// CHIP Close
+//------------------------------
+static void Rp1_CHIP_Close(void)
+{
+    munmap((void *)rp1_reg, RP1_GPIOMEM_SIZE);
+    rp1_reg = NULL;
+}
+
+//------------------------------
+// RES_N
+//------------------------------
+static void Rp1_RESN_Init(void)
+{
+    RP1_Pin_Open(RP1_PIN_RESN);
+    RP1_Drive(RP1_MASK_RESN, 0); // default Low
+}
+//
+static void Rp1_RESN_CleanUp(void)
+{
+    RP1_Pin_Close(RP1_PIN_RESN);
+}
+//
+static void Rp1_RESN_Set_Value(int value)
+{
+    RP1_Drive(RP1_MASK_RESN, (value & 0x01)? RP1_MASK_RESN : 0);
+}
+
+//------------------------------
+// QSPI / SPI Initialization
+//     CS_N, SCK and SIO0-3, all released
+//------------------------------
+static void Rp1_QSPI_Init(void)
+{
+    int i;
+    //
+    for (i = RP1_PIN_BUS; i < RP1_NUM_PINS; i++) RP1_Pin_Open(i);
+}
+//
+static void Rp1_QSPI_CleanUp(void)
+{
+    int i;
+    //
+    for (i = RP1_PIN_BUS; i < RP1_NUM_PINS; i++) RP1_Pin_Close(i);
+}
+
+//----------------------------
+// Set Direction
+//     Input releases the lines.
+//----------------------------
+static void Rp1_Set_Direction(uint32_t mask, int direction)
+{
+    if (direction == 0) RP1_Drive(mask, mask);
+}
+static void Rp1_CS_N_Set_Direction(int direction) {Rp1_Set_Direction(RP1_MASK_CSN, direction);}
+static void Rp1_SCK_Set_Direction(int direction)  {Rp1_Set_Direction(RP1_MASK_SCK, direction);}
+static void Rp1_SIO_Set_Direction(int direction)  {Rp1_Set_Direction(RP1_MASK_SIO, direction);}
+static void Rp1_SI_Set_Direction(int direction)   {Rp1_Set_Direction(RP1_MASK_SI , direction);}
+
+//-----------------------------
+// Set Values
+//-----------------------------
+static void Rp1_BUS_Set_Value(int csn, int sck, int sio)
+{
+    uint32_t high;
+    //
+    high = rp1_sio_table[sio & 0x0f];
+    if (csn & 0x01) high |= RP1_MASK_CSN;
+    if (sck & 0x01) high |= RP1_MASK_SCK;
+    RP1_Drive(RP1_MASK_BUS, high);
+}
+//
+static void Rp1_CSN_Set_Value(int value)
+{
+    RP1_Drive(RP1_MASK_CSN, (value & 0x01)? RP1_MASK_CSN : 0);
+}
+//
+static void Rp1_SCK_Set_Value(int value)
+{
+    RP1_Drive(RP1_MASK_SCK, (value & 0x01)? RP1_MASK_SCK : 0);
+}
+//
+static void Rp1_SIO_Set_Value(int value)
+{
+    RP1_Drive(RP1_MASK_SIO, rp1_sio_table[value & 0x0f]);
+}
+//
+static void Rp1_SI_Set_Value(int value)
+{
+    RP1_Drive(RP1_MASK_SI, (value & 0x01)? RP1_MASK_SI : 0);
+}
+
+//-----------------------------
+// Get Values
+//-----------------------------
+static void Rp1_SIO_Get_Value(int *value)
+{
+    uint32_t in;
+    int i;
+    //
+    in = RP1_Read(RP1_RIO_IN);
+    *value = 0;
+    for (i = 0; i < 4; i++) *value |= ((in >> rp1_sio_pins[i]) & 0x01) << i;
+}
+//
+static void Rp1_SI_Get_Value(int *value)
+{
+    *value = (RP1_Read(RP1_RIO_IN) & RP1_MASK_SI)? 1 : 0;
+}
+
+//-----------------------------
+// RP1 Register Backend
+//-----------------------------
+const sGPIO_BACKEND GPIO_Backend_Rp1 =
+{
+    "rp1",
+    1,
+    Raspi_SysClk_Output,
+    Rp1_CHIP_Open,
+    Rp1_CHIP_Close,
+    Rp1_RESN_Init,
+    Rp1_RESN_CleanUp,
+    Rp1_QSPI_Init,
+    Rp1_QSPI_CleanUp,
+    Rp1_QSPI_Init,
+    Rp1_QSPI_CleanUp,
+    Rp1_CS_N_Set_Direction,
+    Rp1_SCK_Set_Direction,
+    Rp1_SIO_Set_Direction,
+    Rp1_SI_Set_Direction,
+    Rp1_RESN_Set_Value,
+    Rp1_CSN_Set_Value,
+    Rp1_SCK_Set_Value,
+    Rp1_SIO_Set_Value,
+    Rp1_SIO_Get_Value,
+    Rp1_SI_Set_Value,
+    Rp1_SI_Get_Value,
+    Rp1_BUS_Set_Value
+};
+
+//==============================
+// Fake Register File
+//     The same register sequences run on a plain
+//     buffer. After every write the atomic aliases
+//     are resolved as RP1 does, and the pin levels
+//     are applied to the 23LC512 emulator, which
+//     also gives RIO_IN. So the RIO, pad and
+//     function settings are checked without RP1.
+//==============================
+
+//------------------------------
+// Pin Level
+//------------------------------
+static int Rp1Emu_Level(int pin)
+{
+    uint32_t ctrl = rp1_reg[RP1_GPIO_CTRL(pin) >> 2];
+    uint32_t pads = rp1_reg[RP1_PADS(pin) >> 2];
+    int drive;
+    //
+    drive = ((ctrl & RP1_FUNCSEL_MASK) == RP1_FUNCSEL_RIO)
+         && ((pads & RP1_PADS_OD) == 0)
+         && ((rp1_reg[RP1_RIO_OE >> 2] >> pin) & 0x01);
+    if (drive) return (rp1_reg[RP1_RIO_OUT >> 2] >> pin) & 0x01;
+    return (pads & RP1_PADS_PUE)? 1 : 0;
+}
+
+//------------------------------
+// Register Written
+//------------------------------
+static void Rp1Emu_Write(uint32_t offset)
+{
+    uint32_t alias = offset & RP1_ALIAS;
+    uint32_t reg   = (offset & ~RP1_ALIAS) >> 2;
+    uint32_t value;
+    int csn, sck, sio, i;
+    //
+    // Atomic Access
+    if (alias)
+    {
+        value = rp1_reg[offset >> 2];
+        rp1_reg[offset >> 2] = 0;
+        if (alias == RP1_XOR) rp1_reg[reg] ^=  value;
+        if (alias == RP1_SET) rp1_reg[reg] |=  value;
+        if (alias == RP1_CLR) rp1_reg[reg] &= ~value;
+    }
+    //
+    // Pins to Emulator
+    csn = Rp1Emu_Level(rp1_pins[RP1_PIN_BUS + 0]);
+    sck = Rp1Emu_Level(rp1_pins[RP1_PIN_BUS + 1]);
+    sio = 0;
+    for (i = 0; i < 4; i++) sio |= Rp1Emu_Level(rp1_sio_pins[i]) << i;
+    GPIO_Backend_Emu.bus_set_value(csn, sck, sio);
+}
+
+//------------------------------
+// Register Read
+//------------------------------
+static void Rp1Emu_Read(uint32_t offset)
+{
+    uint32_t in = 0;
+    int sio, i, pin;
+    //
+    if (offset != RP1_RIO_IN) return;
+    //
+    GPIO_Backend_Emu.sio_get_value(&sio);
+    for (i = 0; i < RP1_NUM_PINS; i++)
+    {
+        pin = rp1_pins[i];
+        if ((rp1_reg[RP1_PADS(pin) >> 2] & RP1_PADS_IE) == 0) continue;
+        if (Rp1Emu_Level(pin)) in |= 1u << pin;
+    }
+    for (i = 0; i < 4; i++)
+    {
+        if (((sio >> i) & 0x01) == 0) in &= ~(1u << rp1_sio_pins[i]);
+    }
+    rp1_reg[RP1_RIO_IN >> 2] = in;
+}
+
+//------------------------------
+// CHIP Open / Close
+//     Registers at reset: NULL function,
+//     output disabled, pull-down.
+//------------------------------
+static void Rp1Emu_CHIP_Open(void)
+{
+    void *map;
+    int pin;
+    //
+    map = mmap(NULL, RP1_GPIOMEM_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED)
+    {
+        fprintf(stderr, "======== ERROR: Can't allocate RP1 fake registers.\n");
+        exit(EXIT_FAILURE);
+    }
+    rp1_reg  = (volatile uint32_t *)map;
+    rp1_fake = 1;
+    for (pin = 0; pin < 28; pin++)
+    {
+        rp1_reg[RP1_GPIO_CTRL(pin) >> 2] = RP1_FUNCSEL_NULL;
+        rp1_reg[RP1_PADS(pin) >> 2] = RP1_PADS_OD | RP1_PADS_IE | RP1_PADS_PDE;
+    }
+    RP1_Make_SIO_Table();
+    GPIO_Backend_Emu.chip_open();
+}
+//
+static void Rp1Emu_CHIP_Close(void)
+{
+    GPIO_Backend_Emu.chip_close();
+    Rp1_CHIP_Close();
+    rp1_fake = 0;
+}
+//
+static int Rp1Emu_SysClk_Output(int start) {return GPIO_Backend_Emu.sysclk_output(start);}
+
+//-----------------------------
+// RP1 Fake Register Backend
+//-----------------------------
+const sGPIO_BACKEND GPIO_Backend_Rp1Emu =
+{
+    "rp1emu",
+    0,
+    Rp1Emu_SysClk_Output,
+    Rp1Emu_CHIP_Open,
+    Rp1Emu_CHIP_Close,
+    Rp1_RESN_Init,
+    Rp1_RESN_CleanUp,
+    Rp1_QSPI_Init,
+    Rp1_QSPI_CleanUp,
+    Rp1_QSPI_Init,
+    Rp1_QSPI_CleanUp,
+    Rp1_CS_N_Set_Direction,
+    Rp1_SCK_Set_Direction,
+    Rp1_SIO_Set_Direction,
+    Rp1_SI_Set_Direction,
+    Rp1_RESN_Set_Value,
+    Rp1_CSN_Set_Value,
+    Rp1_SCK_Set_Value,
+    Rp1_SIO_Set_Value,
+    Rp1_SIO_Get_Value,
+    Rp1_SI_Set_Value,
+    Rp1_SI_Get_Value,
+    Rp1_BUS_Set_Value
+};
+
+//===========================================================
+// End of File
+//===========================================================
@@ -13,11 +13,100 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
-#include <gpiod.h>
 #include <math.h>
+#include <time.h>
 #include "raspi.h"
 #include "sram.h"
 #include "utility.h"
+//
+#define SRAM_PAGES (MAXROM / SRAM_PAGE_SIZE)
+
+//-----------------------------------------------------------
+// Bus Cycle
+//     CS_N, SCK and SIO[3:0] are driven together by one
+//     GPIO_BUS_Set_Value() call, so a nibble costs two pin
+//     operations (data with SCK low, then SCK rising edge)
+//     instead of three. Idle state is CS_N=1, SCK=1, SIO=0xf.
+//     In SPI mode, SI is SIO0 and SIO3 (HOLD_N) stays high.
+//-----------------------------------------------------------
+
+//------------------------
+// Start Bus Cycle
+//------------------------
+static void SRAM_Bus_Start(void)
+{
+    GPIO_BUS_Set_Value(1, 0, 0xf);
+}
+
+//------------------------
+// Stop Bus Cycle
+//------------------------
+static void SRAM_Bus_Stop(void)
+{
+    GPIO_BUS_Set_Value(1, 1, 0xf);
+}
+
+//------------------------
+// Output a Nibble
+//     (CS_N is asserted by the first one)
+//------------------------
+static void SRAM_Bus_Out(int nibble)
+{
+    GPIO_BUS_Set_Value(0, 0, nibble & 0x0f);
+    GPIO_BUS_Set_Value(0, 1, nibble & 0x0f);
+}
+
+//------------------------
+// Input a Nibble
+//     SRAM drives SIO after SCK falling edge.
+//------------------------
+static int SRAM_Bus_In(void)
+{
+    int value;
+    //
+    GPIO_BUS_Set_Value(0, 0, 0xf); // Open Drain Hi-Z
+    GPIO_BUS_Set_Value(0, 1, 0xf);
+    GPIO_SIO_Get_Value(&value);
+    return value & 0x0f;
+}
+
+//------------------------
+// Output a Byte
+//------------------------
+static void SRAM_Bus_Out_Byte(int byte)
+{
+    SRAM_Bus_Out((byte >> 4) & 0x0f);
+    SRAM_Bus_Out((byte >> 0) & 0x0f);
+}
+
+//------------------------
+// Input a Byte
+//------------------------
+static unsigned char SRAM_Bus_In_Byte(void)
+{
+    unsigned char byte;
+    //
+    byte = (unsigned char)(SRAM_Bus_In() << 4);
+    byte = byte | (unsigned char)SRAM_Bus_In();
+    return byte;
+}
+
+//------------------------
+// Command and Address
+//------------------------
+static void SRAM_Bus_Command(int cmd, int addr)
+{
+    SRAM_Bus_Start();
+    SRAM_Bus_Out_Byte(cmd);
+    SRAM_Bus_Out_Byte((addr >> 8) & 0xff);
+    SRAM_Bus_Out_Byte((addr >> 0) & 0xff);
+    if (cmd == SRAM_CMD_READ)
+    {
+        // Data Dummy
+        SRAM_Bus_Out(0xf);
+        SRAM_Bus_Out(0xf);
+    }
+}
 
 //---------------------------
 // SRAM Config as QSPI Mode
@@ -25,27 +114,17 @@
 void SRAM_Config_as_QSPI(void)
 {
     int i;
-    int cmd = 0x38;
+    int cmd = SRAM_CMD_EQIO;
     //
     SPI_Init();
     //
-	GPIO_SI_Set_Value(1);
-    GPIO_CSN_Set_Value(1);
-    GPIO_SCK_Set_Value(1);
-    //
-    GPIO_SCK_Set_Value(0);
-    GPIO_CSN_Set_Value(0);
-    //
+    SRAM_Bus_Stop();
+    SRAM_Bus_Start();
     for (i = 0; i < 8; i++)
     {
-	GPIO_SI_Set_Value((cmd >> (7-i)) & 0x01);
-	GPIO_SCK_Set_Value(1);
-	GPIO_SCK_Set_Value(0);
-    }    
-    //
-    GPIO_CSN_Set_Value(1);
-    GPIO_SCK_Set_Value(1);
-	GPIO_SI_Set_Value(1);
+        SRAM_Bus_Out(0xe | ((cmd >> (7-i)) & 0x01));
+    }
+    SRAM_Bus_Stop();
     //
     SPI_CleanUp();
 }
@@ -55,167 +134,141 @@ void SRAM_Config_as_QSPI(void)
 //---------------------------
 void SRAM_Reset_to_SPI(void)
 {
-    int i;
-    //
     QSPI_Init();
     //
-	GPIO_SIO_Set_Value(0xf);
-    GPIO_CSN_Set_Value(1);
-    GPIO_SCK_Set_Value(1);
-    //
-    GPIO_SCK_Set_Value(0);
-    GPIO_CSN_Set_Value(0);
-    //
-    for (i = 0; i < 2; i++)
-    {
-	GPIO_SIO_Set_Value(0xf);
-	GPIO_SCK_Set_Value(1);
-	GPIO_SCK_Set_Value(0);
-    }    
-    //
-    GPIO_CSN_Set_Value(1);
-    GPIO_SCK_Set_Value(1);
-	GPIO_SIO_Set_Value(0xf);
+    SRAM_Bus_Stop();
+    SRAM_Bus_Start();
+    SRAM_Bus_Out_Byte(SRAM_CMD_RSTIO);
+    SRAM_Bus_Stop();
     //
     QSPI_CleanUp();
 }
 
 //------------------------
-// SRAM Write Burst
+// SRAM Write Range
+//     rom[addr_start..addr_end] to the same address
 //------------------------
-void SRAM_Write_Burst(unsigned char *rom, int addr_max)
+void SRAM_Write_Range(unsigned char *rom, int addr_start, int addr_end)
 {
     int addr;
-    unsigned char byte;
-    //
-    // Assert CS_N
-    GPIO_SIO_Set_Value(0xf);
-    GPIO_SCK_Set_Value(0);
-    GPIO_CSN_Set_Value(0);
-    //
-    // Write Command    
-    GPIO_SIO_Set_Value(0x0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value(0x2);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //
-    // Address H
-    GPIO_SIO_Set_Value(0x0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value(0x0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
     //
-    // Address L
-    GPIO_SIO_Set_Value(0x0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value(0x0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //
-    // Data
-    for (addr = 0; addr <= addr_max; addr++)
+    SRAM_Bus_Command(SRAM_CMD_WRITE, addr_start);
+    for (addr = addr_start; addr <= addr_end; addr++)
     {
-        byte = rom[addr];
-        GPIO_SIO_Set_Value((byte >> 4) & 0x0f);
-        GPIO_SCK_Set_Value(1);
-        GPIO_SCK_Set_Value(0);
-        GPIO_SIO_Set_Value((byte >> 0) & 0x0f);
-        GPIO_SCK_Set_Value(1);
-        GPIO_SCK_Set_Value(0);
+        SRAM_Bus_Out_Byte(rom[addr]);
     }
-    //
-    // Negate CS_N
-    GPIO_CSN_Set_Value(1);
-    GPIO_SCK_Set_Value(1);
-	GPIO_SIO_Set_Value(0xf);
+    SRAM_Bus_Stop();
 }
 
 //------------------------
-// SRAM Read Burst
+// SRAM Read Range
+//     to rom[addr_start..addr_end]
+//     If expect is given, each byte is compared on
+//     the fly and the burst stops at the first
+//     mismatch. Returns its address, or -1.
 //------------------------
-void SRAM_Read_Burst(unsigned char *rom, int addr_max)
+int SRAM_Read_Range(unsigned char *rom, int addr_start, int addr_end, const unsigned char *expect)
 {
     int addr;
-    int value;
-    unsigned char byte;
-    //
-    // Assert CS_N
-    GPIO_SIO_Set_Value(0xf);
-    GPIO_SCK_Set_Value(0);
-    GPIO_CSN_Set_Value(0);
-    //
-    // Read Command    
-    GPIO_SIO_Set_Value(0x0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value(0x3);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
+    int bad = -1;
     //
-    // Address H
-    GPIO_SIO_Set_Value(0x0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value(0x0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //
-    // Address L
-    GPIO_SIO_Set_Value(0x0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value(0x0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //
-    // Data Dummy
-    GPIO_SIO_Set_Value(0xf); // Open Drain Hi-Z
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //    
-    // Data    
-    for (addr = 0; addr <= addr_max; addr++)
+    SRAM_Bus_Command(SRAM_CMD_READ, addr_start);
+    for (addr = addr_start; addr <= addr_end; addr++)
     {
-        GPIO_SCK_Set_Value(1);
-        GPIO_SIO_Get_Value(&value);
-        byte = ((unsigned char)value & 0x0f) << 4;
-        GPIO_SCK_Set_Value(0);
-        GPIO_SCK_Set_Value(1);
-        GPIO_SIO_Get_Value(&value);
-        byte = byte | ((unsigned char)value & 0x0f) << 0;
-        GPIO_SCK_Set_Value(0);
-        rom[addr] = byte;
+        rom[addr] = SRAM_Bus_In_Byte();
+        if ((expect != NULL) && (rom[addr] != expect[addr]))
+        {
+            bad = addr;
+            break;
+        }
     }
-    //
-    // Negate CS_N
-    GPIO_CSN_Set_Value(1);
-    GPIO_SCK_Set_Value(1);
-	GPIO_SIO_Set_Value(0xf);
+    SRAM_Bus_Stop();
+    return bad;
+}
+
+//------------------------
+// SRAM Write Burst
+//------------------------
+void SRAM_Write_Burst(unsigned char *rom, int addr_max)
+{
+    SRAM_Write_Range(rom, 0x0000, addr_max);
+}
+
+//------------------------
+// SRAM Read Burst
+//------------------------
+int SRAM_Read_Burst(unsigned char *rom, int addr_max, const unsigned char *expect)
+{
+    return SRAM_Read_Range(rom, 0x0000, addr_max, expect);
 }
 
 //---------------------------
 // SRAM Verify
+//     Reads back the pages marked in pages[] (all
+//     pages if NULL) and compares them with rom_src.
+//         SRAM_VERIFY_FULL   : every page
+//         SRAM_VERIFY_SAMPLE : first and last page, and
+//                              SRAM_VERIFY_SAMPLES pages
+//                              at random
+//         SRAM_VERIFY_NONE   : no page
+//     Returns the first bad address, or -1.
+//     *bytes is the number of bytes read.
 //---------------------------
-int SRAM_Verify(unsigned char *rom_src, unsigned char *rom_dst, int addr_max)
+int SRAM_Verify(const unsigned char *rom_src, unsigned char *rom_dst, int addr_max,
+    int level, const char *pages, int *bytes)
 {
-    int result;
-    int addr;
-    //
-    result = 0;
-    for (addr = 0; addr <= addr_max; addr++)
+    char check[SRAM_PAGES];
+    int  cand[SRAM_PAGES];
+    int  num = addr_max / SRAM_PAGE_SIZE + 1;
+    int  page, first, start, end, bad;
+    int  ncand, rest, pick, i;
+    //
+    *bytes = 0;
+    if (level == SRAM_VERIFY_NONE) return -1;
+    for (page = 0; page < num; page++) check[page] = (pages == NULL) || pages[page];
+    //
+    // Sampled Pages
+    if (level == SRAM_VERIFY_SAMPLE)
     {
-        if (rom_src[addr] != rom_dst[addr]) result = 1;
-        DEBUG_printf(DEBUG_MID, "0x%02x 0x%02x 0x%02x\n", addr, rom_src[addr], rom_dst[addr]);
+        ncand = 0;
+        for (page = 0; page < num; page++)
+        {
+            if (check[page]) cand[ncand++] = page;
+            check[page] = 0;
+        }
+        if (ncand > 0)
+        {
+            check[cand[0]] = 1;
+            check[cand[ncand - 1]] = 1;
+        }
+        srand((unsigned int)time(NULL) ^ (unsigned int)getpid());
+        for (rest = ncand - 2, i = 0; (i < SRAM_VERIFY_SAMPLES) && (rest > 0); i++, rest--)
+        {
+            pick = 1 + rand() % rest;
+            check[cand[pick]] = 1;
+            cand[pick] = cand[rest];
+        }
     }
     //
-    return result;
+    // Read Runs of Pages
+    page = 0;
+    while (page < num)
+    {
+        if (check[page] == 0) {page++; continue;}
+        first = page;
+        while ((page < num) && check[page]) page++;
+        start = first * SRAM_PAGE_SIZE;
+        end   = page * SRAM_PAGE_SIZE - 1;
+        if (end > addr_max) end = addr_max;
+        bad = SRAM_Read_Range(rom_dst, start, end, rom_src);
+        if (bad >= 0)
+        {
+            *bytes += bad - start + 1;
+            return bad;
+        }
+        *bytes += end - start + 1;
+    }
+    return -1;
 }
 
 //------------------------
@@ -223,48 +276,9 @@ int SRAM_Verify(unsigned char *rom_src, unsigned char *rom_dst, int addr_max)
 //------------------------
 void SRAM_Write_Byte(int addr, unsigned char byte)
 {
-    //
-    // Assert CS_N
-    GPIO_SIO_Set_Value(0xf);
-    GPIO_SCK_Set_Value(0);
-    GPIO_CSN_Set_Value(0);
-    //
-    // Write Command    
-    GPIO_SIO_Set_Value(0x0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value(0x2);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //
-    // Address H
-    GPIO_SIO_Set_Value((addr >> 12) & 0x0f);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value((addr >>  8) & 0x0f);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //
-    // Address L
-    GPIO_SIO_Set_Value((addr >>  4) & 0x0f);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value((addr >>  0) & 0x0f);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //
-    // Data
-    GPIO_SIO_Set_Value((byte >> 4) & 0x0f);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value((byte >> 0) & 0x0f);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //
-    // Negate CS_N
-    GPIO_CSN_Set_Value(1);
-    GPIO_SCK_Set_Value(1);
-	GPIO_SIO_Set_Value(0xf);
+    SRAM_Bus_Command(SRAM_CMD_WRITE, addr);
+    SRAM_Bus_Out_Byte(byte);
+    SRAM_Bus_Stop();
 }
 
 //------------------------
@@ -272,89 +286,24 @@ void SRAM_Write_Byte(int addr, unsigned char byte)
 //------------------------
 void SRAM_Read_Byte(int addr, unsigned char *byte)
 {
-    int value;
-    //
-    // Assert CS_N
-    GPIO_SIO_Set_Value(0xf);
-    GPIO_SCK_Set_Value(0);
-    GPIO_CSN_Set_Value(0);
-    //
-    // Read Command    
-    GPIO_SIO_Set_Value(0x0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value(0x3);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //
-    // Address H
-    GPIO_SIO_Set_Value((addr >> 12) & 0x0f);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value((addr >>  8) & 0x0f);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //
-    // Address L
-    GPIO_SIO_Set_Value((addr >>  4) & 0x0f);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SIO_Set_Value((addr >>  0) & 0x0f);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //
-    // Data Dummy
-    GPIO_SIO_Set_Value(0xf); // Open Drain Hi-Z
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SCK_Set_Value(0);
-    //    
-    // Data    
-    GPIO_SCK_Set_Value(1);
-    GPIO_SIO_Get_Value(&value);
-    *byte = ((unsigned char)value & 0x0f) << 4;
-    GPIO_SCK_Set_Value(0);
-    GPIO_SCK_Set_Value(1);
-    GPIO_SIO_Get_Value(&value);
-    *byte = *byte | ((unsigned char)value & 0x0f) << 0;
-    GPIO_SCK_Set_Value(0);
-    //
-    // Negate CS_N
-    GPIO_CSN_Set_Value(1);
-    GPIO_SCK_Set_Value(1);
-	GPIO_SIO_Set_Value(0xf);
+    SRAM_Bus_Command(SRAM_CMD_READ, addr);
+    *byte = SRAM_Bus_In_Byte();
+    SRAM_Bus_Stop();
 }
 
 //------------------------------
 // SRAM Set Baud Rate Data
+//     div0 and div1 of the UART are
+//     at the top of RAM (see baud.h).
 //------------------------------
-int SRAM_Set_BaudRate_Data(int freq)
+int SRAM_Set_BaudRate_Data(const sBAUD *psBAUD)
 {
-    // BaudRate = (fclk/4) / ((div0+2)*(div1))
-    //     clk=10MHz, 115200bps
-    //     115200*4=460800
-    //     10MHz/460800Hz=22=11*2
-    //     div0=9 (11-2) , div1=2
-    //
-    // div1 = 2, fixed
-    // BaudRate = (fclk/4) / ((div0+2)*div1)
-    // div0 = fclk/BaudRate/div1/4 - 2
-    // if 115200bps, fclk=10MHz, div1=2 then div0 = 9
-    double dFreq, dBaud, dDiv0, dDiv1;
     unsigned char div0, div1;
     unsigned char byte0, byte1;
     int result;
     //
-    dFreq = (double)freq;
-    dBaud = 115200.0;
-    dDiv1 = 2.0;
-    dDiv0 = dFreq / dBaud / dDiv1 / 4.0 - 2.0;
-    div0 = (unsigned char)round(dDiv0);
-    div1 = (unsigned char)round(dDiv1);
-    printf("(Freq=%d Baud=%d div0=%d div1=%d)...",
-        freq, (int)dBaud, div0, div1);
-    //
+    div0 = (unsigned char)psBAUD->div0;
+    div1 = (unsigned char)psBAUD->div1;
     SRAM_Write_Byte(0x0fffe, div0);
     SRAM_Write_Byte(0x0ffff, div1);
     SRAM_Read_Byte(0x0fffe, &byte0);
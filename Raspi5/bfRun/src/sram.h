@@ -10,20 +10,45 @@
 // Copyright (C) 2025-2026 M.Maruyama
 //===========================================================
 
+#include "baud.h"
+
 #ifndef __QSPI_H__
 #define __QSPI_H__
 
+//-------------------------------
+// 23LC512 Instructions
+//-------------------------------
+#define SRAM_CMD_READ  0x03
+#define SRAM_CMD_WRITE 0x02
+#define SRAM_CMD_EQIO  0x38
+#define SRAM_CMD_RSTIO 0xff
+//
+#define SRAM_PAGE_SIZE 32 // bytes
+//
+// Address Map (ROM in the lower half, RAM in the upper half)
+#define SRAM_SIZE      65536
+#define SRAM_DATA_BASE 0x8000
+
+//-------------------------------
+// Verify Level
+//-------------------------------
+enum SRAM_VERIFY {SRAM_VERIFY_FULL, SRAM_VERIFY_SAMPLE, SRAM_VERIFY_NONE};
+#define SRAM_VERIFY_SAMPLES 8 // random pages in SRAM_VERIFY_SAMPLE
+
 //-------------------------------
 // Prototypes
 //-------------------------------
 void SRAM_Config_as_QSPI(void);
 void SRAM_Reset_to_SPI(void);
+void SRAM_Write_Range(unsigned char *rom, int addr_start, int addr_end);
+int  SRAM_Read_Range(unsigned char *rom, int addr_start, int addr_end, const unsigned char *expect);
 void SRAM_Write_Burst(unsigned char *rom, int addr_max);
-void SRAM_Read_Burst(unsigned char *rom, int addr_max);
-int SRAM_Verify(unsigned char *rom_src, unsigned char *rom_dst, int addr_max);
+int  SRAM_Read_Burst(unsigned char *rom, int addr_max, const unsigned char *expect);
+int  SRAM_Verify(const unsigned char *rom_src, unsigned char *rom_dst, int addr_max,
+    int level, const char *pages, int *bytes);
 void SRAM_Write_Byte(int addr, unsigned char byte);
 void SRAM_Read_Byte(int addr, unsigned char *byte);
-int  SRAM_Set_BaudRate_Data(int freq);
+int  SRAM_Set_BaudRate_Data(const sBAUD *psBAUD);
 
 #endif
 //===========================================================
@@ -20,8 +20,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
+#include <time.h>
 //
+#include "binfile.h"
 #include "defines.h"
+#include "hexfile.h"
+#include "mapfile.h"
 #include "utility.h"
 
 //-------------
@@ -54,142 +58,148 @@ void DEBUG_printf(uint32_t debug_level, const char *format, ...)
     }
 }
 
-//-----------------------------------------
-// Get Inpur File as String
-//-----------------------------------------
-char* Get_InputFile_as_String(sOPTION *psOPTION)
+//--------------------------------
+// Get Time in Seconds (Monotonic)
+//--------------------------------
+double Get_Time(void)
 {
-    char *str_src;
-    FILE *fp_src;
-    char fname_src[MAXLEN_WORD];
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+}
+
+//----------------------------------
+// Read Hex Image
+//     Decodes Intel Hex text already read
+//     from the Input File.
+//----------------------------------
+int Read_Hex_Image(unsigned char *rom, const unsigned char *buf, uint64_t len)
+{
+    sHEX_INFO info;
+    int result;
+    //
+    // Clear ROM
+    memset(rom, (CODE_NOP << 4) | CODE_NOP, MAXROM);
     //
-    // Open the File
-    strncpy(fname_src, psOPTION->input_file_name, MAXLEN_WORD);
-    fp_src = fopen(fname_src, "r");
-    if (fp_src == NULL)
+    // Read Intel Hex Format
+    result = HEX_Read_Buffer(buf, len, rom, MAXROM, &info);
+    if (result != HEX_OK)
     {
-        fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", fname_src);
+        fprintf(stderr, "======== ERROR: %s at line %d, column %d\n",
+            HEX_Error_String(result), info.line, info.column);
         exit(EXIT_FAILURE);
     }
     //
-    // Get the File Size
-    fseek(fp_src, 0, SEEK_END);
-    int size = ftell(fp_src);
-    rewind(fp_src);
+    return (int)info.addr_max;
+}
+
+//----------------------------------
+// Read Object File (Binary or Hex)
+//     Data Preload in a Binary File is
+//     stored in ram (MAXRAM bytes), and
+//     its last address in *ram_max
+//     (-1 if none).
+//----------------------------------
+int Read_Object_File(unsigned char *rom, unsigned char *ram, int *ram_max, char *fname)
+{
+    sBINFILE bin;
+    int result;
+    //
+    memset(ram, 0, MAXRAM);
+    *ram_max = -1;
     //
-    // Allocate Memory
-    str_src = malloc(sizeof(uint8_t) * (size + 1)); // +1 is a Terminate Null Character
-    if (str_src == NULL)
+    // Binary Object File?
+    result = BIN_Open(&bin, fname);
+    if (result == BIN_ERR_MAGIC)
+    {
+        result = Read_Hex_Image(rom, bin.map.data, bin.map.size);
+        BIN_Close(&bin);
+        return result;
+    }
+    if (result == BIN_ERR_OPEN)
+    {
+        fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", fname);
+        exit(EXIT_FAILURE);
+    }
+    if (result != BIN_OK)
     {
-        fprintf(stderr, "======== ERROR: Memory Allocation Error.\n");
+        fprintf(stderr, "======== ERROR: %s\n", BIN_Error_String(result));
+        exit(EXIT_FAILURE);
+    }
+    if ((bin.code_size == 0) || (bin.code_size > MAXROM))
+    {
+        fprintf(stderr, "======== ERROR: Binary File Overflows ROM Size\n");
+        exit(EXIT_FAILURE);
+    }
+    if (bin.entry != 0)    fprintf(stderr, "Entry Point 0x%04x is ignored, bfCPU starts from 0x0000.\n", bin.entry);
+    if ((uint64_t)bin.data_addr + bin.data_size > (uint64_t)RAM_BAUD_ADDR)
+    {
+        fprintf(stderr, "======== ERROR: Data Preload Overflows RAM Size\n");
         exit(EXIT_FAILURE);
     }
     //
-    // Read the File
-    fread(str_src, 1, size, fp_src);
-    str_src[size] = '\0';
+    // Copy Code as it is (same packing as SRAM)
+    memset(rom, (CODE_NOP << 4) | CODE_NOP, MAXROM);
+    memcpy(rom, bin.code, bin.code_size);
+    result = (int)bin.code_size - 1;
     //
-    // Close the File
-    fclose(fp_src);
+    // Data Preload
+    if (bin.data_size > 0)
+    {
+        memcpy(ram + bin.data_addr, bin.data, bin.data_size);
+        *ram_max = (int)(bin.data_addr + bin.data_size) - 1;
+    }
+    BIN_Close(&bin);
     //
-    // Retuen Result
-    return str_src;
+    return result;
 }
 
 //----------------------------------
-// Read Hex File
+// Read Preload File (Raw Data)
+//     Stored from RAM address 0.
+//     Returns the last address (-1 if empty).
 //----------------------------------
-int Read_Hex_File(unsigned char *rom, char *obj_str)
+int Read_Preload_File(unsigned char *ram, char *fname)
 {
-    char *pline;
-    int  bytecount;
-    int  checksum;
-    int  checksum2;
-    int  addr;
-    int  addr_bgn;
-    int  data;
-    int  error;
-    char str[MAXLEN_WORD];
-    int  addr_max;
+    sMAPFILE map;
+    int result;
     //
-    // Clear ROM
-    for (addr = 0; addr < MAXROM; addr++) rom[addr] = (CODE_NOP << 4) | CODE_NOP;
-    addr_max = 0;
-    //
-    // Read Intel Hex Format
-    error = 0;
-    pline = obj_str;
-    while(1)
+    if (MAP_File_Open(&map, fname))
     {
-        // Start Code
-        if (*pline++ != ':') {error = 1; break;}
-        // Byte Count
-        str[0] = *pline++;
-        str[1] = *pline++;
-        str[2] = '\0';
-        if (sscanf(str, "%02X", (int*)&bytecount) == EOF) {error = 1; break;}
-        checksum = bytecount;
-        // Address
-        str[0] = *pline++;
-        str[1] = *pline++;
-        str[2] = *pline++;
-        str[3] = *pline++;
-        str[4] = '\0';
-        if (sscanf(str, "%04X", (int*)&addr_bgn) == EOF) {error = 1; break;}
-        checksum = checksum + (addr_bgn >> 8) + (addr_bgn & 0x00ff);
-        // Record Type
-        str[0] = *pline++;
-        str[1] = *pline++;
-        str[2] = '\0';
-        if (strcmp(str, "01") == 0) break; // End of Record
-        if (strcmp(str, "00") != 0) {error = 1; break;} // Unsupported Record
-        // Data Record
-        for (addr = addr_bgn; addr < (addr_bgn + bytecount); addr++)
-        {
-            str[0] = *pline++;
-            str[1] = *pline++;
-            str[2] = '\0';
-            if (sscanf(str, "%02X", (int*)&data) == EOF) {error = 1; break;}
-            if ((addr * 2 + 1) >= MAXROM) {error = 2; break;}
-            rom[addr] = data;
-            addr_max = (addr > addr_max)? addr : addr_max;
-            checksum = checksum + data;
-        }
-        if (error) break;
-        // Check Sum        
-        str[0] = *pline++;
-        str[1] = *pline++;
-        str[2] = '\0';
-        if (sscanf(str, "%02X", (int*)&checksum2) == EOF) {error = 1; break;}
-        checksum = (0 - checksum) & 0x00ff;
-        if (checksum != checksum2) {error = 3; break;}
-        // End of Line
-        while(1)
-        {
-                 if (*pline == '\n') pline++;
-            else if (*pline == '\r') pline++;
-            else                     break;
-        }
-        // End of String
-        if (*pline == '\0') break;
-    }
-    if (error == 1)
-    {
-        fprintf(stderr, "======== ERROR: Hex File Format Error\n");
+        fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", fname);
         exit(EXIT_FAILURE);
     }
-    if (error == 2)
+    if (map.size > (size_t)RAM_BAUD_ADDR)
     {
-        fprintf(stderr, "======== ERROR: Hex File Overflows ROM Size\n");
+        fprintf(stderr, "======== ERROR: Data Preload Overflows RAM Size\n");
         exit(EXIT_FAILURE);
     }
-    if (error == 3)
+    memcpy(ram, map.data, map.size);
+    result = (int)map.size - 1;
+    MAP_File_Close(&map);
+    //
+    return result;
+}
+
+//----------------------------------
+// Write Dump File (Raw Data)
+//     Returns 0 if written.
+//----------------------------------
+int Write_Dump_File(const unsigned char *ram, int size, char *fname)
+{
+    FILE *fp;
+    int result;
+    //
+    if ((fp = fopen(fname, "wb")) == NULL)
     {
-        fprintf(stderr, "======== ERROR: Hex File Check Sum Unmatched\n");
-        exit(EXIT_FAILURE);
+        fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", fname);
+        return 1;
     }
+    result = (fwrite(ram, 1, size, fp) == (size_t)size)? 0 : 1;
+    if (fclose(fp) != 0) result = 1;
+    if (result) fprintf(stderr, "======== ERROR: Can't write \"%s\".\n", fname);
     //
-    return addr_max;
+    return result;
 }
 
 //===========================================================
@@ -21,8 +21,11 @@
 //-------------------------------
 void Interrupt_Handler(int dummy);
 void DEBUG_printf(uint32_t debug_level, const char *format, ...);
-char* Get_InputFile_as_String(sOPTION *psOPTION);
-int  Read_Hex_File(unsigned char *rom, char *obj_str);
+double Get_Time(void);
+int  Read_Hex_Image(unsigned char *rom, const unsigned char *buf, uint64_t len);
+int  Read_Object_File(unsigned char *rom, unsigned char *ram, int *ram_max, char *fname);
+int  Read_Preload_File(unsigned char *ram, char *fname);
+int  Write_Dump_File(const unsigned char *ram, int size, char *fname);
 
 #endif 
 //===========================================================
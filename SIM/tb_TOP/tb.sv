@@ -77,6 +77,22 @@ begin
         end
     end
 end
+//
+`ifdef TRACE_CYCLE
+// Cycle Trace to be compared with bfTool --cycle=sim --log
+always @(posedge clk)
+begin
+    if (~res & (tb_cycle_counter < `TB_FINISH_COUNT))
+        $display("CYC %0d S=%h%h PC=%h PTR=%h B=%b%b %h %h %h %b Q=%h%h T=%b%b",
+            tb_cycle_counter,
+            U_FPGA.U_TOP.U_CPU.state, U_FPGA.U_TOP.U_CPU.seq,
+            U_FPGA.U_TOP.U_CPU.pc, U_FPGA.U_TOP.U_CPU.ptr,
+            U_FPGA.U_TOP.bus_req, U_FPGA.U_TOP.bus_write, U_FPGA.U_TOP.bus_addr,
+            U_FPGA.U_TOP.bus_wdata, U_FPGA.U_TOP.bus_rdata, U_FPGA.U_TOP.bus_rdy,
+            U_FPGA.U_TOP.U_RAM.state, U_FPGA.U_TOP.U_RAM.seq,
+            uart_txd, uart_rxd);
+end
+`endif
 
 //---------------------
 // Initialize RAM
@@ -99,6 +115,11 @@ begin
     // UART Baud Rate (115200bps)
   //U_M23LC512.MemoryBlock[32768+32766] = 8'h09; // DIV0
   //U_M23LC512.MemoryBlock[32768+32767] = 8'h02; // DIV1
+    //
+`ifdef COSIM
+    // Lockstep Co-Simulation with bfTool Model (bfcosim.vpi)
+    $bfcosim(U_M23LC512.MemoryBlock, U_FPGA.U_TOP.U_CPU);
+`endif
 end
 
 //---------------------
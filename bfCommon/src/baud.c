@@ -0,0 +1,102 @@
+//===========================================================
+// bfCPU Common Library
+//-----------------------------------------------------------
+// File Name   : baud.c
+// Description : UART Baud Rate Calculator
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include "baud.h"
+
+//-------------------------
+// Standard Baud Rates
+//-------------------------
+const int BAUD_Standard[] =
+{
+    9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600, 0
+};
+
+//------------------------------
+// Actual Baud Rate
+//------------------------------
+double BAUD_Rate(double freq, int div0, int div1)
+{
+    return freq / 4.0 / (double)((div0 + 2) * div1);
+}
+
+//------------------------------
+// Search Divider Pair
+//     Finds (div0, div1) with the
+//     lowest error from target,
+//     preferring larger div1 as in
+//     the example of sasc_brg.v.
+//     For each div1, only the two
+//     div0 around the ideal one
+//     need to be tried.
+//     Returns 0 if the error is
+//     within BAUD_ERROR_MAX.
+//------------------------------
+int BAUD_Search(double freq, double target, sBAUD *psBAUD)
+{
+    double ideal, baud, error, best;
+    int div0, div1, i;
+    //
+    best = -1.0;
+    for (div1 = BAUD_DIV1_MAX; div1 >= BAUD_DIV1_MIN; div1--)
+    {
+        ideal = freq / 4.0 / target / (double)div1 - 2.0;
+        for (i = 0; i < 2; i++)
+        {
+            div0 = (int)ideal + i;
+            if ((div0 < BAUD_DIV0_MIN) || (div0 > BAUD_DIV0_MAX)) continue;
+            baud  = BAUD_Rate(freq, div0, div1);
+            error = (baud - target) / target * 100.0;
+            if ((best < 0.0) || ((error < 0.0)? -error : error) < best)
+            {
+                best = (error < 0.0)? -error : error;
+                psBAUD->div0  = div0;
+                psBAUD->div1  = div1;
+                psBAUD->baud  = baud;
+                psBAUD->error = error;
+            }
+        }
+    }
+    return ((best >= 0.0) && (best <= BAUD_ERROR_MAX))? 0 : 1;
+}
+
+//------------------------------
+// Highest Standard Baud Rate
+//     within BAUD_ERROR_MAX
+//     Returns the rate, or 0 if none.
+//------------------------------
+int BAUD_Highest(double freq, sBAUD *psBAUD)
+{
+    sBAUD baud;
+    int i, rate = 0;
+    //
+    for (i = 0; BAUD_Standard[i] != 0; i++)
+    {
+        if (BAUD_Search(freq, (double)BAUD_Standard[i], &baud) == 0)
+        {
+            rate = BAUD_Standard[i];
+            *psBAUD = baud;
+        }
+    }
+    return rate;
+}
+
+//------------------------------
+// Time to Transfer Bytes [s]
+//------------------------------
+double BAUD_Time(const sBAUD *psBAUD, double bytes)
+{
+    return bytes * BAUD_BITS / psBAUD->baud;
+}
+
+//===========================================================
+// End of File
+//===========================================================
@@ -0,0 +1,58 @@
+//===========================================================
+// bfCPU Common Library
+//-----------------------------------------------------------
+// File Name   : baud.h
+// Description : UART Baud Rate Calculator Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#ifndef __BAUD_H__
+#define __BAUD_H__
+
+//-----------------------------------------------------------
+// Baud Rate Generator of RTL/UART (sasc_brg.v)
+//     Baud Rate = (fCLK/4) / ((div0+2) * div1)
+//     div0 : 1..255 (prescaler, cycles less two)
+//     div1 : 1..255 (cycles of prescaler)
+//     div0=0 is not used, because its prescaler tick is
+//     lost at the clear of the second stage.
+//-----------------------------------------------------------
+#define BAUD_DIV0_MIN  1
+#define BAUD_DIV0_MAX  255
+#define BAUD_DIV1_MIN  1
+#define BAUD_DIV1_MAX  255
+#define BAUD_ERROR_MAX 2.0 // %, accepted by UART receivers
+#define BAUD_BITS      10  // bits per byte (start, 8 data, stop)
+
+//-----------------------------------
+// Divider Setting
+//-----------------------------------
+typedef struct
+{
+    int    div0;
+    int    div1;
+    double baud;  // actual baud rate
+    double error; // % from target
+} sBAUD;
+
+//-----------------------------------
+// Standard Baud Rates (0 terminated)
+//-----------------------------------
+extern const int BAUD_Standard[];
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+double BAUD_Rate(double freq, int div0, int div1);
+int    BAUD_Search(double freq, double target, sBAUD *psBAUD);
+int    BAUD_Highest(double freq, sBAUD *psBAUD);
+double BAUD_Time(const sBAUD *psBAUD, double bytes);
+
+#endif
+//===========================================================
+// End of File
+//===========================================================
@@ -0,0 +1,203 @@
+//===========================================================
+// bfCPU Common Library
+//-----------------------------------------------------------
+// File Name   : binfile.c
+// Description : Packed Binary Object File Routine
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+//
+#include "binfile.h"
+#include "mapfile.h"
+
+//----------------------------------------------------
+// CRC32 Table (IEEE 802.3, reflected)
+//----------------------------------------------------
+static uint32_t crc32_table[256];
+static int      crc32_table_ready = 0;
+
+static void CRC32_Make_Table(void)
+{
+    uint32_t c;
+    int n, k;
+    //
+    for (n = 0; n < 256; n++)
+    {
+        c = (uint32_t)n;
+        for (k = 0; k < 8; k++) c = (c & 1)? (0xedb88320UL ^ (c >> 1)) : (c >> 1);
+        crc32_table[n] = c;
+    }
+    crc32_table_ready = 1;
+}
+
+//----------------------------------------------------
+// CRC32 (pass 0 as initial crc)
+//----------------------------------------------------
+uint32_t BIN_CRC32(uint32_t crc, const unsigned char *buf, size_t len)
+{
+    size_t i;
+    //
+    if (crc32_table_ready == 0) CRC32_Make_Table();
+    crc = crc ^ 0xffffffffUL;
+    for (i = 0; i < len; i++) crc = crc32_table[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
+    return crc ^ 0xffffffffUL;
+}
+
+//----------------------------------------------------
+// Little Endian Access
+//----------------------------------------------------
+static uint32_t Get_LE16(const unsigned char *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t Get_LE32(const unsigned char *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void Set_LE16(unsigned char *p, uint32_t value)
+{
+    p[0] = (unsigned char)(value >> 0);
+    p[1] = (unsigned char)(value >> 8);
+}
+
+static void Set_LE32(unsigned char *p, uint32_t value)
+{
+    p[0] = (unsigned char)(value >>  0);
+    p[1] = (unsigned char)(value >>  8);
+    p[2] = (unsigned char)(value >> 16);
+    p[3] = (unsigned char)(value >> 24);
+}
+
+//----------------------------------------------------
+// Error String
+//----------------------------------------------------
+const char *BIN_Error_String(int result)
+{
+    switch(result)
+    {
+        case BIN_OK          : return "No Error";
+        case BIN_ERR_OPEN    : return "Can't Open Binary File";
+        case BIN_ERR_MAGIC   : return "Not a bfCPU Binary File";
+        case BIN_ERR_VERSION : return "Binary File Unsupported Version";
+        case BIN_ERR_SIZE    : return "Binary File Size Unmatched";
+        case BIN_ERR_CRC     : return "Binary File CRC32 Unmatched";
+        case BIN_ERR_WRITE   : return "Can't Write Binary File";
+        default              : return "Binary File Unknown Error";
+    }
+}
+
+//----------------------------------------------------
+// Open Binary Object File
+//     Maps the file and verifies its header and CRC.
+//     Code and Data point into the mapping until
+//     BIN_Close() is called.
+//     On BIN_ERR_MAGIC the file stays mapped so that
+//     the caller can decode it in another format
+//     (a pipe can be read only once), and the caller
+//     has to call BIN_Close() afterwards.
+//----------------------------------------------------
+int BIN_Open(sBINFILE *psBIN, const char *fname)
+{
+    const unsigned char *p;
+    uint32_t header_size;
+    uint64_t total;
+    //
+    memset(psBIN, 0, sizeof(sBINFILE));
+    if (MAP_File_Open(&psBIN->map, fname)) return BIN_ERR_OPEN;
+    p = psBIN->map.data;
+    //
+    // Header
+    if ((psBIN->map.size < BIN_HEADER_SIZE) || (memcmp(p, BIN_MAGIC, 4) != 0))
+    {
+        return BIN_ERR_MAGIC;
+    }
+    psBIN->version   = Get_LE16(p +  4);
+    header_size      = Get_LE16(p +  6);
+    psBIN->code_size = Get_LE32(p +  8);
+    psBIN->entry     = Get_LE32(p + 12);
+    psBIN->data_addr = Get_LE32(p + 16);
+    psBIN->data_size = Get_LE32(p + 20);
+    psBIN->crc32     = Get_LE32(p + 24);
+    if ((psBIN->version != BIN_VERSION) || (header_size < BIN_HEADER_SIZE))
+    {
+        BIN_Close(psBIN);
+        return BIN_ERR_VERSION;
+    }
+    //
+    // Payload
+    total = (uint64_t)header_size + psBIN->code_size + psBIN->data_size;
+    if (total != (uint64_t)psBIN->map.size)
+    {
+        BIN_Close(psBIN);
+        return BIN_ERR_SIZE;
+    }
+    psBIN->code = p + header_size;
+    psBIN->data = psBIN->code + psBIN->code_size;
+    if (BIN_CRC32(0, psBIN->code, (size_t)psBIN->code_size + psBIN->data_size) != psBIN->crc32)
+    {
+        BIN_Close(psBIN);
+        return BIN_ERR_CRC;
+    }
+    return BIN_OK;
+}
+
+//----------------------------------------------------
+// Close Binary Object File
+//----------------------------------------------------
+void BIN_Close(sBINFILE *psBIN)
+{
+    MAP_File_Close(&psBIN->map);
+    psBIN->code = NULL;
+    psBIN->data = NULL;
+}
+
+//----------------------------------------------------
+// Write Binary Object File
+//----------------------------------------------------
+int BIN_Write_File(const char *fname,
+                   const unsigned char *code, uint32_t code_size, uint32_t entry,
+                   const unsigned char *data, uint32_t data_addr, uint32_t data_size)
+{
+    FILE *fp;
+    unsigned char header[BIN_HEADER_SIZE];
+    uint32_t crc;
+    int error;
+    //
+    // Make Header
+    crc = BIN_CRC32(0, code, code_size);
+    if (data_size > 0) crc = BIN_CRC32(crc, data, data_size);
+    memset(header, 0, BIN_HEADER_SIZE);
+    memcpy(header, BIN_MAGIC, 4);
+    Set_LE16(header +  4, BIN_VERSION);
+    Set_LE16(header +  6, BIN_HEADER_SIZE);
+    Set_LE32(header +  8, code_size);
+    Set_LE32(header + 12, entry);
+    Set_LE32(header + 16, data_addr);
+    Set_LE32(header + 20, data_size);
+    Set_LE32(header + 24, crc);
+    //
+    // Write the File
+    fp = fopen(fname, "wb");
+    if (fp == NULL) return BIN_ERR_OPEN;
+    error = 0;
+    if (fwrite(header, 1, BIN_HEADER_SIZE, fp) != BIN_HEADER_SIZE) error = 1;
+    if ((code_size > 0) && (fwrite(code, 1, code_size, fp) != code_size)) error = 1;
+    if ((data_size > 0) && (fwrite(data, 1, data_size, fp) != data_size)) error = 1;
+    if (fclose(fp) != 0) error = 1;
+    //
+    return (error)? BIN_ERR_WRITE : BIN_OK;
+}
+
+//===========================================================
+// End of File
+//===========================================================
@@ -0,0 +1,80 @@
+//===========================================================
+// bfCPU Common Library
+//-----------------------------------------------------------
+// File Name   : binfile.h
+// Description : Packed Binary Object File Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stddef.h>
+#include <stdint.h>
+#include "mapfile.h"
+
+#ifndef __BINFILE_H__
+#define __BINFILE_H__
+
+//-----------------------------------------------------------
+// Binary Object Format (all fields are little endian)
+//     offset  size
+//       0      4   Magic "bfOB"
+//       4      2   Version
+//       6      2   Header Size (32)
+//       8      4   Code Size in bytes (2 codes in a byte,
+//                  lower address in lower 4bits)
+//      12      4   Entry Point (PC)
+//      16      4   Data Preload Address (PTR)
+//      20      4   Data Preload Size in bytes (0 if none)
+//      24      4   CRC32 of Code and Data
+//      28      4   Reserved (0)
+//      32          Code, followed by Data
+//-----------------------------------------------------------
+#define BIN_MAGIC       "bfOB"
+#define BIN_VERSION     1
+#define BIN_HEADER_SIZE 32
+
+//-----------------------------------
+// Result Code
+//-----------------------------------
+#define BIN_OK           0
+#define BIN_ERR_OPEN     1 // Can't open the file
+#define BIN_ERR_MAGIC    2 // Not a binary object file
+#define BIN_ERR_VERSION  3 // Unsupported version
+#define BIN_ERR_SIZE     4 // Sizes in header disagree with the file
+#define BIN_ERR_CRC      5 // CRC32 unmatched
+#define BIN_ERR_WRITE    6 // Can't write the file
+
+//-----------------------------------
+// Opened Binary Object
+//-----------------------------------
+typedef struct
+{
+    sMAPFILE map;
+    uint32_t version;
+    uint32_t code_size;
+    uint32_t entry;
+    uint32_t data_addr;
+    uint32_t data_size;
+    uint32_t crc32;
+    const unsigned char *code; // points into the mapped file
+    const unsigned char *data; // points into the mapped file
+} sBINFILE;
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+uint32_t BIN_CRC32(uint32_t crc, const unsigned char *buf, size_t len);
+int  BIN_Open(sBINFILE *psBIN, const char *fname);
+void BIN_Close(sBINFILE *psBIN);
+int  BIN_Write_File(const char *fname,
+                    const unsigned char *code, uint32_t code_size, uint32_t entry,
+                    const unsigned char *data, uint32_t data_addr, uint32_t data_size);
+const char *BIN_Error_String(int result);
+
+#endif
+//===========================================================
+// End of File
+//===========================================================
@@ -0,0 +1,236 @@
+//===========================================================
+// bfCPU Common Library
+//-----------------------------------------------------------
+// File Name   : hexfile.c
+// Description : Intel Hex File Reader
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+//
+#include "hexfile.h"
+#include "mapfile.h"
+
+//----------------------------------------------------
+// Hex Digit Decode Table (-1 : not a Hex Digit)
+//----------------------------------------------------
+static const signed char hex_digit[256] =
+{
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+//----------------------------------------------------
+// Decode 2 Hex Digits (-1 : Illegal)
+//----------------------------------------------------
+static inline int Hex_Byte(const unsigned char *p)
+{
+    int hi = hex_digit[p[0]];
+    int lo = hex_digit[p[1]];
+    return ((hi | lo) < 0)? -1 : (hi << 4) | lo;
+}
+
+//----------------------------------------------------
+// Error String
+//----------------------------------------------------
+const char *HEX_Error_String(int result)
+{
+    switch(result)
+    {
+        case HEX_OK           : return "No Error";
+        case HEX_ERR_OPEN     : return "Can't Open Hex File";
+        case HEX_ERR_FORMAT   : return "Hex File Format Error";
+        case HEX_ERR_RECORD   : return "Hex File Unsupported Record";
+        case HEX_ERR_OVERFLOW : return "Hex File Overflows ROM Size";
+        case HEX_ERR_CHECKSUM : return "Hex File Check Sum Unmatched";
+        default               : return "Hex File Unknown Error";
+    }
+}
+
+//----------------------------------------------------
+// Read Intel Hex from a Buffer
+//     Decodes all records in one pass, writing data
+//     bytes into mem[0..size-1]. The caller has to
+//     initialize mem beforehand.
+//     Supports record types 00,01,02,03,04,05.
+//----------------------------------------------------
+int HEX_Read_Buffer(const unsigned char *buf, uint64_t len, unsigned char *mem, uint64_t size, sHEX_INFO *psINFO)
+{
+    const unsigned char *p;
+    const unsigned char *end;
+    const unsigned char *line_top;
+    const unsigned char *err_pos;
+    int      line;
+    int      bytecount;
+    int      rectype;
+    int      data;
+    int      i;
+    unsigned int checksum;
+    uint32_t offset;
+    uint64_t base;
+    uint64_t addr;
+    int      result;
+    //
+    // Initialize
+    psINFO->addr_min = UINT32_MAX;
+    psINFO->addr_max = 0;
+    psINFO->entry    = 0;
+    psINFO->bytes    = 0;
+    psINFO->line     = 0;
+    psINFO->column   = 0;
+    base     = 0;
+    line     = 1;
+    result   = HEX_OK;
+    p        = buf;
+    end      = buf + len;
+    line_top = p;
+    err_pos  = p;
+    //
+    while (p < end)
+    {
+        // Skip Line Terminators and Blank Lines
+        if ((*p == '\n') || (*p == '\r') || (*p == ' ') || (*p == '\t') || (*p == '\0'))
+        {
+            if (*p == '\n') {line++; line_top = p + 1;}
+            p++;
+            continue;
+        }
+        //
+        // Start Code
+        if (*p != ':') {err_pos = p; result = HEX_ERR_FORMAT; break;}
+        p++;
+        //
+        // Byte Count, Address, Record Type
+        if ((end - p) < 8) {err_pos = p; result = HEX_ERR_FORMAT; break;}
+        bytecount = Hex_Byte(p);
+        if (bytecount < 0) {err_pos = p; result = HEX_ERR_FORMAT; break;}
+        data = Hex_Byte(p + 2);
+        i    = Hex_Byte(p + 4);
+        if ((data | i) < 0) {err_pos = p + 2; result = HEX_ERR_FORMAT; break;}
+        offset = ((uint32_t)data << 8) | (uint32_t)i;
+        rectype = Hex_Byte(p + 6);
+        if (rectype < 0) {err_pos = p + 6; result = HEX_ERR_FORMAT; break;}
+        checksum = (unsigned int)(bytecount + data + i + rectype);
+        p = p + 8;
+        //
+        // Data and Check Sum should be in the Buffer
+        if ((end - p) < (bytecount * 2 + 2)) {err_pos = p; result = HEX_ERR_FORMAT; break;}
+        //
+        // Each Record
+        if (rectype == HEX_REC_DATA)
+        {
+            addr = base + offset;
+            if ((addr + (uint64_t)bytecount) > size)
+            {
+                err_pos = p - 6; result = HEX_ERR_OVERFLOW; break;
+            }
+            for (i = 0; i < bytecount; i++)
+            {
+                data = Hex_Byte(p);
+                if (data < 0) break;
+                mem[addr + i] = (unsigned char)data;
+                checksum = checksum + (unsigned int)data;
+                p = p + 2;
+            }
+            if (i < bytecount) {err_pos = p; result = HEX_ERR_FORMAT; break;}
+            if (bytecount > 0)
+            {
+                if ((uint32_t)addr < psINFO->addr_min) psINFO->addr_min = (uint32_t)addr;
+                if ((uint32_t)(addr + bytecount - 1) > psINFO->addr_max) psINFO->addr_max = (uint32_t)(addr + bytecount - 1);
+                psINFO->bytes = psINFO->bytes + (uint32_t)bytecount;
+            }
+        }
+        else if ((rectype == HEX_REC_EXT_SEG) || (rectype == HEX_REC_EXT_LIN)
+              || (rectype == HEX_REC_START_SEG) || (rectype == HEX_REC_START_LIN)
+              || (rectype == HEX_REC_EOF))
+        {
+            uint32_t value = 0;
+            for (i = 0; i < bytecount; i++)
+            {
+                data = Hex_Byte(p);
+                if (data < 0) break;
+                value = (value << 8) | (uint32_t)data;
+                checksum = checksum + (unsigned int)data;
+                p = p + 2;
+            }
+            if (i < bytecount) {err_pos = p; result = HEX_ERR_FORMAT; break;}
+            if (((rectype == HEX_REC_EXT_SEG  ) && (bytecount != 2))
+             || ((rectype == HEX_REC_EXT_LIN  ) && (bytecount != 2))
+             || ((rectype == HEX_REC_START_SEG) && (bytecount != 4))
+             || ((rectype == HEX_REC_START_LIN) && (bytecount != 4))
+             || ((rectype == HEX_REC_EOF      ) && (bytecount != 0)))
+            {
+                err_pos = p - bytecount * 2 - 8; result = HEX_ERR_FORMAT; break;
+            }
+                 if (rectype == HEX_REC_EXT_SEG  ) base = (uint64_t)value << 4;
+            else if (rectype == HEX_REC_EXT_LIN  ) base = (uint64_t)value << 16;
+            else if (rectype == HEX_REC_START_SEG) psINFO->entry = ((value >> 16) << 4) + (value & 0x0ffff);
+            else if (rectype == HEX_REC_START_LIN) psINFO->entry = value;
+        }
+        else
+        {
+            err_pos = p - 2; result = HEX_ERR_RECORD; break;
+        }
+        //
+        // Check Sum
+        data = Hex_Byte(p);
+        if (data < 0) {err_pos = p; result = HEX_ERR_FORMAT; break;}
+        if (((checksum + (unsigned int)data) & 0x0ff) != 0) {err_pos = p; result = HEX_ERR_CHECKSUM; break;}
+        p = p + 2;
+        //
+        // End of Record
+        if (rectype == HEX_REC_EOF) break;
+    }
+    //
+    // Error Position
+    if (result != HEX_OK)
+    {
+        psINFO->line   = line;
+        psINFO->column = (int)(err_pos - line_top) + 1;
+    }
+    if (psINFO->bytes == 0) psINFO->addr_min = 0;
+    return result;
+}
+
+//----------------------------------------------------
+// Read Intel Hex File
+//----------------------------------------------------
+int HEX_Read_File(const char *fname, unsigned char *mem, uint64_t size, sHEX_INFO *psINFO)
+{
+    sMAPFILE map;
+    int result;
+    //
+    if (MAP_File_Open(&map, fname))
+    {
+        psINFO->line   = 0;
+        psINFO->column = 0;
+        return HEX_ERR_OPEN;
+    }
+    result = HEX_Read_Buffer(map.data, map.size, mem, size, psINFO);
+    MAP_File_Close(&map);
+    return result;
+}
+
+//===========================================================
+// End of File
+//===========================================================
@@ -0,0 +1,61 @@
+//===========================================================
+// bfCPU Common Library
+//-----------------------------------------------------------
+// File Name   : hexfile.h
+// Description : Intel Hex File Reader Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+
+#ifndef __HEXFILE_H__
+#define __HEXFILE_H__
+
+//-----------------------------------
+// Result Code
+//-----------------------------------
+#define HEX_OK           0
+#define HEX_ERR_OPEN     1 // Can't open the file
+#define HEX_ERR_FORMAT   2 // Illegal character or short record
+#define HEX_ERR_RECORD   3 // Unsupported record type
+#define HEX_ERR_OVERFLOW 4 // Data beyond the memory size
+#define HEX_ERR_CHECKSUM 5 // Check sum unmatched
+
+//-----------------------------------
+// Record Type
+//-----------------------------------
+#define HEX_REC_DATA     0x00
+#define HEX_REC_EOF      0x01
+#define HEX_REC_EXT_SEG  0x02
+#define HEX_REC_START_SEG 0x03
+#define HEX_REC_EXT_LIN  0x04
+#define HEX_REC_START_LIN 0x05
+
+//-----------------------------------
+// Information of the Loaded Image
+//-----------------------------------
+typedef struct
+{
+    uint32_t addr_min; // Lowest Byte Address written
+    uint32_t addr_max; // Highest Byte Address written
+    uint32_t entry;    // Start Address Record (0 if none)
+    uint32_t bytes;    // Number of Data Bytes written
+    int      line;     // Error Position (1 origin)
+    int      column;   // Error Position (1 origin)
+} sHEX_INFO;
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+int HEX_Read_File(const char *fname, unsigned char *mem, uint64_t size, sHEX_INFO *psINFO);
+int HEX_Read_Buffer(const unsigned char *buf, uint64_t len, unsigned char *mem, uint64_t size, sHEX_INFO *psINFO);
+const char *HEX_Error_String(int result);
+
+#endif
+//===========================================================
+// End of File
+//===========================================================
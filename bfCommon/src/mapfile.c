@@ -0,0 +1,128 @@
+//===========================================================
+// bfCPU Common Library
+//-----------------------------------------------------------
+// File Name   : mapfile.c
+// Description : Read-only File Mapping Routine
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
+//
+#include "mapfile.h"
+
+//-------------------------------------------------
+// Open a File and Map it into Memory
+//     Returns 0 if success, -1 if error.
+//     Falls back to read() until EOF when mmap is
+//     unavailable (empty file, pipe, Windows).
+//-------------------------------------------------
+int MAP_File_Open(sMAPFILE *psMAP, const char *fname)
+{
+    int fd;
+    struct stat st;
+    unsigned char *buf;
+    unsigned char *grow;
+    size_t capacity;
+    size_t done;
+    ssize_t len;
+    //
+    psMAP->data   = NULL;
+    psMAP->size   = 0;
+    psMAP->mapped = 0;
+    //
+    // Open the File
+    fd = open(fname, O_RDONLY);
+    if (fd < 0) return -1;
+    if (fstat(fd, &st) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+    psMAP->size = (size_t)st.st_size;
+    //
+#if !defined(_WIN32)
+    // Map whole File
+    if (S_ISREG(st.st_mode) && (psMAP->size > 0))
+    {
+        void *addr = mmap(NULL, psMAP->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED)
+        {
+            madvise(addr, psMAP->size, MADV_SEQUENTIAL);
+            psMAP->data   = (const unsigned char*)addr;
+            psMAP->mapped = 1;
+            close(fd);
+            return 0;
+        }
+    }
+#endif
+    //
+    // Fallback : Read until EOF (st_size is 0 for a pipe)
+    capacity = (psMAP->size > 0)? psMAP->size + 1 : 4096;
+    buf = (unsigned char*)malloc(capacity);
+    if (buf == NULL)
+    {
+        close(fd);
+        return -1;
+    }
+    done = 0;
+    while (1)
+    {
+        if (done == capacity)
+        {
+            grow = (unsigned char*)realloc(buf, capacity * 2);
+            if (grow == NULL)
+            {
+                free(buf);
+                close(fd);
+                return -1;
+            }
+            buf = grow;
+            capacity = capacity * 2;
+        }
+        len = read(fd, buf + done, capacity - done);
+        if (len == 0) break;
+        if (len < 0)
+        {
+            free(buf);
+            close(fd);
+            return -1;
+        }
+        done = done + (size_t)len;
+    }
+    close(fd);
+    psMAP->data = buf;
+    psMAP->size = done;
+    return 0;
+}
+
+//-------------------------------------------------
+// Unmap the File
+//-------------------------------------------------
+void MAP_File_Close(sMAPFILE *psMAP)
+{
+    if (psMAP->data == NULL) return;
+#if !defined(_WIN32)
+    if (psMAP->mapped)
+        munmap((void*)psMAP->data, psMAP->size);
+    else
+#endif
+        free((void*)psMAP->data);
+    psMAP->data = NULL;
+    psMAP->size = 0;
+}
+
+//===========================================================
+// End of File
+//===========================================================
@@ -0,0 +1,37 @@
+//===========================================================
+// bfCPU Common Library
+//-----------------------------------------------------------
+// File Name   : mapfile.h
+// Description : Read-only File Mapping Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stddef.h>
+
+#ifndef __MAPFILE_H__
+#define __MAPFILE_H__
+
+//----------------------------
+// Mapped File
+//----------------------------
+typedef struct
+{
+    const unsigned char *data; // File Image (not Null Terminated)
+    size_t size;               // File Size in bytes
+    int    mapped;             // 1:mmap, 0:malloc
+} sMAPFILE;
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+int  MAP_File_Open(sMAPFILE *psMAP, const char *fname);
+void MAP_File_Close(sMAPFILE *psMAP);
+
+#endif
+//===========================================================
+// End of File
+//===========================================================
@@ -10,22 +10,26 @@
 // Copyright (C) 2025 M.Maruyama
 //===========================================================
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "asm.h"
+#include "binfile.h"
 #include "defines.h"
+#include "mapfile.h"
+#include "ptrange.h"
 #include "utility.h"
 #include "parser.tab.h"
 
 //-------------------------
 // Global Variables
 //-------------------------
-int PC = 0;
+uint32_t PC = 0;
 sINSTR *pINSTR_ROOT = NULL;
-extern int MAXROM;
-extern int MAXRAM;
+extern uint32_t MAXROM;
+extern uint32_t MAXRAM;
 
 //-----------------------------------------
 // Function Prototype
@@ -107,6 +111,45 @@ void Instruction_Chain_Dispose(void)
     pINSTR_ROOT = NULL;
 }
 
+//------------------------------------
+// Output Pointer Range to the List
+//     Tells in advance if the program
+//     fits in the RAM.
+//------------------------------------
+static void Output_Pointer_Range(FILE *fp, const unsigned char *rom)
+{
+    sPTRANGE range;
+    uint32_t i;
+    //
+    fprintf(fp, "//----------------------------------------------------------\n");
+    if ((PTRANGE_Analyze(rom, MAXROM, 0, MAXRAM, &range, NULL)) || (range.valid == 0))
+    {
+        fprintf(fp, "// Pointer Range : not analyzed (brackets are not balanced)\n");
+        return;
+    }
+    fprintf(fp, "// Pointer Range : ");
+    if (range.lo == -PTRANGE_INF) fprintf(fp, "unbounded");
+    else if (range.lo < 0)        fprintf(fp, "-0x%04" PRIx64, (uint64_t)-range.lo);
+    else                          fprintf(fp, "0x%04" PRIx64, (uint64_t)range.lo);
+    if (range.hi == PTRANGE_INF)  fprintf(fp, "-unbounded");
+    else                          fprintf(fp, "-0x%04" PRIx64, (uint64_t)range.hi);
+    if (range.lo < 0)
+        fprintf(fp, " (may wrap below 0)\n");
+    else if (range.hi == PTRANGE_INF)
+        fprintf(fp, "\n");
+    else
+        fprintf(fp, " (%" PRIu64 " bytes, %s RAM of %u bytes)\n", (uint64_t)range.hi + 1,
+            ((uint64_t)range.hi < MAXRAM)? "fits in" : "exceeds", MAXRAM);
+    for (i = 0; (i < range.num_loop) && (i < PTRANGE_LOOP_MAX); i++)
+    {
+        if (range.move[i])
+            fprintf(fp, "// Unbounded Loop at 0x%02x : pointer moves %+" PRId64 " per iteration\n", range.loop[i], range.move[i]);
+        else
+            fprintf(fp, "// Unbounded Loop at 0x%02x : pointer moves per iteration\n", range.loop[i]);
+    }
+    if (range.num_loop > PTRANGE_LOOP_MAX) fprintf(fp, "// ... and %u more Unbounded Loops\n", range.num_loop - PTRANGE_LOOP_MAX);
+}
+
 //------------------------------------
 // Output Assemble Results
 //------------------------------------
@@ -116,20 +159,27 @@ void Output_Assemble_Results(sOPTION *psOPTION)
     char fname_obj[MAXLEN_WORD];
     char fname_ver[MAXLEN_WORD];
     char fname_lis[MAXLEN_WORD];
+    char fname_bin[MAXLEN_WORD];
     FILE *fp_obj;
     FILE *fp_ver;
     FILE *fp_lis;
     int  error;
     unsigned char *rom; // 4bit width
     int  i;
-    int  addr;
-    int  addr_max;
+    uint64_t addr;
+    uint64_t addr_max;
+    uint32_t addr_byte;
+    uint32_t addr_upper;
     int  indent;
     unsigned char checksum;
+    unsigned char *code; // 4bit x 2
+    uint32_t code_size;
+    sMAPFILE preload;
+    int  result;
     sINSTR *pinstr;
     //
     // Allocate ROM
-    rom = (unsigned char*)malloc(sizeof(unsigned char) * (MAXROM));
+    rom = (unsigned char*)malloc(sizeof(unsigned char) * ((uint64_t)MAXROM + 32)); // +32 for the last Hex Record
     if (rom == NULL)
     {
         fprintf(stderr, "======== ERROR: Can't allocate ROM area.\n");
@@ -171,18 +221,34 @@ void Output_Assemble_Results(sOPTION *psOPTION)
         String_Copy(fname_lis, fname_basename, MAXLEN_WORD);
         String_Concatenate(fname_lis, ".lis", MAXLEN_WORD);
     }
+    //
+    // Make fname_bin
+    if (psOPTION->opt_bin)
+    {
+        String_Copy(fname_bin, psOPTION->opt_bin_name, MAXLEN_WORD);
+    }
+    else
+    {
+        String_Copy(fname_bin, fname_basename, MAXLEN_WORD);
+        String_Concatenate(fname_bin, ".bin", MAXLEN_WORD);
+    }
     DEBUG_printf(DEBUG_MAX, "fname_obj=%s\n", fname_obj);
     DEBUG_printf(DEBUG_MAX, "fname_ver=%s\n", fname_ver);
     DEBUG_printf(DEBUG_MAX, "fname_lis=%s\n", fname_lis);
+    DEBUG_printf(DEBUG_MAX, "fname_bin=%s\n", fname_bin);
     //
     // Check File Name
     error = 0;
     error = (strcmp(psOPTION->input_file_name, fname_obj))? error : 1;
     error = (strcmp(psOPTION->input_file_name, fname_ver))? error : 1;
     error = (strcmp(psOPTION->input_file_name, fname_lis))? error : 1;
+    error = (strcmp(psOPTION->input_file_name, fname_bin))? error : 1;
     error = (strcmp(fname_obj, fname_ver))? error : 1;
     error = (strcmp(fname_obj, fname_lis))? error : 1;
+    error = (strcmp(fname_obj, fname_bin))? error : 1;
     error = (strcmp(fname_ver, fname_lis))? error : 1;
+    error = (strcmp(fname_ver, fname_bin))? error : 1;
+    error = (strcmp(fname_lis, fname_bin))? error : 1;
     if (error)
     {
         fprintf(stderr, "======== ERROR: File Name Confliction\n");
@@ -205,7 +271,7 @@ void Output_Assemble_Results(sOPTION *psOPTION)
     }
     //
     // Clear ROM
-    for (addr = 0; addr < MAXROM; addr++) rom[addr] = CODE_NOP;
+    memset(rom, CODE_NOP, (uint64_t)MAXROM + 32);
     //
     // Set ROM
     addr = 0;
@@ -236,11 +302,21 @@ void Output_Assemble_Results(sOPTION *psOPTION)
     if (pINSTR_ROOT != NULL)
     {
         checksum = 0;
+        addr_upper = 0;
         for (addr = 0; addr < MAXROM; addr = addr + 32)
         {
             if (addr > addr_max) break;
             //
-            int addr_byte = addr / 2;
+            // Extended Linear Address Record beyond 64KB
+            addr_byte = (uint32_t)(addr / 2);
+            if ((addr_byte >> 16) != addr_upper)
+            {
+                addr_upper = addr_byte >> 16;
+                checksum = 2 + 0x04 + ((addr_upper >> 8) & 0x0ff) + ((addr_upper >> 0) & 0x0ff);
+                checksum = 0 - checksum;
+                fprintf(fp_obj, ":%02X%04X%02X%04X%02X\n", 2, 0, 0x04, addr_upper, checksum);
+            }
+            addr_byte = addr_byte & 0x0ffff;
             fprintf(fp_obj, ":%02X%04X%02X", 16, addr_byte, 0x00);
             checksum = 16 + ((addr_byte >> 8) & 0x0ff) + ((addr_byte >> 0) & 0x0ff) + 0;
             for (i = 0; i < 32; i = i + 2)
@@ -259,9 +335,45 @@ void Output_Assemble_Results(sOPTION *psOPTION)
 	for (addr = 0; addr < MAXROM; addr = addr + 2)
 	{
         if (addr > addr_max) break;
-		fprintf(fp_ver, "@%02x %1x%1x\n", addr / 2, rom[addr + 1], rom[addr]);
+		fprintf(fp_ver, "@%02x %1x%1x\n", (uint32_t)(addr / 2), rom[addr + 1], rom[addr]);
 	}    
     //
+    // Write Binary File
+    code_size = (pINSTR_ROOT != NULL)? (uint32_t)(addr_max / 2) + 1 : 0;
+    code = (unsigned char*)malloc(sizeof(unsigned char) * (code_size + 1));
+    if (code == NULL)
+    {
+        fprintf(stderr, "======== ERROR: Can't allocate Binary area.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (addr = 0; addr < code_size; addr++)
+    {
+        code[addr] = (rom[addr * 2 + 1] << 4) | rom[addr * 2];
+    }
+    preload.data = NULL;
+    preload.size = 0;
+    if (psOPTION->opt_pre)
+    {
+        if (MAP_File_Open(&preload, psOPTION->opt_pre_name))
+        {
+            fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", psOPTION->opt_pre_name);
+            exit(EXIT_FAILURE);
+        }
+        if (preload.size > (size_t)MAXRAM)
+        {
+            fprintf(stderr, "======== ERROR: Preload Data Overflows RAM Size.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    result = BIN_Write_File(fname_bin, code, code_size, 0, preload.data, 0, (uint32_t)preload.size);
+    if (result != BIN_OK)
+    {
+        fprintf(stderr, "======== ERROR: %s \"%s\".\n", BIN_Error_String(result), fname_bin);
+        exit(EXIT_FAILURE);
+    }
+    if (psOPTION->opt_pre) MAP_File_Close(&preload);
+    free(code);
+    //
     // Write List File
     if (pINSTR_ROOT != NULL)
     {
@@ -282,6 +394,7 @@ void Output_Assemble_Results(sOPTION *psOPTION)
             fprintf(fp_lis, "%s\n", pinstr->instr_str);
             if (pinstr->instr_code == CODE_BEGIN) indent = indent + 1;
         }
+        Output_Pointer_Range(fp_lis, rom);
     }    
     //
     // Close each file
@@ -36,7 +36,7 @@
 //----------------------------
 struct instr
 {
-    int            instr_addr;
+    uint32_t       instr_addr;
     int            instr_code;
     char          *instr_str;
     struct instr  *instr_next;
@@ -0,0 +1,2367 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : bfsim.c
+// Description : Simulator Core Library (libbfsim)
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bfsim.h"
+#include "memory.h"
+#include "ptrange.h"
+
+//-----------------------------------
+// Superinstructions of Two Ops
+//     name, first op, second op, BFSIM_SUPER_xxx
+//     The handler of each is made of the handlers
+//     of the two ops (BFSIM_Run_Fast).
+//-----------------------------------
+#define SUPER_PAIRS(X) \
+    X(ADD_MOVE   , ADD  , MOVE , BFSIM_SUPER_ADD_MOVE  ) \
+    X(ADD_SMOVE  , ADD  , SMOVE, BFSIM_SUPER_ADD_MOVE  ) \
+    X(MOVE_ADD   , MOVE , ADD  , BFSIM_SUPER_MOVE_ADD  ) \
+    X(SMOVE_ADD  , SMOVE, ADD  , BFSIM_SUPER_MOVE_ADD  ) \
+    X(ADD_END    , ADD  , END  , BFSIM_SUPER_ADD_END   ) \
+    X(MOVE_END   , MOVE , END  , BFSIM_SUPER_MOVE_END  ) \
+    X(SMOVE_END  , SMOVE, END  , BFSIM_SUPER_MOVE_END  ) \
+    X(MOVE_BEGIN , MOVE , BEGIN, BFSIM_SUPER_MOVE_BEGIN) \
+    X(SMOVE_BEGIN, SMOVE, BEGIN, BFSIM_SUPER_MOVE_BEGIN)
+
+//-----------------------------------
+// Predecoded Operation (Fast Model)
+//-----------------------------------
+enum PRE_OP
+{
+    OP_MOVE,    // ptr += arg (run of P++ or P--)
+    OP_ADD,     // ram[ptr] += arg (run of INC and DEC)
+    OP_OUT,
+    OP_IN,
+    OP_BEGIN,   // if ram[ptr] == 0 goto jump
+    OP_END,     // if ram[ptr] != 0 goto jump
+    OP_RESET,
+    OP_SCAN,    // [>>..] or [<<..] : move by arg until ram[ptr] == 0
+    OP_ILLEGAL,
+    OP_WRAP,    // PC wraps around to 0
+    OP_BREAK,   // breakpoint before the next op (len 0)
+    OP_WADD,    // OP_ADD to be checked for watchpoints
+    OP_SMOVE,   // OP_MOVE proven not to wrap (no check)
+    OP_CLEAR,   // [-] or [+] : ram[ptr] = 0
+    OP_MUL,     // [->+<..] : adds ram[ptr] x each INC/DEC run (arg : lowest offset,
+                //            arg of the END : highest offset)
+    OP_BLOCK,   // straight run of MOVE/ADD : updates cells at offsets, then moves once
+                //            (arg : index of blocks[], jump : op after the block)
+#define SUPER_OP(name, first, second, super) OP_##name,
+    SUPER_PAIRS(SUPER_OP) // first op, then the second (op + 1)
+#undef SUPER_OP
+};
+//
+#define OP_RUN_MAX 0x40000000 // limit of a fused run
+//
+typedef struct
+{
+    uint8_t  op;
+    int32_t  arg;
+    uint32_t jump; // index of the next op if branch is taken
+    uint32_t pc;   // PC of the first instruction
+    uint32_t nop;  // NOPs just before the op
+    uint32_t len;  // instructions fused into the op
+} sOP;
+
+//-----------------------------------
+// Basic Block of MOVE/ADD (OP_BLOCK)
+//     Offsets are from PTR at the start.
+//     The ops stay after OP_BLOCK, and run
+//     one by one if the block would wrap.
+//-----------------------------------
+typedef struct
+{
+    int32_t  off;
+    uint8_t  delta;
+} sCELL;
+//
+typedef struct
+{
+    sOP      first;    // first op of the block as predecoded
+    int64_t  lo;       // lowest offset visited
+    int64_t  hi;       // highest offset visited
+    int64_t  move;     // offset at the end
+    int64_t  peak;     // highest offset reached by P++
+    int      inc;      // peak is valid (P++ in the block)
+    uint64_t count;    // instructions (NOPs included)
+    uint32_t cell;     // first of cells[], by offset
+    uint32_t num_cell;
+} sBLOCK;
+
+//-----------------------------------
+// Machine
+//-----------------------------------
+struct bfsim
+{
+    // Memory
+    unsigned char *rom;
+    uint32_t rom_size;
+    sRING    ring;
+    uint32_t ram_size;
+    unsigned char *preload;
+    uint32_t data_addr;
+    uint32_t data_size;
+    uint32_t entry;
+    uint8_t *safe;       // P++/P-- proven not to wrap (NULL if not analyzed)
+    // Registers
+    uint32_t pc;
+    uint32_t ptr;
+    uint32_t maxptr;
+    uint64_t count;
+    uint64_t count_reset;
+    // Event
+    uint32_t event_pc;
+    unsigned char data;
+    int      wait_in;
+    // Debug
+    uint8_t *brk;        // breakpoint bitmap (NULL if none)
+    uint32_t num_brk;
+    int      skip_brk;   // resume from a breakpoint
+    uint32_t watch[BFSIM_WATCH_MAX]; // watched RAM addresses
+    uint32_t num_watch;
+    uint8_t *watch_page; // watches per page (NULL if none)
+    BFSIM_TRACE_FUNC trace;
+    void    *trace_user;
+    uint64_t limit;      // count to stop at (UINT64_MAX if none)
+    unsigned char *cover; // coverage map (NULL if none)
+    uint32_t cover_prev; // last branch outcome
+    // Fast Model
+    sOP     *ops;
+    uint32_t num_op;
+    int      ops_tried;
+    sBLOCK  *blocks;     // basic blocks (NULL if none)
+    sCELL   *cells;
+    uint32_t super;      // superinstructions (mask of BFSIM_SUPER_xxx)
+    sBFSIM_PROFILE *profile; // NULL if not profiled
+    uint64_t *prof;      // per op : runs, then END taken (num_op each)
+    // Stop Request (from other threads or signal handlers)
+    atomic_int stop;
+};
+
+//-----------------------------------
+// Increment / Decrement Pointers
+//-----------------------------------
+#define INC_PTR(ptr) (((ptr) == (psSIM->ram_size - 1))? 0 : (ptr) + 1)
+#define DEC_PTR(ptr) (((ptr) == 0)? psSIM->ram_size - 1   : (ptr) - 1)
+//
+#define INC_PC(pc) (((pc) == (psSIM->rom_size - 1))? 0 : (pc) + 1)
+#define DEC_PC(pc) (((pc) == 0)? psSIM->rom_size - 1   : (pc) - 1)
+//
+#define IS_BRK(brk, pc) (((brk) != NULL) && ((brk)[(pc) >> 3] & (1 << ((pc) & 7))))
+#define IS_SAFE(safe, pc) (((safe) != NULL) && ((safe)[(pc) >> 3] & (1 << ((pc) & 7))))
+#define WATCH_SHIFT 12 // page of watch_page[]
+
+//-----------------------------------
+// Coverage Point
+//     Branch outcomes are counted as edges
+//     from the previous outcome, the others
+//     by themselves.
+//-----------------------------------
+enum COVER_KIND
+{
+    COVER_NEXT, // BEGIN / END falls through
+    COVER_JUMP, // BEGIN / END jumps
+    COVER_OVF,  // INC / DEC carries over the cell
+    COVER_WRAP  // P++ / P-- wraps around the RAM
+};
+//
+static inline void Cover(sBFSIM *psSIM, uint32_t pc, uint32_t kind)
+{
+    uint32_t cur = (((pc << 2) | kind) * 0x9e3779b1u) >> 16;
+    //
+    if (kind > COVER_JUMP)
+    {
+        psSIM->cover[cur & (BFSIM_COVER_SIZE - 1)]++;
+        return;
+    }
+    psSIM->cover[(cur ^ psSIM->cover_prev) & (BFSIM_COVER_SIZE - 1)]++;
+    psSIM->cover_prev = cur >> 1;
+}
+
+//----------------------------------
+// Load Data Preload into RAM
+//----------------------------------
+static void BFSIM_Preload(sBFSIM *psSIM)
+{
+    if (psSIM->data_size) memcpy(psSIM->ring.mem + psSIM->data_addr, psSIM->preload, psSIM->data_size);
+}
+
+//----------------------------------
+// Create a Machine
+//     rom has rom_size codes (4bit in each byte).
+//     Returns NULL if sizes are illegal or
+//     memory can't be allocated.
+//----------------------------------
+sBFSIM *BFSIM_Create(const unsigned char *rom, const sBFSIM_CONFIG *psCONFIG)
+{
+    sBFSIM *psSIM;
+    sPTRANGE range;
+    int  bounded;
+    //
+    if ((psCONFIG->rom_size == 0) || (psCONFIG->ram_size == 0)) return NULL;
+    if (psCONFIG->entry >= psCONFIG->rom_size) return NULL;
+    if ((uint64_t)psCONFIG->data_addr + psCONFIG->data_size > psCONFIG->ram_size) return NULL;
+    //
+    psSIM = (sBFSIM*)calloc(1, sizeof(sBFSIM));
+    if (psSIM == NULL) return NULL;
+    psSIM->rom_size = psCONFIG->rom_size;
+    psSIM->ram_size = psCONFIG->ram_size;
+    //
+    // ROM
+    psSIM->rom = (unsigned char*)malloc(psCONFIG->rom_size);
+    if (psSIM->rom == NULL) {BFSIM_Destroy(psSIM); return NULL;}
+    memcpy(psSIM->rom, rom, psCONFIG->rom_size);
+    //
+    // Pointer Range
+    psSIM->safe = (uint8_t*)calloc(((uint64_t)psCONFIG->rom_size + 7) / 8, 1);
+    if (psSIM->safe == NULL) {BFSIM_Destroy(psSIM); return NULL;}
+    if (PTRANGE_Analyze(rom, psCONFIG->rom_size, psCONFIG->entry, psCONFIG->ram_size, &range, psSIM->safe))
+    {
+        BFSIM_Destroy(psSIM);
+        return NULL;
+    }
+    bounded = (range.valid) && (range.lo >= 0) && (range.hi < (int64_t)psCONFIG->ram_size);
+    //
+    // RAM (Mirrored Ring unless the Pointer never wraps)
+    if (MEM_Ring_Alloc(&psSIM->ring, psCONFIG->ram_size, !bounded)) {BFSIM_Destroy(psSIM); return NULL;}
+    //
+    // Data Preload
+    if (psCONFIG->data_size)
+    {
+        psSIM->preload = (unsigned char*)malloc(psCONFIG->data_size);
+        if (psSIM->preload == NULL) {BFSIM_Destroy(psSIM); return NULL;}
+        memcpy(psSIM->preload, psCONFIG->data, psCONFIG->data_size);
+        psSIM->data_addr = psCONFIG->data_addr;
+        psSIM->data_size = psCONFIG->data_size;
+    }
+    //
+    // Initialize Registers
+    psSIM->entry = psCONFIG->entry;
+    psSIM->pc = psCONFIG->entry;
+    psSIM->limit = UINT64_MAX;
+    BFSIM_Preload(psSIM);
+    atomic_init(&psSIM->stop, 0);
+    return psSIM;
+}
+
+//----------------------------------
+// Destroy a Machine
+//----------------------------------
+void BFSIM_Destroy(sBFSIM *psSIM)
+{
+    if (psSIM == NULL) return;
+    if (psSIM->ring.mem) MEM_Ring_Free(&psSIM->ring);
+    free(psSIM->rom);
+    free(psSIM->safe);
+    free(psSIM->preload);
+    free(psSIM->brk);
+    free(psSIM->watch_page);
+    free(psSIM->ops);
+    free(psSIM->blocks);
+    free(psSIM->cells);
+    free(psSIM->prof);
+    free(psSIM->profile);
+    free(psSIM);
+}
+
+//----------------------------------
+// Reset (by RESET instruction)
+//----------------------------------
+static void BFSIM_Reset(sBFSIM *psSIM)
+{
+    psSIM->pc = 0;
+    psSIM->ptr = 0;
+    psSIM->count = 0;
+    MEM_Ring_Clear(&psSIM->ring);
+    BFSIM_Preload(psSIM);
+}
+
+//----------------------------------
+// Call Trace Function
+//----------------------------------
+static void BFSIM_Trace(sBFSIM *psSIM, uint32_t pc, unsigned char code)
+{
+    sBFSIM_TRACE trace;
+    //
+    if (psSIM->trace == NULL) return;
+    trace.count = psSIM->count;
+    trace.pc    = pc;
+    trace.code  = code;
+    trace.ptr   = psSIM->ptr;
+    trace.data  = psSIM->ring.mem[psSIM->ptr];
+    psSIM->trace(psSIM->trace_user, &trace);
+}
+
+//----------------------------------
+// Is the RAM Address Watched?
+//----------------------------------
+static inline int BFSIM_Watched(const sBFSIM *psSIM, uint32_t addr)
+{
+    uint32_t i;
+    //
+    if (psSIM->watch_page[addr >> WATCH_SHIFT] == 0) return 0;
+    for (i = 0; i < psSIM->num_watch; i++)
+    {
+        if (psSIM->watch[i] == addr) return 1;
+    }
+    return 0;
+}
+
+//----------------------------------
+// Execute One Instruction
+//     Same as the hardware, including the
+//     bracket search through the ROM.
+//     Returns an event, or -1 to continue.
+//----------------------------------
+static int BFSIM_Step_One(sBFSIM *psSIM)
+{
+    unsigned char *ram = psSIM->ring.mem;
+    uint32_t pc = psSIM->pc;
+    uint32_t ptr = psSIM->ptr;
+    unsigned char code;
+    int  indent;
+    int  event;
+    //
+    // Breakpoint
+    if ((psSIM->brk) && (psSIM->brk[pc >> 3] & (1 << (pc & 7))) && (psSIM->skip_brk == 0))
+    {
+        psSIM->skip_brk = 1;
+        psSIM->event_pc = pc;
+        return BFSIM_EV_BREAK;
+    }
+    psSIM->skip_brk = 0;
+    //
+    // Fetch, Decode and Exec
+    code = psSIM->rom[pc];
+    event = -1;
+    if ((psSIM->num_watch) && ((code == BFSIM_CODE_INC) || (code == BFSIM_CODE_DEC)) && (BFSIM_Watched(psSIM, ptr)))
+    {
+        psSIM->event_pc = pc;
+        psSIM->data = ram[ptr];
+        event = BFSIM_EV_WATCH;
+    }
+    switch(code)
+    {
+        case BFSIM_CODE_PINC :
+        {
+            if ((psSIM->cover) && (ptr == psSIM->ram_size - 1)) Cover(psSIM, pc, COVER_WRAP);
+            ptr = INC_PTR(ptr);
+            psSIM->maxptr = (ptr > psSIM->maxptr)? ptr : psSIM->maxptr;
+            pc = INC_PC(pc);
+            break;
+        }
+        case BFSIM_CODE_PDEC :
+        {
+            if ((psSIM->cover) && (ptr == 0)) Cover(psSIM, pc, COVER_WRAP);
+            ptr = DEC_PTR(ptr);
+            pc = INC_PC(pc);
+            break;
+        }
+        case BFSIM_CODE_INC :
+        {
+            if ((psSIM->cover) && (ram[ptr] == 0xff)) Cover(psSIM, pc, COVER_OVF);
+            ram[ptr] = ram[ptr] + 1;
+            pc = INC_PC(pc);
+            break;
+        }
+        case BFSIM_CODE_DEC :
+        {
+            if ((psSIM->cover) && (ram[ptr] == 0x00)) Cover(psSIM, pc, COVER_OVF);
+            ram[ptr] = ram[ptr] - 1;
+            pc = INC_PC(pc);
+            break;
+        }
+        case BFSIM_CODE_OUT :
+        {
+            psSIM->event_pc = pc;
+            psSIM->data = ram[ptr];
+            event = BFSIM_EV_OUT;
+            pc = INC_PC(pc);
+            break;
+        }
+        case BFSIM_CODE_IN :
+        {
+            // Executed by BFSIM_Feed_Input()
+            psSIM->event_pc = pc;
+            psSIM->wait_in = 1;
+            return BFSIM_EV_IN;
+        }
+        case BFSIM_CODE_BEGIN :
+        {
+            if (psSIM->cover) Cover(psSIM, pc, (ram[ptr] == 0)? COVER_JUMP : COVER_NEXT);
+            pc = INC_PC(pc);
+            if (ram[ptr] == 0)
+            {
+                indent = 0;
+                while(1)
+                {
+                    code = psSIM->rom[pc];
+                         if ((indent == 0) && (code == BFSIM_CODE_END)) {pc = INC_PC(pc); break;}
+                    else if ((indent >  0) && (code == BFSIM_CODE_END)) {pc = INC_PC(pc); indent--;}
+                    else if (code == BFSIM_CODE_BEGIN) {pc = INC_PC(pc); indent++;}
+                    else pc = INC_PC(pc);
+                    if (atomic_load_explicit(&psSIM->stop, memory_order_relaxed)) break;
+                }
+                code = BFSIM_CODE_BEGIN;
+            }
+            break;
+        }
+        case BFSIM_CODE_END :
+        {
+            if (psSIM->cover) Cover(psSIM, pc, (ram[ptr] != 0)? COVER_JUMP : COVER_NEXT);
+            if (ram[ptr] != 0)
+            {
+                indent = 0;
+                pc = DEC_PC(pc);
+                while(1)
+                {
+                    code = psSIM->rom[pc];
+                         if ((indent == 0) && (code == BFSIM_CODE_BEGIN)) {pc = INC_PC(pc); break;}
+                    else if ((indent >  0) && (code == BFSIM_CODE_BEGIN)) {pc = DEC_PC(pc); indent--;}
+                    else if (code == BFSIM_CODE_END) {pc = DEC_PC(pc); indent++;}
+                    else pc = DEC_PC(pc);
+                    if (atomic_load_explicit(&psSIM->stop, memory_order_relaxed)) break;
+                }
+                code = BFSIM_CODE_END;
+            }
+            else
+            {
+                pc = INC_PC(pc);
+            }
+            break;
+        }
+        case BFSIM_CODE_RESET :
+        {
+            BFSIM_Trace(psSIM, pc, code);
+            psSIM->event_pc = pc;
+            psSIM->count_reset = psSIM->count;
+            BFSIM_Reset(psSIM);
+            return BFSIM_EV_RESET;
+        }
+        case BFSIM_CODE_NOP :
+        {
+            pc = INC_PC(pc);
+            break;
+        }
+        default :
+        {
+            BFSIM_Trace(psSIM, pc, code);
+            psSIM->event_pc = pc;
+            return BFSIM_EV_ILLEGAL;
+        }
+    }
+    //
+    // Trace and Count
+    psSIM->ptr = ptr;
+    BFSIM_Trace(psSIM, psSIM->pc, code);
+    psSIM->pc = pc;
+    psSIM->count++;
+    return event;
+}
+
+//----------------------------------
+// Shape of the Loop at BEGIN
+//     For BFSIM_LOOP_MUL, *plo and *phi are the
+//     lowest and highest offsets the body visits.
+//----------------------------------
+static int Loop_Shape(const sOP *ops, uint32_t begin, int32_t *plo, int32_t *phi)
+{
+    uint32_t end = ops[begin].jump - 1;
+    uint32_t ip;
+    int64_t  off = 0, lo = 0, hi = 0;
+    uint32_t add = 0; // added at offset 0
+    //
+    if (ops[begin].op == OP_SCAN) return BFSIM_LOOP_SCAN;
+    if ((end == begin + 2) && (ops[begin + 1].op == OP_ADD) && ((ops[begin + 1].arg == 1) || (ops[begin + 1].arg == 0xff)))
+        return BFSIM_LOOP_CLEAR;
+    for (ip = begin + 1; ip < end; ip++)
+    {
+        if ((ops[ip].op == OP_MOVE) || (ops[ip].op == OP_SMOVE))
+        {
+            off = off + ops[ip].arg;
+            lo = (off < lo)? off : lo;
+            hi = (off > hi)? off : hi;
+        }
+        else if (ops[ip].op == OP_ADD)
+        {
+            if (off == 0) add = add + (uint32_t)ops[ip].arg;
+        }
+        else return BFSIM_LOOP_OTHER;
+    }
+    if ((off != 0) || ((add & 0xff) != 0xff) || (lo < INT32_MIN) || (hi > INT32_MAX)) return BFSIM_LOOP_OTHER;
+    *plo = (int32_t)lo;
+    *phi = (int32_t)hi;
+    return BFSIM_LOOP_MUL;
+}
+
+//----------------------------------
+// Fuse Superinstructions of Loops
+//     The ops fused stay as they are for a run
+//     entering in the middle, and for the loop
+//     bodies when a loop can't be run as a whole.
+//----------------------------------
+static void Predecode_Loops(sOP *ops, uint32_t num_op, uint32_t super)
+{
+    uint32_t ip;
+    int32_t  lo, hi;
+    int  shape;
+    //
+    for (ip = 0; ip < num_op; ip++)
+    {
+        if (ops[ip].op != OP_BEGIN) continue;
+        shape = Loop_Shape(ops, ip, &lo, &hi);
+        if ((shape == BFSIM_LOOP_CLEAR) && (super & (1 << BFSIM_SUPER_CLEAR)))
+        {
+            ops[ip].op = OP_CLEAR;
+        }
+        else if ((shape == BFSIM_LOOP_MUL) && (super & (1 << BFSIM_SUPER_MUL)))
+        {
+            ops[ip].op = OP_MUL;
+            ops[ip].arg = lo;
+            ops[ops[ip].jump - 1].arg = hi;
+        }
+    }
+}
+
+//----------------------------------
+// Span of a Basic Block at ip
+//     A straight run of two or more MOVE/ADD
+//     ops, cut where an offset would leave
+//     int32. Returns 0 if no block starts at
+//     ip (*pnext is the op to look at next).
+//----------------------------------
+#define IS_BLOCK_OP(op) (((op) == OP_ADD) || ((op) == OP_MOVE) || ((op) == OP_SMOVE))
+//
+static int Block_Span(const sOP *ops, uint32_t num_op, uint32_t ip, uint32_t *pnext)
+{
+    uint32_t next;
+    int64_t  off = 0;
+    //
+    // Not in the Bodies of fused Loops
+    if ((ops[ip].op == OP_CLEAR) || (ops[ip].op == OP_MUL)) {*pnext = ops[ip].jump; return 0;}
+    for (next = ip; (next < num_op) && (IS_BLOCK_OP(ops[next].op)); next++)
+    {
+        if (ops[next].op == OP_ADD) continue;
+        off = off + ops[next].arg;
+        if ((off > OP_RUN_MAX) || (off < -OP_RUN_MAX)) break;
+    }
+    if (next < ip + 2) {*pnext = ip + 1; return 0;}
+    *pnext = next;
+    return 1;
+}
+
+//----------------------------------
+// Compare Cells by Offset (qsort)
+//----------------------------------
+static int Cell_Compare(const void *a, const void *b)
+{
+    int32_t x = ((const sCELL*)a)->off;
+    int32_t y = ((const sCELL*)b)->off;
+    return (x > y) - (x < y);
+}
+
+//----------------------------------
+// Compile Basic Blocks
+//     The ADDs of a block are summed per offset
+//     from PTR at its start, so PTR moves only
+//     once at the end (before a loop boundary
+//     or I/O). No block if not allocated.
+//----------------------------------
+static void Predecode_Blocks(sBFSIM *psSIM)
+{
+    sOP *ops = psSIM->ops;
+    sCELL *cells;
+    sBLOCK *blk;
+    uint32_t num_block = 0;
+    uint32_t num_add = 0;
+    uint32_t ip, next, i, j, n;
+    int64_t  off;
+    //
+    // Count Blocks and their ADDs
+    for (ip = 0; ip < psSIM->num_op; ip = next)
+    {
+        if (Block_Span(ops, psSIM->num_op, ip, &next) == 0) continue;
+        num_block++;
+        for (i = ip; i < next; i++) num_add = num_add + (ops[i].op == OP_ADD);
+    }
+    if (num_block == 0) return;
+    psSIM->blocks = (sBLOCK*)malloc(sizeof(sBLOCK) * num_block);
+    psSIM->cells  = (sCELL*)malloc(sizeof(sCELL) * ((uint64_t)num_add + 1));
+    if ((psSIM->blocks == NULL) || (psSIM->cells == NULL))
+    {
+        free(psSIM->blocks);
+        free(psSIM->cells);
+        psSIM->blocks = NULL;
+        psSIM->cells = NULL;
+        return;
+    }
+    cells = psSIM->cells;
+    //
+    // Fill Blocks
+    num_block = 0;
+    n = 0;
+    for (ip = 0; ip < psSIM->num_op; ip = next)
+    {
+        if (Block_Span(ops, psSIM->num_op, ip, &next) == 0) continue;
+        blk = &psSIM->blocks[num_block];
+        memset(blk, 0, sizeof(sBLOCK));
+        blk->first = ops[ip];
+        blk->cell = n;
+        off = 0;
+        for (i = ip; i < next; i++)
+        {
+            blk->count = blk->count + ops[i].nop + ops[i].len;
+            if (ops[i].op == OP_ADD)
+            {
+                cells[n].off = (int32_t)off;
+                cells[n].delta = (uint8_t)ops[i].arg;
+                n++;
+                continue;
+            }
+            off = off + ops[i].arg;
+            blk->lo = (off < blk->lo)? off : blk->lo;
+            blk->hi = (off > blk->hi)? off : blk->hi;
+            if (ops[i].arg > 0)
+            {
+                blk->peak = ((blk->inc) && (blk->peak > off))? blk->peak : off;
+                blk->inc = 1;
+            }
+        }
+        blk->move = off;
+        //
+        // Sum per Offset (a sum of zero is dropped)
+        qsort(&cells[blk->cell], n - blk->cell, sizeof(sCELL), Cell_Compare);
+        for (i = blk->cell, j = blk->cell; i < n; i++)
+        {
+            if ((j > blk->cell) && (cells[j - 1].off == cells[i].off)) cells[j - 1].delta = cells[j - 1].delta + cells[i].delta;
+            else cells[j++] = cells[i];
+            if (cells[j - 1].delta == 0) j--;
+        }
+        n = j;
+        blk->num_cell = n - blk->cell;
+        //
+        ops[ip].op   = OP_BLOCK;
+        ops[ip].arg  = (int32_t)num_block;
+        ops[ip].jump = next;
+        num_block++;
+    }
+}
+
+//----------------------------------
+// Fuse Superinstructions of Two Ops
+//     Outside of the fused loops and blocks
+//     (WRAP is never the first).
+//----------------------------------
+#define SUPER_TABLE(name, first, second, super) {OP_##name, OP_##first, OP_##second, super},
+static const struct {uint8_t op, first, second, super;} super_pair[] = {SUPER_PAIRS(SUPER_TABLE)};
+#undef SUPER_TABLE
+//
+static void Predecode_Pairs(sOP *ops, uint32_t num_op, uint32_t super)
+{
+    uint32_t ip, i;
+    //
+    for (ip = 0; ip + 1 < num_op; ip++)
+    {
+        if ((ops[ip].op == OP_CLEAR) || (ops[ip].op == OP_MUL) || (ops[ip].op == OP_BLOCK))
+        {
+            ip = ops[ip].jump - 1;
+            continue;
+        }
+        for (i = 0; i < sizeof(super_pair) / sizeof(super_pair[0]); i++)
+        {
+            if ((super & (1 << super_pair[i].super)) == 0) continue;
+            if ((ops[ip].op != super_pair[i].first) || (ops[ip + 1].op != super_pair[i].second)) continue;
+            ops[ip].op = super_pair[i].op;
+            break;
+        }
+    }
+}
+
+//----------------------------------
+// Predecode Program for Fast Model
+//     Runs of P++/P-- and INC/DEC are fused, NOPs
+//     are dropped and brackets are resolved once.
+//     brk    : a break op is put before each
+//              breakpoint, where runs are split
+//     watch  : INC/DEC runs become OP_WADD
+//     safe   : P++/P-- runs proven not to wrap
+//              become OP_SMOVE
+//     Returns NULL if brackets are not balanced.
+//----------------------------------
+static sOP *Predecode_ROM(const unsigned char *rom, uint32_t rom_size, const uint8_t *brk, int watch,
+                          const uint8_t *safe, uint32_t *pnum)
+{
+    sOP *ops;
+    uint32_t *stack;
+    uint32_t num_begin;
+    uint32_t depth;
+    uint32_t index;
+    uint32_t pass;
+    uint32_t nop;
+    uint64_t pc;
+    uint64_t start;
+    uint64_t brk_done; // PC whose break op is put
+    unsigned char code;
+    int32_t  arg;
+    int  nowrap;
+    //
+    ops = NULL;
+    stack = NULL;
+    num_begin = 0;
+    //
+    // Pass 0 counts ops and checks brackets, Pass 1 fills ops
+    for (pass = 0; pass < 2; pass++)
+    {
+        index = 0;
+        depth = 0;
+        nop = 0;
+        brk_done = UINT64_MAX;
+        for (pc = 0; pc < rom_size; )
+        {
+            // Break before the Instruction at a Breakpoint
+            if ((IS_BRK(brk, pc)) && (brk_done != pc))
+            {
+                if (pass == 1)
+                {
+                    ops[index].op   = OP_BREAK;
+                    ops[index].arg  = 0;
+                    ops[index].jump = 0;
+                    ops[index].pc   = (uint32_t)pc;
+                    ops[index].nop  = nop;
+                    ops[index].len  = 0;
+                }
+                brk_done = pc;
+                nop = 0;
+                index++;
+                continue;
+            }
+            code = rom[pc];
+            if (code == BFSIM_CODE_NOP) {nop++; pc++; continue;}
+            start = pc;
+            arg = 0;
+            //
+            // Fused Runs
+            if ((code == BFSIM_CODE_PINC) || (code == BFSIM_CODE_PDEC))
+            {
+                nowrap = 1;
+                while ((pc < rom_size) && (rom[pc] == code) && (arg < OP_RUN_MAX) && ((pc == start) || !IS_BRK(brk, pc)))
+                {
+                    nowrap = (nowrap) && (IS_SAFE(safe, pc));
+                    arg++;
+                    pc++;
+                }
+                if (code == BFSIM_CODE_PDEC) arg = -arg;
+                code = (nowrap)? OP_SMOVE : OP_MOVE;
+            }
+            else if ((code == BFSIM_CODE_INC) || (code == BFSIM_CODE_DEC))
+            {
+                while ((pc < rom_size) && ((rom[pc] == BFSIM_CODE_INC) || (rom[pc] == BFSIM_CODE_DEC)) && (pc - start < OP_RUN_MAX)
+                    && ((pc == start) || !IS_BRK(brk, pc)))
+                {
+                    arg = (arg + ((rom[pc] == BFSIM_CODE_INC)? 1 : -1)) & 0x0ff;
+                    pc++;
+                }
+                code = (watch)? OP_WADD : OP_ADD;
+            }
+            else
+            {
+                pc++;
+                     if (code == BFSIM_CODE_OUT  ) code = OP_OUT;
+                else if (code == BFSIM_CODE_IN   ) code = OP_IN;
+                else if (code == BFSIM_CODE_RESET) code = OP_RESET;
+                else if (code == BFSIM_CODE_BEGIN)
+                {
+                    if (pass == 1) stack[depth] = index;
+                    depth++;
+                    code = OP_BEGIN;
+                }
+                else if (code == BFSIM_CODE_END)
+                {
+                    if (depth == 0) {free(ops); free(stack); return NULL;}
+                    depth--;
+                    if (pass == 1)
+                    {
+                        ops[stack[depth]].jump = index + 1;
+                        ops[index].jump = stack[depth] + 1;
+                        //
+                        // [>>..] or [<<..] becomes a Scan (body ops stay for entry in the loop)
+                        if ((stack[depth] + 2 == index) && (ops[index - 1].op == OP_MOVE))
+                        {
+                            ops[stack[depth]].op  = OP_SCAN;
+                            ops[stack[depth]].arg = ops[index - 1].arg;
+                        }
+                    }
+                    code = OP_END;
+                }
+                else
+                {
+                    arg = code;
+                    code = OP_ILLEGAL;
+                }
+            }
+            //
+            // Emit
+            if (pass == 1)
+            {
+                ops[index].op  = code;
+                ops[index].arg = arg;
+                ops[index].pc  = (uint32_t)start;
+                ops[index].nop = nop;
+                ops[index].len = (uint32_t)(pc - start);
+                if ((code != OP_BEGIN) && (code != OP_END) && (code != OP_SCAN)) ops[index].jump = 0;
+            }
+            if ((pass == 0) && (code == OP_BEGIN)) num_begin++;
+            nop = 0;
+            index++;
+        }
+        if (depth != 0) {free(ops); free(stack); return NULL;}
+        //
+        // Wrap Around to PC=0 (after the trailing NOPs)
+        if (pass == 1)
+        {
+            ops[index].op   = OP_WRAP;
+            ops[index].arg  = 0;
+            ops[index].jump = 0;
+            ops[index].pc   = rom_size;
+            ops[index].nop  = nop;
+            ops[index].len  = 0;
+        }
+        index++;
+        //
+        // Allocate after Pass 0
+        if (pass == 0)
+        {
+            ops   = (sOP*)malloc(sizeof(sOP) * index);
+            stack = (uint32_t*)malloc(sizeof(uint32_t) * (num_begin + 1));
+            if ((ops == NULL) || (stack == NULL)) {free(ops); free(stack); return NULL;}
+        }
+    }
+    free(stack);
+    *pnum = index;
+    return ops;
+}
+
+//----------------------------------
+// Kind of an Op in the Profile
+//     Returns -1 if not counted in pairs.
+//----------------------------------
+static int Profile_Op(uint8_t op)
+{
+    switch(op)
+    {
+        case OP_MOVE  :
+        case OP_SMOVE : return BFSIM_PROF_MOVE;
+        case OP_ADD   :
+        case OP_WADD  : return BFSIM_PROF_ADD;
+        case OP_OUT   : return BFSIM_PROF_OUT;
+        case OP_BEGIN : return BFSIM_PROF_BEGIN;
+        case OP_END   : return BFSIM_PROF_END;
+        case OP_SCAN  : return BFSIM_PROF_SCAN;
+        default       : return -1;
+    }
+}
+
+//----------------------------------
+// Count an Op Pair run n times
+//     Also counted as dispatches saved by
+//     the superinstruction fusing it.
+//----------------------------------
+static void Profile_Pair(sBFSIM_PROFILE *psPROF, const sOP *ops, uint32_t ip, uint32_t next, uint64_t n)
+{
+    int  from = Profile_Op(ops[ip].op);
+    int  to   = Profile_Op(ops[next].op);
+    uint32_t i;
+    //
+    if ((n == 0) || (from < 0) || (to < 0)) return;
+    psPROF->pair[from][to] = psPROF->pair[from][to] + n;
+    for (i = 0; i < sizeof(super_pair) / sizeof(super_pair[0]); i++)
+    {
+        if ((ops[ip].op == super_pair[i].first) && (ops[next].op == super_pair[i].second))
+            psPROF->save[super_pair[i].super] = psPROF->save[super_pair[i].super] + n;
+    }
+}
+
+//----------------------------------
+// Count Ops run in a Loop
+//     Kept for the hottest loops only,
+//     hottest first.
+//----------------------------------
+static void Profile_Hot(sBFSIM_PROFILE *psPROF, uint32_t pc, int shape, uint64_t n)
+{
+    uint32_t i;
+    //
+    for (i = 0; (i < psPROF->num_hot) && (psPROF->hot_pc[i] != pc); i++);
+    if (i < psPROF->num_hot)
+    {
+        n = n + psPROF->hot_ops[i];
+    }
+    else if (psPROF->num_hot < BFSIM_PROF_HOT)
+    {
+        i = psPROF->num_hot++;
+    }
+    else
+    {
+        i = BFSIM_PROF_HOT - 1;
+        if (n <= psPROF->hot_ops[i]) return;
+    }
+    // Move up to its Place
+    for (; (i > 0) && (psPROF->hot_ops[i - 1] < n); i--)
+    {
+        psPROF->hot_pc   [i] = psPROF->hot_pc   [i - 1];
+        psPROF->hot_shape[i] = psPROF->hot_shape[i - 1];
+        psPROF->hot_ops  [i] = psPROF->hot_ops  [i - 1];
+    }
+    psPROF->hot_pc   [i] = pc;
+    psPROF->hot_shape[i] = shape;
+    psPROF->hot_ops  [i] = n;
+}
+
+//----------------------------------
+// Add the Counters to a Profile
+//     Where a branch went is told by the
+//     count of END taken: the body of a loop
+//     is entered from BEGIN or from END.
+//----------------------------------
+static void Profile_Fold(const sBFSIM *psSIM, sBFSIM_PROFILE *psPROF)
+{
+    const sOP *ops = psSIM->ops;
+    const uint64_t *runs  = psSIM->prof;
+    const uint64_t *taken = psSIM->prof + psSIM->num_op;
+    uint64_t n, in, inside;
+    uint32_t ip, ip2, end;
+    int32_t  lo, hi;
+    int  shape;
+    //
+    for (ip = 0; ip < psSIM->num_op; ip++)
+    {
+        n = runs[ip];
+        if (n == 0) continue;
+        psPROF->ops = psPROF->ops + n;
+        switch(ops[ip].op)
+        {
+            case OP_BEGIN :
+            case OP_SCAN  :
+            {
+                end = ops[ip].jump - 1;
+                in = (ops[ip].op == OP_SCAN)? 0 : runs[ip + 1] - ((runs[ip + 1] > taken[end])? taken[end] : runs[ip + 1]);
+                in = (in < n)? in : n;
+                Profile_Pair(psPROF, ops, ip, ip + 1, in);
+                Profile_Pair(psPROF, ops, ip, ops[ip].jump, n - in);
+                //
+                // Loop Shape
+                shape = Loop_Shape(ops, ip, &lo, &hi);
+                for (inside = 0, ip2 = ip + 1; ip2 <= end; ip2++) inside = inside + runs[ip2];
+                psPROF->loop_num  [shape]++;
+                psPROF->loop_entry[shape] = psPROF->loop_entry[shape] + n;
+                psPROF->loop_iter [shape] = psPROF->loop_iter [shape] + ((shape == BFSIM_LOOP_SCAN)? 0 : runs[end]);
+                if (shape == BFSIM_LOOP_CLEAR) psPROF->save[BFSIM_SUPER_CLEAR] = psPROF->save[BFSIM_SUPER_CLEAR] + inside;
+                if (shape == BFSIM_LOOP_MUL  ) psPROF->save[BFSIM_SUPER_MUL  ] = psPROF->save[BFSIM_SUPER_MUL  ] + inside;
+                Profile_Hot(psPROF, ops[ip].pc, shape, n + inside);
+                break;
+            }
+            case OP_END :
+            {
+                in = (taken[ip] < n)? taken[ip] : n;
+                Profile_Pair(psPROF, ops, ip, ops[ip].jump, in);
+                Profile_Pair(psPROF, ops, ip, ip + 1, n - in);
+                break;
+            }
+            case OP_WRAP : break;
+            default :
+            {
+                Profile_Pair(psPROF, ops, ip, ip + 1, n);
+                break;
+            }
+        }
+    }
+}
+
+//----------------------------------
+// Predecode the Machine's ROM
+//     Leaves ops NULL if brackets are not balanced.
+//----------------------------------
+static void BFSIM_Predecode(sBFSIM *psSIM)
+{
+    psSIM->ops_tried = 1;
+    psSIM->ops = Predecode_ROM(psSIM->rom, psSIM->rom_size, (psSIM->num_brk)? psSIM->brk : NULL, psSIM->num_watch,
+                               psSIM->safe, &psSIM->num_op);
+    if (psSIM->ops == NULL) return;
+    //
+    // Counters of the Profile (not profiled if not allocated),
+    // counting the ops as predecoded
+    if (psSIM->profile)
+    {
+        psSIM->prof = (uint64_t*)calloc((uint64_t)psSIM->num_op * 2, sizeof(uint64_t));
+        return;
+    }
+    //
+    // Fused Loops, Basic Blocks, then Pairs outside of them
+    if (psSIM->super) Predecode_Loops(psSIM->ops, psSIM->num_op, psSIM->super);
+    Predecode_Blocks(psSIM);
+    if (psSIM->super) Predecode_Pairs(psSIM->ops, psSIM->num_op, psSIM->super);
+}
+
+//----------------------------------
+// Predecode again before the next Run
+//     (breakpoints or watchpoints changed)
+//----------------------------------
+static void BFSIM_Repredecode(sBFSIM *psSIM)
+{
+    if (psSIM->prof) Profile_Fold(psSIM, psSIM->profile);
+    free(psSIM->prof);
+    psSIM->prof = NULL;
+    free(psSIM->ops);
+    free(psSIM->blocks);
+    free(psSIM->cells);
+    psSIM->ops = NULL;
+    psSIM->blocks = NULL;
+    psSIM->cells = NULL;
+    psSIM->num_op = 0;
+    psSIM->ops_tried = 0;
+}
+
+//----------------------------------
+// PC where an Op starts (its leading NOPs)
+//----------------------------------
+static uint32_t BFSIM_Op_PC(sBFSIM *psSIM, uint32_t ip)
+{
+    uint32_t pc = psSIM->ops[ip].pc - psSIM->ops[ip].nop;
+    return (pc >= psSIM->rom_size)? 0 : pc;
+}
+
+//----------------------------------
+// Find the Op starting at PC
+//     Returns 0 if PC is inside a fused op.
+//     *pdone is the number of leading NOPs
+//     already executed.
+//----------------------------------
+static int Find_Op(const sOP *ops, uint32_t num_op, uint32_t pc, uint32_t *pip, uint32_t *pdone)
+{
+    uint32_t lo = 0;
+    uint32_t hi = num_op - 1; // WRAP
+    uint32_t mid;
+    //
+    // First op with ops[].pc >= pc
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (ops[mid].pc < pc) lo = mid + 1; else hi = mid;
+    }
+    if (pc < ops[lo].pc - ops[lo].nop) return 0;
+    *pip = lo;
+    *pdone = pc - (ops[lo].pc - ops[lo].nop);
+    return 1;
+}
+
+//----------------------------------
+// Highest Pointer visited by P++ x dist
+//----------------------------------
+static inline uint32_t Max_Visited(uint32_t ptr, uint64_t dist, uint32_t size)
+{
+    if (dist == 0) return 0;
+    if (dist >= size) return size - 1;
+    if ((uint64_t)ptr + dist < size) return (uint32_t)(ptr + dist);
+    if (ptr < size - 1) return size - 1;
+    return (uint32_t)(dist - 1);
+}
+
+//----------------------------------
+// Add to Pointer on the Ring
+//----------------------------------
+static inline uint32_t Ring_Add(uint32_t ptr, uint32_t step, uint32_t size)
+{
+    uint64_t next = (uint64_t)ptr + step;
+    if (next < size) return (uint32_t)next;
+    next = next - size;
+    return (next < size)? (uint32_t)next : (uint32_t)(next % size);
+}
+
+//----------------------------------
+// Scan Right by stride until Zero
+//     Returns distance, or UINT64_MAX if never.
+//     On the mirrored ring a whole lap is one
+//     contiguous range, so no wrap check is done
+//     inside the loop.
+//----------------------------------
+static uint64_t Scan_Right(sRING *psRING, uint32_t ptr, uint32_t stride)
+{
+    unsigned char *ram = psRING->mem;
+    uint64_t size = psRING->size;
+    uint64_t q, start, end, dist;
+    unsigned char *hit;
+    //
+    if (ram[ptr] == 0) return 0;
+    if (stride == 0) return UINT64_MAX;
+    dist = 0;
+    q = ptr;
+    while (dist < size * stride)
+    {
+        start = q;
+        end = (psRING->mirrored)? q + size : size;
+        if (stride == 1)
+        {
+            hit = (unsigned char*)memchr(ram + q, 0, (size_t)(end - q));
+            q = (hit)? (uint64_t)(hit - ram) : end;
+        }
+        else
+        {
+            while ((q < end) && (ram[q] != 0)) q = q + stride;
+        }
+        if (q < end) return dist + (q - start);
+        dist = dist + (q - start);
+        q = q % size;
+    }
+    return UINT64_MAX;
+}
+
+//----------------------------------
+// Scan Left by stride until Zero
+//     Returns distance, or UINT64_MAX if never.
+//----------------------------------
+static uint64_t Scan_Left(sRING *psRING, uint32_t ptr, uint32_t stride)
+{
+    unsigned char *ram = psRING->mem;
+    int64_t  size = (int64_t)psRING->size;
+    int64_t  q, start, low;
+    uint64_t dist;
+    unsigned char *hit;
+    //
+    if (ram[ptr] == 0) return 0;
+    if (stride == 0) return UINT64_MAX;
+    dist = 0;
+    q = ptr;
+    while (dist < (uint64_t)size * stride)
+    {
+        // Search down from q to low (exclusive)
+        if (psRING->mirrored) {q = q + size; low = q - size;}
+        else low = -1;
+        start = q;
+        if (stride == 1)
+        {
+            hit = MEM_Rchr(ram + low + 1, 0, (uint64_t)(q - low));
+            q = (hit)? (int64_t)(hit - ram) : low;
+        }
+        else
+        {
+            while ((q > low) && (ram[q] != 0)) q = q - stride;
+        }
+        if (q > low) return dist + (uint64_t)(start - q);
+        dist = dist + (uint64_t)(start - q);
+        q = ((q % size) + size) % size;
+    }
+    return UINT64_MAX;
+}
+
+//----------------------------------
+// Handlers of the Fast Model
+//     Each runs the op o, then goes on with
+//     the next op (continue), or stops the
+//     run (break) with an event. A super-
+//     instruction runs two of them in a row
+//     without going back to the dispatch.
+//----------------------------------
+#define FAST_MOVE(o) \
+{ \
+    count = count + (o)->nop + (o)->len; \
+    if ((o)->arg > 0) \
+    { \
+        step = (uint32_t)(o)->arg; \
+        if ((cover) && ((uint64_t)ptr + step >= size)) Cover(psSIM, (o)->pc, COVER_WRAP); \
+        visit = Max_Visited(ptr, step, size); \
+        psSIM->maxptr = (visit > psSIM->maxptr)? visit : psSIM->maxptr; \
+        ptr = Ring_Add(ptr, step, size); \
+    } \
+    else \
+    { \
+        step = (uint32_t)(-(o)->arg); \
+        if ((cover) && (step > ptr)) Cover(psSIM, (o)->pc, COVER_WRAP); \
+        step = (step < size)? step : step % size; \
+        ptr = (ptr >= step)? ptr - step : ptr + (size - step); \
+    } \
+    ip++; \
+}
+//
+#define FAST_SMOVE(o) \
+{ \
+    count = count + (o)->nop + (o)->len; \
+    ptr = ptr + (uint32_t)(o)->arg; \
+    psSIM->maxptr = (ptr > psSIM->maxptr)? ptr : psSIM->maxptr; \
+    ip++; \
+}
+//
+#define FAST_ADD(o) \
+{ \
+    count = count + (o)->nop + (o)->len; \
+    if ((cover) && (((o)->arg > 0)? (ram[ptr] + (o)->arg > 0xff) : (ram[ptr] < -(o)->arg))) \
+        Cover(psSIM, (o)->pc, COVER_OVF); \
+    ram[ptr] = ram[ptr] + (unsigned char)(o)->arg; \
+    ip++; \
+}
+//
+#define FAST_BEGIN(o) \
+{ \
+    count = count + (o)->nop + (o)->len; \
+    if (cover) Cover(psSIM, (o)->pc, (ram[ptr] == 0)? COVER_JUMP : COVER_NEXT); \
+    ip = (ram[ptr] == 0)? (o)->jump : ip + 1; \
+    continue; \
+}
+//
+#define FAST_END(o) \
+{ \
+    count = count + (o)->nop + (o)->len; \
+    if (cover) Cover(psSIM, (o)->pc, (ram[ptr] != 0)? COVER_JUMP : COVER_NEXT); \
+    if (ram[ptr] == 0) {ip++; continue;} \
+    if (profile) psSIM->prof[psSIM->num_op + ip]++; \
+    ip = (o)->jump; \
+    if (count >= limit) {event = BFSIM_EV_LIMIT; break;} \
+    if (atomic_load_explicit(&psSIM->stop, memory_order_relaxed) == 0) continue; \
+    event = BFSIM_EV_STOP; \
+    break; \
+}
+
+//----------------------------------
+// Run Fast Model
+//     Runs from the op at ip until an event.
+//     Instruction count, PTR wrap and MAXPTR
+//     are the same as executing one by one.
+//     Made twice, with and without counting
+//     ops for the profile.
+//----------------------------------
+static inline __attribute__((always_inline)) int Run_Fast(sBFSIM *psSIM, uint32_t ip, const int profile)
+{
+    unsigned char *ram = psSIM->ring.mem;
+    uint32_t size = psSIM->ram_size;
+    uint32_t ptr = psSIM->ptr;
+    uint64_t count = psSIM->count;
+    uint64_t limit = psSIM->limit;
+    unsigned char *cover = psSIM->cover;
+    uint32_t step;
+    uint32_t visit;
+    uint64_t dist;
+    uint64_t iter;
+    uint64_t body;
+    int64_t  off;
+    sOP *op;
+    sOP *end;
+    sBLOCK *blk;
+    sCELL *cell;
+    sCELL *last;
+    unsigned char *base;
+    int  event;
+    //
+    while(1)
+    {
+        op = &psSIM->ops[ip];
+        if (profile) psSIM->prof[ip]++;
+        switch(op->op)
+        {
+            case OP_MOVE  : FAST_MOVE(op);  continue;
+            case OP_SMOVE : FAST_SMOVE(op); continue;
+            case OP_ADD   : FAST_ADD(op);   continue;
+            case OP_BEGIN : FAST_BEGIN(op);
+            case OP_END   : FAST_END(op);
+            //
+            // Superinstructions of Two Ops
+#define SUPER_CASE(name, first, second, super) \
+            case OP_##name : {FAST_##first(op); op++; FAST_##second(op); continue;}
+            SUPER_PAIRS(SUPER_CASE)
+#undef SUPER_CASE
+            //
+            case OP_CLEAR :
+            {
+                // BEGIN, then iter x (ADD, END)
+                if ((ram[ptr] == 0) || (cover)) FAST_BEGIN(op);
+                iter = (op[1].arg == 1)? 256 - ram[ptr] : ram[ptr];
+                count = count + op->nop + op->len + iter * (op[1].nop + op[1].len + op[2].nop + op[2].len);
+                ram[ptr] = 0;
+                ip = op->jump;
+                continue;
+            }
+            case OP_MUL :
+            {
+                // BEGIN, then iter x (body, END), if the body doesn't wrap
+                end = &psSIM->ops[op->jump - 1];
+                if ((ram[ptr] == 0) || (cover) || ((int64_t)ptr + op->arg < 0) || ((int64_t)ptr + end->arg >= size))
+                    FAST_BEGIN(op);
+                iter = ram[ptr];
+                off = 0;
+                body = end->nop + end->len;
+                for (op = op + 1; op < end; op++)
+                {
+                    body = body + op->nop + op->len;
+                    if (op->op == OP_ADD)
+                    {
+                        if (off) ram[ptr + off] = ram[ptr + off] + (unsigned char)(op->arg * iter);
+                    }
+                    else off = off + op->arg;
+                }
+                count = count + psSIM->ops[ip].nop + psSIM->ops[ip].len + iter * body;
+                if ((psSIM->ops[ip].arg < 0) || (end->arg > 0)) // highest offset is reached by P++
+                    psSIM->maxptr = (ptr + end->arg > psSIM->maxptr)? ptr + end->arg : psSIM->maxptr;
+                ram[ptr] = 0;
+                ip = psSIM->ops[ip].jump;
+                continue;
+            }
+            case OP_BLOCK :
+            {
+                // Its first op, then the others one by one, if the block would wrap
+                blk = &psSIM->blocks[op->arg];
+                if ((cover) || ((int64_t)ptr + blk->lo < 0) || ((int64_t)ptr + blk->hi >= size))
+                {
+                    if      (blk->first.op == OP_ADD  ) {FAST_ADD(&blk->first);}
+                    else if (blk->first.op == OP_SMOVE) {FAST_SMOVE(&blk->first);}
+                    else                                {FAST_MOVE(&blk->first);}
+                    continue;
+                }
+                base = ram + ptr;
+                last = &psSIM->cells[blk->cell + blk->num_cell];
+                for (cell = &psSIM->cells[blk->cell]; cell < last; cell++)
+                    base[cell->off] = base[cell->off] + cell->delta;
+                if ((blk->inc) && ((int64_t)ptr + blk->peak > psSIM->maxptr)) psSIM->maxptr = (uint32_t)(ptr + blk->peak);
+                ptr = (uint32_t)(ptr + blk->move);
+                count = count + blk->count;
+                ip = op->jump;
+                continue;
+            }
+            case OP_WADD :
+            {
+                count = count + op->nop + op->len;
+                if ((cover) && ((op->arg > 0)? (ram[ptr] + op->arg > 0xff) : (ram[ptr] < -op->arg)))
+                    Cover(psSIM, op->pc, COVER_OVF);
+                psSIM->data = ram[ptr];
+                ram[ptr] = ram[ptr] + (unsigned char)op->arg;
+                ip++;
+                if ((ram[ptr] == psSIM->data) || (BFSIM_Watched(psSIM, ptr) == 0)) continue;
+                psSIM->event_pc = op->pc;
+                event = BFSIM_EV_WATCH;
+                break;
+            }
+            case OP_BREAK :
+            {
+                // Stop before the next op, or pass when resumed
+                if (psSIM->skip_brk == 0)
+                {
+                    psSIM->skip_brk = 1;
+                    psSIM->event_pc = op->pc;
+                    psSIM->pc = op->pc;
+                    psSIM->ptr = ptr;
+                    psSIM->count = count + op->nop;
+                    return BFSIM_EV_BREAK;
+                }
+                psSIM->skip_brk = 0;
+                count = count + op->nop;
+                ip++;
+                continue;
+            }
+            case OP_SCAN :
+            {
+                // BEGIN, then iter x (MOVE, END)
+                if (ram[ptr] == 0)
+                {
+                    count = count + op->nop + op->len;
+                    if (cover) Cover(psSIM, op->pc, COVER_JUMP);
+                    ip = op->jump;
+                    continue;
+                }
+                if (op->arg > 0)
+                {
+                    step = (uint32_t)op->arg % size;
+                    dist = Scan_Right(&psSIM->ring, ptr, step);
+                    if (dist == UINT64_MAX) {psSIM->maxptr = size - 1; event = BFSIM_EV_HANG; break;}
+                    iter = dist / step;
+                    if ((cover) && ((uint64_t)ptr + dist >= size)) Cover(psSIM, op[1].pc, COVER_WRAP);
+                    visit = (iter >= size)? size - 1 : Max_Visited(ptr, iter * (uint64_t)op->arg, size);
+                    psSIM->maxptr = (visit > psSIM->maxptr)? visit : psSIM->maxptr;
+                    ptr = (uint32_t)(((uint64_t)ptr + dist) % size);
+                }
+                else
+                {
+                    step = (uint32_t)(-op->arg) % size;
+                    dist = Scan_Left(&psSIM->ring, ptr, step);
+                    if (dist == UINT64_MAX) {event = BFSIM_EV_HANG; break;}
+                    iter = dist / step;
+                    if ((cover) && (dist > ptr)) Cover(psSIM, op[1].pc, COVER_WRAP);
+                    dist = dist % size;
+                    ptr = (ptr >= dist)? ptr - (uint32_t)dist : ptr + (size - (uint32_t)dist);
+                }
+                count = count + op->nop + op->len
+                      + iter * (op[1].nop + op[1].len + op[2].nop + op[2].len);
+                if (cover)
+                {
+                    // Same edges as executed one by one
+                    Cover(psSIM, op->pc, COVER_NEXT);
+                    if (iter > 1) Cover(psSIM, op[2].pc, COVER_JUMP);
+                    if (iter > 2) Cover(psSIM, op[2].pc, COVER_JUMP);
+                    Cover(psSIM, op[2].pc, COVER_NEXT);
+                }
+                ip = op->jump;
+                continue;
+            }
+            case OP_WRAP :
+            {
+                count = count + op->nop;
+                ip = 0;
+                if (count >= limit) {event = BFSIM_EV_LIMIT; break;}
+                if (atomic_load_explicit(&psSIM->stop, memory_order_relaxed) == 0) continue;
+                event = BFSIM_EV_STOP;
+                break;
+            }
+            case OP_OUT :
+            {
+                count = count + op->nop + op->len;
+                psSIM->event_pc = op->pc;
+                psSIM->data = ram[ptr];
+                ip++;
+                event = BFSIM_EV_OUT;
+                break;
+            }
+            case OP_RESET :
+            {
+                psSIM->event_pc = op->pc;
+                psSIM->ptr = ptr;
+                psSIM->count_reset = count + op->nop;
+                BFSIM_Reset(psSIM);
+                return BFSIM_EV_RESET;
+            }
+            // OP_IN, OP_ILLEGAL (not executed here)
+            default :
+            {
+                count = count + op->nop;
+                psSIM->event_pc = op->pc;
+                psSIM->pc = op->pc;
+                psSIM->ptr = ptr;
+                psSIM->count = count;
+                if (op->op == OP_IN)
+                {
+                    psSIM->wait_in = 1;
+                    return BFSIM_EV_IN;
+                }
+                return BFSIM_EV_ILLEGAL;
+            }
+        }
+        break;
+    }
+    //
+    // Write Back
+    psSIM->pc = (event == BFSIM_EV_HANG)? op->pc : BFSIM_Op_PC(psSIM, ip);
+    psSIM->ptr = ptr;
+    psSIM->count = (event == BFSIM_EV_HANG)? count + op->nop : count;
+    return event;
+}
+//
+static int BFSIM_Run_Fast(sBFSIM *psSIM, uint32_t ip)
+{
+    return Run_Fast(psSIM, ip, 0);
+}
+//
+static int BFSIM_Run_Profile(sBFSIM *psSIM, uint32_t ip)
+{
+    return Run_Fast(psSIM, ip, 1);
+}
+
+//----------------------------------
+// Run
+//     Runs max_steps instructions (0: no limit)
+//     or until an event. Also stops at the
+//     count given by BFSIM_Set_Limit().
+//----------------------------------
+int BFSIM_Run(sBFSIM *psSIM, uint64_t max_steps)
+{
+    uint64_t steps;
+    uint32_t ip;
+    uint32_t done;
+    int  event;
+    //
+    if (psSIM->wait_in) return BFSIM_EV_IN;
+    //
+    // Fast Model if not traced (breakpoints and watchpoints are ops)
+    if ((max_steps == 0) && (psSIM->trace == NULL))
+    {
+        if (psSIM->ops_tried == 0) BFSIM_Predecode(psSIM);
+        if (psSIM->ops)
+        {
+            // Step to the Boundary of an Op
+            while (Find_Op(psSIM->ops, psSIM->num_op, psSIM->pc, &ip, &done) == 0)
+            {
+                event = BFSIM_Step_One(psSIM);
+                if (event >= 0) return event;
+            }
+            if (atomic_exchange(&psSIM->stop, 0)) return BFSIM_EV_STOP;
+            psSIM->count = psSIM->count - done;
+            event = (psSIM->prof)? BFSIM_Run_Profile(psSIM, ip) : BFSIM_Run_Fast(psSIM, ip);
+            if (event == BFSIM_EV_STOP) atomic_store(&psSIM->stop, 0);
+            return event;
+        }
+    }
+    //
+    // Execute One by One
+    for (steps = 0; (max_steps == 0) || (steps < max_steps); steps++)
+    {
+        if (psSIM->count >= psSIM->limit) return BFSIM_EV_LIMIT;
+        if (atomic_exchange(&psSIM->stop, 0)) return BFSIM_EV_STOP;
+        event = BFSIM_Step_One(psSIM);
+        if (event >= 0) return event;
+    }
+    return BFSIM_EV_LIMIT;
+}
+
+//----------------------------------
+// Step One Instruction
+//----------------------------------
+int BFSIM_Step(sBFSIM *psSIM)
+{
+    return BFSIM_Run(psSIM, 1);
+}
+
+//----------------------------------
+// Request to Stop
+//     Safe to call from a signal handler
+//     or from another thread.
+//----------------------------------
+void BFSIM_Stop(sBFSIM *psSIM)
+{
+    atomic_store(&psSIM->stop, 1);
+}
+
+//----------------------------------
+// Cancel a Request to Stop
+//     For a request made while the machine
+//     was not running. Returns 1 if pending.
+//----------------------------------
+int BFSIM_Cancel_Stop(sBFSIM *psSIM)
+{
+    return atomic_exchange(&psSIM->stop, 0);
+}
+
+//----------------------------------
+// Feed Input Data to the waiting IN
+//----------------------------------
+int BFSIM_Feed_Input(sBFSIM *psSIM, unsigned char data)
+{
+    if (psSIM->wait_in == 0) return BFSIM_ERR_STATE;
+    psSIM->wait_in = 0;
+    psSIM->ring.mem[psSIM->ptr] = data;
+    BFSIM_Trace(psSIM, psSIM->pc, BFSIM_CODE_IN);
+    psSIM->pc = INC_PC(psSIM->pc);
+    psSIM->count++;
+    return BFSIM_OK;
+}
+
+//----------------------------------
+// Get Machine State
+//----------------------------------
+void BFSIM_Get_State(const sBFSIM *psSIM, sBFSIM_STATE *psSTATE)
+{
+    psSTATE->pc       = psSIM->pc;
+    psSTATE->code     = psSIM->rom[psSIM->pc];
+    psSTATE->ptr      = psSIM->ptr;
+    psSTATE->maxptr   = psSIM->maxptr;
+    psSTATE->count    = psSIM->count;
+    psSTATE->count_reset = psSIM->count_reset;
+    psSTATE->event_pc = psSIM->event_pc;
+    psSTATE->data     = psSIM->data;
+    psSTATE->wait_in  = psSIM->wait_in;
+}
+
+//----------------------------------
+// Get RAM (read / write)
+//----------------------------------
+unsigned char *BFSIM_Get_RAM(sBFSIM *psSIM, uint32_t *psize)
+{
+    if (psize) *psize = psSIM->ram_size;
+    return psSIM->ring.mem;
+}
+
+//----------------------------------
+// Set or Clear a Breakpoint
+//----------------------------------
+int BFSIM_Set_Break(sBFSIM *psSIM, uint32_t pc, int enable)
+{
+    uint8_t mask;
+    //
+    if (pc >= psSIM->rom_size) return BFSIM_ERR_RANGE;
+    if (psSIM->brk == NULL)
+    {
+        if (enable == 0) return BFSIM_OK;
+        psSIM->brk = (uint8_t*)calloc(((uint64_t)psSIM->rom_size + 7) / 8, 1);
+        if (psSIM->brk == NULL) return BFSIM_ERR_RANGE;
+    }
+    mask = (uint8_t)(1 << (pc & 7));
+    if ((enable) && ((psSIM->brk[pc >> 3] & mask) == 0))
+    {
+        psSIM->brk[pc >> 3] |= mask;
+        psSIM->num_brk++;
+        BFSIM_Repredecode(psSIM);
+    }
+    else if ((enable == 0) && (psSIM->brk[pc >> 3] & mask))
+    {
+        psSIM->brk[pc >> 3] &= (uint8_t)~mask;
+        psSIM->num_brk--;
+        BFSIM_Repredecode(psSIM);
+    }
+    return BFSIM_OK;
+}
+
+//----------------------------------
+// Set or Clear a Watchpoint
+//     Stops after INC/DEC changed the cell,
+//     state.data has the value before.
+//     Returns BFSIM_ERR_RANGE if addr is out
+//     of RAM or BFSIM_WATCH_MAX are set.
+//----------------------------------
+int BFSIM_Set_Watch(sBFSIM *psSIM, uint32_t addr, int enable)
+{
+    uint32_t i;
+    //
+    if (addr >= psSIM->ram_size) return BFSIM_ERR_RANGE;
+    for (i = 0; i < psSIM->num_watch; i++)
+    {
+        if (psSIM->watch[i] == addr) break;
+    }
+    if ((enable) && (i == psSIM->num_watch))
+    {
+        if (psSIM->num_watch == BFSIM_WATCH_MAX) return BFSIM_ERR_RANGE;
+        if (psSIM->watch_page == NULL)
+        {
+            psSIM->watch_page = (uint8_t*)calloc(((uint64_t)psSIM->ram_size >> WATCH_SHIFT) + 1, 1);
+            if (psSIM->watch_page == NULL) return BFSIM_ERR_RANGE;
+        }
+        psSIM->watch[psSIM->num_watch++] = addr;
+        psSIM->watch_page[addr >> WATCH_SHIFT]++;
+        if (psSIM->num_watch == 1) BFSIM_Repredecode(psSIM);
+    }
+    else if ((enable == 0) && (i < psSIM->num_watch))
+    {
+        psSIM->watch[i] = psSIM->watch[--psSIM->num_watch];
+        psSIM->watch_page[addr >> WATCH_SHIFT]--;
+        if (psSIM->num_watch == 0) BFSIM_Repredecode(psSIM);
+    }
+    return BFSIM_OK;
+}
+
+//----------------------------------
+// Set Trace Function (NULL to remove)
+//----------------------------------
+void BFSIM_Set_Trace(sBFSIM *psSIM, BFSIM_TRACE_FUNC func, void *user)
+{
+    psSIM->trace = func;
+    psSIM->trace_user = user;
+}
+
+//----------------------------------
+// Set Instruction Limit (0 to remove)
+//     The fast model checks it where a
+//     loop jumps back, so count can be a
+//     little beyond max_count.
+//----------------------------------
+void BFSIM_Set_Limit(sBFSIM *psSIM, uint64_t max_count)
+{
+    psSIM->limit = (max_count)? max_count : UINT64_MAX;
+}
+
+//----------------------------------
+// Set Coverage Map (NULL to remove)
+//     map has BFSIM_COVER_SIZE counters,
+//     which are incremented (not cleared).
+//----------------------------------
+void BFSIM_Set_Cover(sBFSIM *psSIM, unsigned char *map)
+{
+    psSIM->cover = map;
+    psSIM->cover_prev = 0;
+}
+
+//----------------------------------
+// Restart from the State after Create
+//----------------------------------
+void BFSIM_Restart(sBFSIM *psSIM)
+{
+    BFSIM_Reset(psSIM);
+    psSIM->pc = psSIM->entry;
+    psSIM->maxptr = 0;
+    psSIM->count_reset = 0;
+    psSIM->event_pc = 0;
+    psSIM->data = 0;
+    psSIM->wait_in = 0;
+    psSIM->skip_brk = 0;
+    psSIM->cover_prev = 0;
+    atomic_store(&psSIM->stop, 0);
+}
+
+//----------------------------------
+// Start or Stop Profiling
+//     Counts the ops of the fast model from
+//     zero. Superinstructions are not fused,
+//     nor basic blocks compiled, while profiling.
+//----------------------------------
+int BFSIM_Set_Profile(sBFSIM *psSIM, int enable)
+{
+    BFSIM_Repredecode(psSIM);
+    free(psSIM->profile);
+    psSIM->profile = NULL;
+    if (enable == 0) return BFSIM_OK;
+    psSIM->profile = (sBFSIM_PROFILE*)calloc(1, sizeof(sBFSIM_PROFILE));
+    return (psSIM->profile)? BFSIM_OK : BFSIM_ERR_MEM;
+}
+
+//----------------------------------
+// Get the Profile so far
+//----------------------------------
+void BFSIM_Get_Profile(sBFSIM *psSIM, sBFSIM_PROFILE *psPROF)
+{
+    if (psSIM->profile == NULL) {memset(psPROF, 0, sizeof(sBFSIM_PROFILE)); return;}
+    *psPROF = *psSIM->profile;
+    if (psSIM->prof) Profile_Fold(psSIM, psPROF);
+}
+
+//----------------------------------
+// Select Superinstructions from a Profile
+//     Those saving at least permille of
+//     the ops run in the profile.
+//----------------------------------
+uint32_t BFSIM_Select_Super(const sBFSIM_PROFILE *psPROF, uint32_t permille)
+{
+    uint32_t mask = 0;
+    int  i;
+    //
+    for (i = 0; i < BFSIM_SUPER_NUM; i++)
+    {
+        if ((psPROF->save[i]) && (psPROF->save[i] * 1000 >= psPROF->ops * permille)) mask |= 1 << i;
+    }
+    return mask;
+}
+
+//----------------------------------
+// Set Superinstructions to be fused
+//     mask of (1 << BFSIM_SUPER_xxx)
+//----------------------------------
+void BFSIM_Set_Super(sBFSIM *psSIM, uint32_t mask)
+{
+    psSIM->super = mask;
+    BFSIM_Repredecode(psSIM);
+}
+
+//-----------------------------------
+// Snapshot
+//     RAM is kept in pages, and a page equal
+//     to the same page of the previous snapshot
+//     is shared with it (all-zero pages are
+//     not kept at all).
+//-----------------------------------
+typedef struct
+{
+    uint32_t ref;
+    unsigned char data[BFSIM_SNAP_PAGE];
+} sPAGE;
+//
+struct bfsnap
+{
+    uint32_t pc;
+    uint32_t ptr;
+    uint32_t maxptr;
+    uint64_t count;
+    uint64_t count_reset;
+    uint32_t event_pc;
+    unsigned char data;
+    int      wait_in;
+    uint32_t ram_size;
+    uint32_t num_page;
+    uint64_t bytes;  // pages allocated by this snapshot
+    sPAGE  **page;   // NULL if all zero
+};
+//
+static const unsigned char zero_page[BFSIM_SNAP_PAGE];
+
+//----------------------------------
+// Save a Snapshot
+//     psPREV : previous snapshot of the same
+//              machine to share pages (or NULL)
+//     Returns NULL if memory can't be allocated.
+//----------------------------------
+sBFSNAP *BFSIM_Snap_Save(const sBFSIM *psSIM, const sBFSNAP *psPREV)
+{
+    sBFSNAP *psSNAP;
+    sPAGE   *page;
+    const unsigned char *ram = psSIM->ring.mem;
+    uint32_t i, len;
+    //
+    psSNAP = (sBFSNAP*)calloc(1, sizeof(sBFSNAP));
+    if (psSNAP == NULL) return NULL;
+    psSNAP->num_page = (uint32_t)(((uint64_t)psSIM->ram_size + BFSIM_SNAP_PAGE - 1) / BFSIM_SNAP_PAGE);
+    psSNAP->page = (sPAGE**)calloc(psSNAP->num_page, sizeof(sPAGE*));
+    if (psSNAP->page == NULL) {free(psSNAP); return NULL;}
+    if ((psPREV) && (psPREV->ram_size != psSIM->ram_size)) psPREV = NULL;
+    //
+    // Registers
+    psSNAP->pc          = psSIM->pc;
+    psSNAP->ptr         = psSIM->ptr;
+    psSNAP->maxptr      = psSIM->maxptr;
+    psSNAP->count       = psSIM->count;
+    psSNAP->count_reset = psSIM->count_reset;
+    psSNAP->event_pc    = psSIM->event_pc;
+    psSNAP->data        = psSIM->data;
+    psSNAP->wait_in     = psSIM->wait_in;
+    psSNAP->ram_size    = psSIM->ram_size;
+    //
+    // RAM Pages
+    for (i = 0; i < psSNAP->num_page; i++, ram = ram + BFSIM_SNAP_PAGE)
+    {
+        len = psSIM->ram_size - i * BFSIM_SNAP_PAGE;
+        len = (len < BFSIM_SNAP_PAGE)? len : BFSIM_SNAP_PAGE;
+        page = (psPREV)? psPREV->page[i] : NULL;
+        if (memcmp(ram, (page)? page->data : zero_page, len) == 0)
+        {
+            if (page) page->ref++;
+            psSNAP->page[i] = page;
+            continue;
+        }
+        page = (sPAGE*)malloc(sizeof(sPAGE));
+        if (page == NULL) {BFSIM_Snap_Free(psSNAP); return NULL;}
+        page->ref = 1;
+        memcpy(page->data, ram, len);
+        psSNAP->page[i] = page;
+        psSNAP->bytes = psSNAP->bytes + sizeof(sPAGE);
+    }
+    return psSNAP;
+}
+
+//----------------------------------
+// Load a Snapshot
+//     Breakpoints, trace, limit and
+//     coverage map are not changed.
+//----------------------------------
+int BFSIM_Snap_Load(sBFSIM *psSIM, const sBFSNAP *psSNAP)
+{
+    unsigned char *ram = psSIM->ring.mem;
+    uint32_t i, len;
+    //
+    if (psSNAP->ram_size != psSIM->ram_size) return BFSIM_ERR_RANGE;
+    for (i = 0; i < psSNAP->num_page; i++, ram = ram + BFSIM_SNAP_PAGE)
+    {
+        len = psSIM->ram_size - i * BFSIM_SNAP_PAGE;
+        len = (len < BFSIM_SNAP_PAGE)? len : BFSIM_SNAP_PAGE;
+        memcpy(ram, (psSNAP->page[i])? psSNAP->page[i]->data : zero_page, len);
+    }
+    psSIM->pc          = psSNAP->pc;
+    psSIM->ptr         = psSNAP->ptr;
+    psSIM->maxptr      = psSNAP->maxptr;
+    psSIM->count       = psSNAP->count;
+    psSIM->count_reset = psSNAP->count_reset;
+    psSIM->event_pc    = psSNAP->event_pc;
+    psSIM->data        = psSNAP->data;
+    psSIM->wait_in     = psSNAP->wait_in;
+    psSIM->skip_brk    = 0;
+    psSIM->cover_prev  = 0;
+    return BFSIM_OK;
+}
+
+//----------------------------------
+// Bytes allocated by a Snapshot
+//     Pages shared with the previous
+//     snapshot are not included.
+//----------------------------------
+uint64_t BFSIM_Snap_Bytes(const sBFSNAP *psSNAP)
+{
+    return psSNAP->bytes + sizeof(sBFSNAP) + sizeof(sPAGE*) * (uint64_t)psSNAP->num_page;
+}
+
+//----------------------------------
+// Free a Snapshot
+//     Returns the bytes released, pages
+//     still shared are not released.
+//----------------------------------
+uint64_t BFSIM_Snap_Free(sBFSNAP *psSNAP)
+{
+    uint64_t bytes;
+    uint32_t i;
+    //
+    if (psSNAP == NULL) return 0;
+    bytes = sizeof(sBFSNAP) + sizeof(sPAGE*) * (uint64_t)psSNAP->num_page;
+    for (i = 0; i < psSNAP->num_page; i++)
+    {
+        if ((psSNAP->page[i] == NULL) || (--psSNAP->page[i]->ref)) continue;
+        free(psSNAP->page[i]);
+        bytes = bytes + sizeof(sPAGE);
+    }
+    free(psSNAP->page);
+    free(psSNAP);
+    return bytes;
+}
+
+//-----------------------------------
+// Lane-Parallel Machines
+//     Lane registers are kept as structure of
+//     arrays, and RAM is interleaved by lane,
+//     ram[cell * lanes + lane], so the lanes at
+//     the same PTR are one vector.
+//-----------------------------------
+#define LANE_ALIGN 16 // lanes are rounded up to this
+#define LANE_RUN   -1 // event of a running lane
+//
+#define SWAR_ONE  0x0101010101010101ULL // 8 lanes in a word
+#define SWAR_LOW7 0x7f7f7f7f7f7f7f7fULL
+#define SWAR_HIGH 0x8080808080808080ULL
+//
+struct bflanes
+{
+    // Program
+    sOP     *ops;
+    uint32_t num_op;
+    uint32_t entry_ip;
+    uint32_t entry_done; // NOPs before entry in the op
+    // Memory
+    uint32_t lanes;
+    uint32_t width;    // lanes rounded up to LANE_ALIGN
+    uint32_t ram_size;
+    unsigned char *ram;
+    uint32_t dirty_lo; // cells written in the last run
+    uint32_t dirty_hi;
+    unsigned char *preload;
+    uint32_t data_addr;
+    uint32_t data_size;
+    // Lanes
+    uint32_t *ip;
+    uint32_t *ptr;
+    uint64_t *count;
+    uint32_t *num_in;
+    uint32_t *num_out;
+    int      *event;
+    unsigned char *out;  // BFSIM_LANE_OUT per lane
+    unsigned char *mask; // 0xff if in the running group
+};
+
+//----------------------------------
+// Move Pointer on the Ring
+//----------------------------------
+static inline uint32_t Lane_Move(uint32_t ptr, int32_t arg, uint32_t size)
+{
+    uint32_t step;
+    //
+    if (arg > 0) return Ring_Add(ptr, (uint32_t)arg, size);
+    step = (uint32_t)(-arg);
+    step = (step < size)? step : step % size;
+    return (ptr >= step)? ptr - step : ptr + (size - step);
+}
+
+//----------------------------------
+// Add to the Lanes in the Group (8 per word)
+//----------------------------------
+static inline void Lane_Add(unsigned char *row, const unsigned char *mask, unsigned char arg, uint32_t w)
+{
+    uint64_t x, m, a;
+    uint32_t l;
+    //
+    for (l = 0; l < w; l = l + 8)
+    {
+        memcpy(&m, mask + l, 8);
+        if (m == 0) continue;
+        memcpy(&x, row + l, 8);
+        a = (SWAR_ONE * arg) & m;
+        x = ((x & SWAR_LOW7) + (a & SWAR_LOW7)) ^ ((x ^ a) & SWAR_HIGH);
+        memcpy(row + l, &x, 8);
+    }
+}
+
+//----------------------------------
+// Count Zero Cells in the Group (8 per word)
+//----------------------------------
+static inline uint32_t Lane_Zero(const unsigned char *row, const unsigned char *mask, uint32_t w)
+{
+    uint64_t x, m;
+    uint32_t l;
+    uint32_t zero = 0;
+    //
+    for (l = 0; l < w; l = l + 8)
+    {
+        memcpy(&m, mask + l, 8);
+        if (m == 0) continue;
+        memcpy(&x, row + l, 8);
+        x = ~(((x & SWAR_LOW7) + SWAR_LOW7) | x | SWAR_LOW7) & m; // 0x80 in a zero byte
+        zero = zero + (uint32_t)__builtin_popcountll(x);
+    }
+    return zero;
+}
+
+//----------------------------------
+// Mark a Cell as Written
+//----------------------------------
+static inline void Lane_Dirty(sBFLANES *psLANES, uint32_t cell)
+{
+    if (cell < psLANES->dirty_lo) psLANES->dirty_lo = cell;
+    if (cell > psLANES->dirty_hi) psLANES->dirty_hi = cell;
+}
+
+//----------------------------------
+// Create Lane-Parallel Machines
+//     Returns NULL if brackets are not balanced,
+//     entry is inside a fused op, or memory
+//     can't be allocated.
+//----------------------------------
+sBFLANES *BFSIM_Lanes_Create(const unsigned char *rom, const sBFSIM_CONFIG *psCONFIG, uint32_t lanes)
+{
+    sBFLANES *psLANES;
+    uint64_t width;
+    //
+    if ((psCONFIG->rom_size == 0) || (psCONFIG->ram_size == 0) || (lanes == 0)) return NULL;
+    if (psCONFIG->entry >= psCONFIG->rom_size) return NULL;
+    if ((uint64_t)psCONFIG->data_addr + psCONFIG->data_size > psCONFIG->ram_size) return NULL;
+    width = ((uint64_t)lanes + LANE_ALIGN - 1) / LANE_ALIGN * LANE_ALIGN;
+    if (width * psCONFIG->ram_size > (uint64_t)SIZE_MAX / 2) return NULL;
+    //
+    psLANES = (sBFLANES*)calloc(1, sizeof(sBFLANES));
+    if (psLANES == NULL) return NULL;
+    psLANES->lanes    = lanes;
+    psLANES->width    = (uint32_t)width;
+    psLANES->ram_size = psCONFIG->ram_size;
+    //
+    // Program
+    psLANES->ops = Predecode_ROM(rom, psCONFIG->rom_size, NULL, 0, NULL, &psLANES->num_op);
+    if ((psLANES->ops == NULL)
+     || (Find_Op(psLANES->ops, psLANES->num_op, psCONFIG->entry, &psLANES->entry_ip, &psLANES->entry_done) == 0))
+    {
+        BFSIM_Lanes_Destroy(psLANES);
+        return NULL;
+    }
+    //
+    // Memory (zero-cleared)
+    psLANES->ram     = (unsigned char*)calloc((size_t)(width * psCONFIG->ram_size), 1);
+    psLANES->ip      = (uint32_t*)malloc(sizeof(uint32_t) * width);
+    psLANES->ptr     = (uint32_t*)malloc(sizeof(uint32_t) * width);
+    psLANES->count   = (uint64_t*)malloc(sizeof(uint64_t) * width);
+    psLANES->num_in  = (uint32_t*)malloc(sizeof(uint32_t) * width);
+    psLANES->num_out = (uint32_t*)malloc(sizeof(uint32_t) * width);
+    psLANES->event   = (int*)malloc(sizeof(int) * width);
+    psLANES->out     = (unsigned char*)malloc(BFSIM_LANE_OUT * width);
+    psLANES->mask    = (unsigned char*)calloc(width, 1);
+    if ((psLANES->ram == NULL) || (psLANES->ip == NULL) || (psLANES->ptr == NULL)
+     || (psLANES->count == NULL) || (psLANES->num_in == NULL) || (psLANES->num_out == NULL)
+     || (psLANES->event == NULL) || (psLANES->out == NULL) || (psLANES->mask == NULL))
+    {
+        BFSIM_Lanes_Destroy(psLANES);
+        return NULL;
+    }
+    psLANES->dirty_lo = UINT32_MAX;
+    psLANES->dirty_hi = 0;
+    //
+    // Data Preload
+    if (psCONFIG->data_size)
+    {
+        psLANES->preload = (unsigned char*)malloc(psCONFIG->data_size);
+        if (psLANES->preload == NULL) {BFSIM_Lanes_Destroy(psLANES); return NULL;}
+        memcpy(psLANES->preload, psCONFIG->data, psCONFIG->data_size);
+        psLANES->data_addr = psCONFIG->data_addr;
+        psLANES->data_size = psCONFIG->data_size;
+    }
+    return psLANES;
+}
+
+//----------------------------------
+// Destroy Lane-Parallel Machines
+//----------------------------------
+void BFSIM_Lanes_Destroy(sBFLANES *psLANES)
+{
+    if (psLANES == NULL) return;
+    free(psLANES->ops);
+    free(psLANES->ram);
+    free(psLANES->preload);
+    free(psLANES->ip);
+    free(psLANES->ptr);
+    free(psLANES->count);
+    free(psLANES->num_in);
+    free(psLANES->num_out);
+    free(psLANES->event);
+    free(psLANES->out);
+    free(psLANES->mask);
+    free(psLANES);
+}
+
+//----------------------------------
+// Reset All Lanes
+//     Only the cells written by the last
+//     run are cleared.
+//----------------------------------
+static void Lanes_Reset(sBFLANES *psLANES)
+{
+    uint32_t w = psLANES->width;
+    uint32_t i, l;
+    //
+    if (psLANES->dirty_lo <= psLANES->dirty_hi)
+    {
+        memset(psLANES->ram + (size_t)psLANES->dirty_lo * w, 0,
+            (size_t)(psLANES->dirty_hi - psLANES->dirty_lo + 1) * w);
+    }
+    psLANES->dirty_lo = UINT32_MAX;
+    psLANES->dirty_hi = 0;
+    for (i = 0; i < psLANES->data_size; i++)
+    {
+        memset(psLANES->ram + (size_t)(psLANES->data_addr + i) * w, psLANES->preload[i], w);
+        Lane_Dirty(psLANES, psLANES->data_addr + i);
+    }
+    //
+    for (l = 0; l < w; l++)
+    {
+        psLANES->ip[l]      = psLANES->entry_ip;
+        psLANES->ptr[l]     = 0;
+        psLANES->count[l]   = 0 - (uint64_t)psLANES->entry_done;
+        psLANES->num_in[l]  = 0;
+        psLANES->num_out[l] = 0;
+        psLANES->event[l]   = (l < psLANES->lanes)? LANE_RUN : BFSIM_EV_LIMIT;
+        psLANES->mask[l]    = 0;
+    }
+}
+
+//----------------------------------
+// Run All Lanes to their Stop
+//     input has num_in bytes per lane, taken
+//     by IN in order. The group of lanes at the
+//     lowest op runs together until a branch
+//     splits it or it reaches other lanes, which
+//     then join the group.
+//----------------------------------
+int BFSIM_Lanes_Run(sBFLANES *psLANES, const unsigned char *input, uint32_t num_in, uint64_t max_steps)
+{
+    unsigned char *ram = psLANES->ram;
+    unsigned char *mask = psLANES->mask;
+    uint32_t w = psLANES->width;
+    uint32_t size = psLANES->ram_size;
+    uint32_t running;
+    uint32_t ip, next;
+    uint32_t gptr;
+    uint32_t n, zero;
+    uint32_t taken_zero, taken_else;
+    uint32_t l, j;
+    uint64_t gmax;
+    uint64_t delta;
+    int  uniform;
+    int  stay_zero;
+    int  stop;
+    sOP *op;
+    //
+    Lanes_Reset(psLANES);
+    running = psLANES->lanes;
+    while (running)
+    {
+        // Group at the lowest op, and the op where other lanes wait
+        ip = UINT32_MAX;
+        for (l = 0; l < w; l++)
+        {
+            if ((psLANES->event[l] == LANE_RUN) && (psLANES->ip[l] < ip)) ip = psLANES->ip[l];
+        }
+        next = UINT32_MAX;
+        n = 0;
+        gptr = 0;
+        gmax = 0;
+        uniform = 1;
+        for (l = 0; l < w; l++)
+        {
+            mask[l] = 0;
+            if (psLANES->event[l] != LANE_RUN) continue;
+            if (psLANES->ip[l] != ip)
+            {
+                next = (psLANES->ip[l] < next)? psLANES->ip[l] : next;
+                continue;
+            }
+            mask[l] = 0xff;
+            if (n == 0) gptr = psLANES->ptr[l];
+            else if (psLANES->ptr[l] != gptr) uniform = 0;
+            gmax = (psLANES->count[l] > gmax)? psLANES->count[l] : gmax;
+            n++;
+        }
+        //
+        // Run the Group
+        delta = 0;
+        stop = 0;
+        while ((ip < next) && (stop == 0))
+        {
+            op = &psLANES->ops[ip];
+            switch(op->op)
+            {
+                case OP_MOVE :
+                {
+                    delta = delta + op->nop + op->len;
+                    if (uniform) gptr = Lane_Move(gptr, op->arg, size);
+                    else
+                    {
+                        for (l = 0; l < w; l++)
+                        {
+                            if (mask[l]) psLANES->ptr[l] = Lane_Move(psLANES->ptr[l], op->arg, size);
+                        }
+                    }
+                    ip++;
+                    break;
+                }
+                case OP_ADD :
+                {
+                    delta = delta + op->nop + op->len;
+                    if (uniform)
+                    {
+                        Lane_Add(ram + (size_t)gptr * w, mask, (unsigned char)op->arg, w);
+                        Lane_Dirty(psLANES, gptr);
+                    }
+                    else
+                    {
+                        for (l = 0; l < w; l++)
+                        {
+                            if (mask[l] == 0) continue;
+                            ram[(size_t)psLANES->ptr[l] * w + l] += (unsigned char)op->arg;
+                            Lane_Dirty(psLANES, psLANES->ptr[l]);
+                        }
+                    }
+                    ip++;
+                    break;
+                }
+                case OP_BEGIN :
+                case OP_SCAN  :
+                case OP_END   :
+                {
+                    delta = delta + op->nop + op->len;
+                    zero = 0;
+                    if (uniform)
+                    {
+                        zero = Lane_Zero(ram + (size_t)gptr * w, mask, w);
+                    }
+                    else
+                    {
+                        for (l = 0; l < w; l++)
+                        {
+                            if (mask[l]) zero += (ram[(size_t)psLANES->ptr[l] * w + l] == 0);
+                        }
+                    }
+                    if ((zero == 0) || (zero == n))
+                    {
+                        // Taken by all or none
+                        if (op->op == OP_END) ip = (zero)? ip + 1 : op->jump;
+                        else ip = (zero)? op->jump : ip + 1;
+                        if ((op->op == OP_END) && (zero == 0) && (gmax + delta >= max_steps)) stop = 1;
+                        break;
+                    }
+                    //
+                    // Split, Lanes to the lower op stay in the group
+                    if (op->op == OP_END) {taken_zero = ip + 1; taken_else = op->jump;}
+                    else {taken_zero = op->jump; taken_else = ip + 1;}
+                    stay_zero = (taken_zero < taken_else);
+                    for (l = 0; l < w; l++)
+                    {
+                        if (mask[l] == 0) continue;
+                        j = (uniform)? gptr : psLANES->ptr[l];
+                        if ((ram[(size_t)j * w + l] == 0) == stay_zero) continue;
+                        psLANES->ip[l] = (stay_zero)? taken_else : taken_zero;
+                        psLANES->count[l] += delta;
+                        psLANES->ptr[l] = j;
+                        mask[l] = 0;
+                    }
+                    ip   = (stay_zero)? taken_zero : taken_else;
+                    next = (stay_zero)? ((taken_else < next)? taken_else : next) : ((taken_zero < next)? taken_zero : next);
+                    n    = (stay_zero)? zero : n - zero;
+                    if ((op->op == OP_END) && (ip == op->jump) && (gmax + delta >= max_steps)) stop = 1;
+                    break;
+                }
+                case OP_WRAP :
+                {
+                    delta = delta + op->nop;
+                    ip = 0;
+                    if (gmax + delta >= max_steps) stop = 1;
+                    break;
+                }
+                case OP_OUT :
+                {
+                    delta = delta + op->nop + op->len;
+                    for (l = 0; l < w; l++)
+                    {
+                        if (mask[l] == 0) continue;
+                        j = psLANES->num_out[l]++;
+                        if (j < BFSIM_LANE_OUT)
+                            psLANES->out[l * BFSIM_LANE_OUT + j] = ram[(size_t)((uniform)? gptr : psLANES->ptr[l]) * w + l];
+                    }
+                    ip++;
+                    break;
+                }
+                case OP_IN :
+                {
+                    delta = delta + op->nop;
+                    for (l = 0; l < w; l++)
+                    {
+                        if (mask[l] == 0) continue;
+                        if (psLANES->num_in[l] >= num_in)
+                        {
+                            // No more Input
+                            psLANES->event[l] = BFSIM_EV_IN;
+                            psLANES->count[l] += delta;
+                            mask[l] = 0;
+                            running--;
+                            stop = 1;
+                            continue;
+                        }
+                        j = (uint32_t)((uniform)? gptr : psLANES->ptr[l]);
+                        ram[(size_t)j * w + l] = input[(size_t)l * num_in + psLANES->num_in[l]++];
+                        Lane_Dirty(psLANES, j);
+                    }
+                    delta = delta + 1;
+                    ip++;
+                    break;
+                }
+                // OP_RESET, OP_ILLEGAL
+                default :
+                {
+                    delta = delta + op->nop;
+                    for (l = 0; l < w; l++)
+                    {
+                        if (mask[l] == 0) continue;
+                        psLANES->event[l] = (op->op == OP_RESET)? BFSIM_EV_RESET : BFSIM_EV_ILLEGAL;
+                        psLANES->count[l] += delta;
+                        mask[l] = 0;
+                        running--;
+                    }
+                    stop = 1;
+                    break;
+                }
+            }
+        }
+        //
+        // Write Back the Group
+        for (l = 0; l < w; l++)
+        {
+            if (mask[l] == 0) continue;
+            psLANES->count[l] += delta;
+            if (uniform) psLANES->ptr[l] = gptr;
+            psLANES->ip[l] = ip;
+            if (psLANES->count[l] >= max_steps)
+            {
+                psLANES->event[l] = BFSIM_EV_LIMIT;
+                running--;
+            }
+        }
+    }
+    return BFSIM_OK;
+}
+
+//----------------------------------
+// Get the Result of a Lane
+//----------------------------------
+void BFSIM_Lanes_Get(const sBFLANES *psLANES, uint32_t lane, sBFSIM_LANE *psLANE)
+{
+    uint32_t num;
+    //
+    psLANE->event   = psLANES->event[lane];
+    psLANE->count   = psLANES->count[lane];
+    psLANE->num_out = psLANES->num_out[lane];
+    num = (psLANE->num_out < BFSIM_LANE_OUT)? psLANE->num_out : BFSIM_LANE_OUT;
+    memcpy(psLANE->out, psLANES->out + (size_t)lane * BFSIM_LANE_OUT, num);
+}
+
+//===========================================================
+// End of File
+//===========================================================
@@ -0,0 +1,289 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : bfsim.h
+// Description : Simulator Core Library (libbfsim) Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+
+#ifndef __BFSIM_H__
+#define __BFSIM_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------------------------------
+// Usage
+//     A machine is created from a ROM image (one 4bit code
+//     per byte) and owns all of its state, so any number of
+//     machines can run in one process, each on its own thread.
+//
+//     psSIM = BFSIM_Create(rom, &config);
+//     while ((event = BFSIM_Run(psSIM, 0)) != BFSIM_EV_STOP)
+//     {
+//         BFSIM_Get_State(psSIM, &state);
+//         if (event == BFSIM_EV_OUT) putchar(state.data);
+//         if (event == BFSIM_EV_IN ) BFSIM_Feed_Input(psSIM, getchar());
+//     }
+//     BFSIM_Destroy(psSIM);
+//
+//     Run(psSIM, 0) without trace uses a fast predecoded
+//     model. Otherwise instructions are executed one by one
+//     exactly as the hardware does. Breakpoints and
+//     watchpoints are put into the predecoded program when
+//     set, so a run without them is not slowed down.
+//     Create analyzes the pointer range (ptrange.h): runs
+//     of P++/P-- proven not to wrap skip the wrap check,
+//     and the RAM is not mirrored if the pointer can never
+//     wrap.
+//
+//     For fuzzing, a machine can count the outcomes of
+//     BEGIN/END, cell overflows and pointer wraps in a
+//     coverage map, stop at an instruction limit, and
+//     restart from the state after Create.
+//
+//     BFSIM_Set_Cover(psSIM, map); // BFSIM_COVER_SIZE bytes
+//     BFSIM_Set_Limit(psSIM, max_count);
+//     BFSIM_Restart(psSIM);
+//
+//     A snapshot keeps the whole machine state, and pages
+//     of RAM not changed since the previous snapshot are
+//     shared with it, so snapshots can be taken often.
+//
+//     psSNAP = BFSIM_Snap_Save(psSIM, psPREV);
+//     BFSIM_Snap_Load(psSIM, psSNAP);
+//     BFSIM_Snap_Free(psSNAP);
+//
+//     The fast model can count the predecoded ops it runs
+//     and sum them up as op pairs and loop shapes, and then
+//     fuse the frequent ones into superinstructions, each
+//     of which runs two ops, or a whole loop, per dispatch.
+//
+//     BFSIM_Set_Profile(psSIM, 1);
+//     ... run ...
+//     BFSIM_Get_Profile(psSIM, &prof);
+//     mask = BFSIM_Select_Super(&prof, 10); // 1.0% of ops at least
+//     BFSIM_Set_Super(psSIM2, mask);
+//
+//     Lane-parallel machines run one ROM for many inputs at
+//     once, for input sweeps. Each lane starts from reset
+//     and stops at RESET, at an IN beyond its inputs, or
+//     at max_steps. Lanes at the same PC run together.
+//
+//     psLANES = BFSIM_Lanes_Create(rom, &config, 256);
+//     BFSIM_Lanes_Run(psLANES, input, 2, max_steps);
+//     BFSIM_Lanes_Get(psLANES, lane, &lane_result);
+//-----------------------------------------------------------
+
+//-----------------------------------
+// Instruction Code
+//-----------------------------------
+#define BFSIM_CODE_PINC   0
+#define BFSIM_CODE_PDEC   1
+#define BFSIM_CODE_INC    2
+#define BFSIM_CODE_DEC    3
+#define BFSIM_CODE_OUT    4
+#define BFSIM_CODE_IN     5
+#define BFSIM_CODE_BEGIN  6
+#define BFSIM_CODE_END    7
+#define BFSIM_CODE_RESET  8
+#define BFSIM_CODE_NOP   15
+
+//-----------------------------------
+// Event (returned by Run and Step)
+//-----------------------------------
+enum BFSIM_EVENT
+{
+    BFSIM_EV_LIMIT,   // max_steps executed or limit reached
+    BFSIM_EV_OUT,     // OUT executed, data is in state.data
+    BFSIM_EV_IN,      // IN needs data, call BFSIM_Feed_Input()
+    BFSIM_EV_RESET,   // RESET executed (RAM cleared, PC=0)
+    BFSIM_EV_BREAK,   // stopped at a breakpoint before execution
+    BFSIM_EV_STOP,    // BFSIM_Stop() was called
+    BFSIM_EV_ILLEGAL, // illegal code at state.pc, not executed
+    BFSIM_EV_HANG,    // a scan loop never finds a zero cell
+    BFSIM_EV_WATCH    // INC/DEC changed a watched cell
+};
+
+//-----------------------------------
+// Result Code
+//-----------------------------------
+#define BFSIM_OK        0
+#define BFSIM_ERR_STATE 1 // not waiting for input
+#define BFSIM_ERR_RANGE 2 // address out of ROM
+#define BFSIM_ERR_MEM   3 // memory can't be allocated
+
+//-----------------------------------
+// Configuration
+//-----------------------------------
+typedef struct
+{
+    uint32_t rom_size;        // ROM size in codes
+    uint32_t ram_size;        // RAM size in bytes
+    uint32_t entry;           // Start PC
+    const unsigned char *data; // Data Preload (NULL if none)
+    uint32_t data_addr;       // Data Preload Address
+    uint32_t data_size;       // Data Preload Size
+} sBFSIM_CONFIG;
+
+//-----------------------------------
+// Machine State
+//-----------------------------------
+typedef struct
+{
+    uint32_t pc;        // next PC
+    unsigned char code; // code at next PC
+    uint32_t ptr;       // data pointer
+    uint32_t maxptr;    // highest PTR reached by P++
+    uint64_t count;     // instructions since start or RESET
+    uint64_t count_reset; // count when the last RESET was executed
+    uint32_t event_pc;  // PC of the instruction raising the last event
+    unsigned char data; // OUT data, or value before WATCH
+    int      wait_in;   // 1 if waiting for BFSIM_Feed_Input()
+} sBFSIM_STATE;
+
+//-----------------------------------
+// Trace Record (one per instruction)
+//     ptr and data are the pointer and
+//     RAM[ptr] after the instruction,
+//     or before it for RESET.
+//-----------------------------------
+typedef struct
+{
+    uint64_t count;
+    uint32_t pc;
+    unsigned char code;
+    uint32_t ptr;
+    unsigned char data;
+} sBFSIM_TRACE;
+//
+typedef void (*BFSIM_TRACE_FUNC)(void *user, const sBFSIM_TRACE *psTRACE);
+
+//-----------------------------------
+// Coverage Map
+//     One counter per edge between branch
+//     outcomes (hashed), wrapping at 256.
+//-----------------------------------
+#define BFSIM_COVER_SIZE 65536
+
+//-----------------------------------
+// Watchpoints
+//-----------------------------------
+#define BFSIM_WATCH_MAX 16 // RAM addresses watched at once
+
+//-----------------------------------
+// Superinstructions (Fast Model)
+//     Selected as a mask of (1 << BFSIM_SUPER_xxx).
+//     A run is a run of fused P++/P-- or INC/DEC.
+//-----------------------------------
+enum BFSIM_SUPER
+{
+    BFSIM_SUPER_ADD_MOVE,   // INC/DEC run, then P++/P-- run
+    BFSIM_SUPER_MOVE_ADD,   // P++/P-- run, then INC/DEC run
+    BFSIM_SUPER_ADD_END,    // INC/DEC run, then END
+    BFSIM_SUPER_MOVE_END,   // P++/P-- run, then END
+    BFSIM_SUPER_MOVE_BEGIN, // P++/P-- run, then BEGIN
+    BFSIM_SUPER_CLEAR,      // loop [-] or [+]
+    BFSIM_SUPER_MUL,        // loop [->+>++<<] (balanced, runs only, -1 at the start)
+    BFSIM_SUPER_NUM
+};
+
+//-----------------------------------
+// Profile (Fast Model)
+//     Counts of the predecoded ops; a scan
+//     loop ([>], [<<]) is one op.
+//-----------------------------------
+enum BFSIM_PROF_OP {BFSIM_PROF_MOVE, BFSIM_PROF_ADD, BFSIM_PROF_OUT, BFSIM_PROF_BEGIN, BFSIM_PROF_END, BFSIM_PROF_SCAN, BFSIM_PROF_OP_NUM};
+enum BFSIM_LOOP {BFSIM_LOOP_SCAN, BFSIM_LOOP_CLEAR, BFSIM_LOOP_MUL, BFSIM_LOOP_OTHER, BFSIM_LOOP_NUM};
+#define BFSIM_PROF_HOT 8 // hottest loops kept
+//
+typedef struct
+{
+    uint64_t ops; // ops run
+    uint64_t pair[BFSIM_PROF_OP_NUM][BFSIM_PROF_OP_NUM]; // op followed by op
+    // Loop Shapes
+    uint64_t loop_num  [BFSIM_LOOP_NUM]; // loops run
+    uint64_t loop_entry[BFSIM_LOOP_NUM]; // BEGIN run
+    uint64_t loop_iter [BFSIM_LOOP_NUM]; // END run (not counted for scans)
+    // Hottest Loops (ops run inside, inner loops included)
+    uint32_t num_hot;
+    uint32_t hot_pc   [BFSIM_PROF_HOT];
+    int      hot_shape[BFSIM_PROF_HOT];
+    uint64_t hot_ops  [BFSIM_PROF_HOT];
+    // Dispatches saved by each Superinstruction (at most)
+    uint64_t save[BFSIM_SUPER_NUM];
+} sBFSIM_PROFILE;
+
+//-----------------------------------
+// Snapshot Page
+//-----------------------------------
+#define BFSIM_SNAP_PAGE 4096 // bytes of RAM shared as a unit
+
+//-----------------------------------
+// Lane Result
+//-----------------------------------
+#define BFSIM_LANE_OUT 16 // OUT data kept per lane
+//
+typedef struct
+{
+    int      event;   // BFSIM_EV_RESET, _IN, _ILLEGAL or _LIMIT
+    uint64_t count;   // instructions before the stop
+    uint32_t num_out; // OUT executed
+    unsigned char out[BFSIM_LANE_OUT]; // first OUT data
+} sBFSIM_LANE;
+
+//-----------------------------------
+// Machine (opaque)
+//-----------------------------------
+typedef struct bfsim sBFSIM;
+typedef struct bflanes sBFLANES;
+typedef struct bfsnap sBFSNAP;
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+sBFSIM *BFSIM_Create(const unsigned char *rom, const sBFSIM_CONFIG *psCONFIG);
+void BFSIM_Destroy(sBFSIM *psSIM);
+int  BFSIM_Run(sBFSIM *psSIM, uint64_t max_steps);
+int  BFSIM_Step(sBFSIM *psSIM);
+void BFSIM_Stop(sBFSIM *psSIM);
+int  BFSIM_Cancel_Stop(sBFSIM *psSIM);
+int  BFSIM_Feed_Input(sBFSIM *psSIM, unsigned char data);
+void BFSIM_Get_State(const sBFSIM *psSIM, sBFSIM_STATE *psSTATE);
+unsigned char *BFSIM_Get_RAM(sBFSIM *psSIM, uint32_t *psize);
+int  BFSIM_Set_Break(sBFSIM *psSIM, uint32_t pc, int enable);
+int  BFSIM_Set_Watch(sBFSIM *psSIM, uint32_t addr, int enable);
+void BFSIM_Set_Trace(sBFSIM *psSIM, BFSIM_TRACE_FUNC func, void *user);
+void BFSIM_Set_Limit(sBFSIM *psSIM, uint64_t max_count);
+void BFSIM_Set_Cover(sBFSIM *psSIM, unsigned char *map);
+void BFSIM_Restart(sBFSIM *psSIM);
+int  BFSIM_Set_Profile(sBFSIM *psSIM, int enable);
+void BFSIM_Get_Profile(sBFSIM *psSIM, sBFSIM_PROFILE *psPROF);
+uint32_t BFSIM_Select_Super(const sBFSIM_PROFILE *psPROF, uint32_t permille);
+void BFSIM_Set_Super(sBFSIM *psSIM, uint32_t mask);
+//
+sBFSNAP *BFSIM_Snap_Save(const sBFSIM *psSIM, const sBFSNAP *psPREV);
+int  BFSIM_Snap_Load(sBFSIM *psSIM, const sBFSNAP *psSNAP);
+uint64_t BFSIM_Snap_Bytes(const sBFSNAP *psSNAP);
+uint64_t BFSIM_Snap_Free(sBFSNAP *psSNAP);
+//
+sBFLANES *BFSIM_Lanes_Create(const unsigned char *rom, const sBFSIM_CONFIG *psCONFIG, uint32_t lanes);
+void BFSIM_Lanes_Destroy(sBFLANES *psLANES);
+int  BFSIM_Lanes_Run(sBFLANES *psLANES, const unsigned char *input, uint32_t num_in, uint64_t max_steps);
+void BFSIM_Lanes_Get(const sBFLANES *psLANES, uint32_t lane, sBFSIM_LANE *psLANE);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+//===========================================================
+// End of File
+//===========================================================
@@ -0,0 +1,1785 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : cycle.c
+// Description : Cycle-Based System Model
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cycle.h"
+
+//-----------------------------------------------------------
+// Model Structure
+//     Each module of the RTL is split into Comb (always_comb
+//     and assign, evaluated from the registers) and Posedge
+//     (always_ff, all registers take the values computed
+//     from the previous ones). QSPI_SRAM captures SIO and
+//     the 23LC512 samples SIO at the negative edge of CLK,
+//     which is the rising edge of QSPI_SCK.
+//
+//     Registers without reset in sasc start from the values
+//     which the 10 reset cycles of tb.sv leave in them.
+//-----------------------------------------------------------
+
+//-----------------------------------
+// CPU (cpu.sv)
+//-----------------------------------
+#define STATE_INIT   0x00
+#define STATE_DECODE 0x01
+#define STATE_INC    0x12
+#define STATE_DEC    0x13
+#define STATE_OUT    0x14
+#define STATE_IN     0x15
+#define STATE_BEGIN  0x16
+#define STATE_END    0x17
+//
+#define OPCODE_PINC  0x0
+#define OPCODE_PDEC  0x1
+#define OPCODE_INC   0x2
+#define OPCODE_DEC   0x3
+#define OPCODE_OUT   0x4
+#define OPCODE_IN    0x5
+#define OPCODE_BEGIN 0x6
+#define OPCODE_END   0x7
+#define OPCODE_RESET 0x8
+#define OPCODE_NOP   0xf
+//
+#define ALUFUNC_ZERO 0x0
+#define ALUFUNC_THRU 0x1
+#define ALUFUNC_INC  0x2
+#define ALUFUNC_DEC  0x3
+//
+#define PTR_END_HW 0x7ffd
+#define PTR_END_TB 0x001d // SIMULATION
+
+//-----------------------------------
+// QSPI_SRAM (qspi_sram.sv)
+//-----------------------------------
+#define QSPI_STUP 0x0
+#define QSPI_IDLE 0x2
+#define QSPI_INIT 0x3
+#define QSPI_READ 0x4
+#define QSPI_WRTE 0x5
+
+//-----------------------------------
+// 23LC512 Instructions
+//     QSPI_SRAM sends EQIO in SPI mode,
+//     then only READ and WRITE in SQI mode.
+//-----------------------------------
+#define SRAM_READ  0x03
+#define SRAM_WRITE 0x02
+#define SRAM_EQIO  0x38
+
+//-----------------------------------
+// sasc_fifo4
+//-----------------------------------
+typedef struct
+{
+    uint8_t mem[4];
+    uint8_t wp;
+    uint8_t rp;
+    uint8_t gb;
+} sFIFO;
+
+//-----------------------------------
+// Registers
+//-----------------------------------
+typedef struct
+{
+    // CPU
+    uint8_t  state;
+    uint8_t  seq;
+    uint16_t pc;
+    uint16_t ptr;
+    uint16_t indent;
+    uint8_t  if_do_dphase;
+    uint8_t  if_code_keep;
+    uint8_t  dr_do_dphase;
+    uint8_t  dr_data_keep;
+    uint8_t  ir_do_dphase;
+    uint8_t  ir_data_keep;
+    // CACHE (I-Cache)
+    uint16_t ic_a[4];
+    uint32_t ic_d[4];
+    uint8_t  ic_v[4];
+    uint8_t  if_hit_dphase;
+    uint8_t  if_hit_dphase_addr;
+    uint8_t  if_mis_dphase;
+    uint16_t if_mis_dphase_addr;
+    // CACHE (D-Cache)
+    uint16_t dc_a[2];
+    uint32_t dc_d[2];
+    uint8_t  dc_v[2];
+    uint8_t  dm_hit_dphase;
+    uint8_t  dm_hit_dphase_write;
+    uint8_t  dm_hit_dphase_addr;
+    uint8_t  dm_hit_dphase_wdata;
+    uint8_t  dm_mis_dphase;
+    uint8_t  dm_mis_dphase_write;
+    uint16_t dm_mis_dphase_addr;
+    uint8_t  dm_mis_dphase_wdata;
+    // CACHE (Bus Sequencer)
+    uint8_t  bus_count;
+    uint8_t  bus_inst;
+    uint8_t  bus_read;
+    uint8_t  bus_wrte;
+    uint8_t  bus_repl;
+    uint16_t bus_repl_addr;
+    uint16_t bus_pend_addr;
+    uint32_t bus_pend_wdata;
+    uint32_t bus_pend_rdata;
+    uint8_t  if_mis_req_pend;
+    uint16_t if_mis_req_addr_pend;
+    // QSPI_SRAM
+    uint16_t q_addr;
+    uint8_t  q_wdata;
+    uint8_t  q_bus_rdy;
+    uint8_t  q_cs_n;
+    uint8_t  q_sckenb;
+    uint8_t  q_sckenb2;  // negative edge
+    uint8_t  q_txd;
+    uint8_t  q_sio_e;
+    uint8_t  q_rxd_temp; // negative edge
+    uint8_t  q_rxd;
+    uint8_t  q_state;
+    uint8_t  q_seq;
+    // UART
+    uint8_t  div0_dphase;
+    uint8_t  div1_dphase;
+    uint8_t  div0;
+    uint8_t  div1;
+    uint8_t  din;
+    uint8_t  txd_dphase;
+    uint8_t  rxd_dphase;
+    // sasc_brg
+    uint8_t  ps;
+    uint8_t  ps_clr;
+    uint8_t  br_cnt;
+    uint8_t  br_clr;
+    uint8_t  sio_ce_x4_r;
+    uint8_t  sio_ce_x4_t;
+    uint8_t  sio_ce_x4;
+    uint8_t  cnt;
+    uint8_t  sio_ce_r;
+    uint8_t  sio_ce;
+    // sasc_top (Transmit)
+    uint8_t  txf_empty_r;
+    uint8_t  load;
+    uint16_t hold_reg;
+    uint8_t  txd_o;
+    uint8_t  tx_bit_cnt;
+    uint8_t  shift_en;
+    uint8_t  shift_en_r;
+    sFIFO    tx_fifo;
+    // sasc_top (Receive)
+    uint8_t  rxd_dly;
+    uint8_t  rxd_s;
+    uint8_t  rxd_r;
+    uint8_t  rx_bit_cnt;
+    uint8_t  rx_go;
+    uint8_t  rx_valid;
+    uint8_t  rx_valid_r;
+    uint16_t rxr;
+    uint8_t  rxd_r1;
+    uint8_t  change;
+    uint8_t  dpll_state;
+    uint8_t  rx_sio_ce_r1;
+    uint8_t  rx_sio_ce_r2;
+    uint8_t  rx_sio_ce;
+    sFIFO    rx_fifo;
+    // tb.sv
+    uint8_t  detect_in;
+} sREGS;
+
+//-----------------------------------
+// Wires (Combinational Logic)
+//-----------------------------------
+typedef struct
+{
+    // CPU
+    uint8_t  slot;
+    uint8_t  if_code;
+    uint8_t  state_next;
+    uint8_t  seq_clr, seq_inc;
+    uint8_t  pc_clr, pc_inc, pc_dec, pc_inc2, pc_dec2;
+    uint8_t  ptr_clr, ptr_inc, ptr_dec;
+    uint8_t  indent_clr, indent_inc, indent_dec;
+    uint8_t  if_req;
+    uint16_t if_addr;
+    uint8_t  dm_req, dm_write;
+    uint16_t dm_addr;
+    uint8_t  dm_wdata;
+    uint8_t  io_req, io_write, io_addr;
+    uint8_t  io_wdata;
+    // CACHE
+    uint8_t  if_hit, if_mis_req;
+    uint8_t  dm_hit, dm_mis_req;
+    uint8_t  if_slot, dm_slot;
+    uint8_t  if_rdy, dm_rdy;
+    uint8_t  dm_rdata;
+    uint8_t  bus_req_inst, bus_req_read, bus_req_wrte, bus_req_repl;
+    uint16_t bus_req_addr, bus_req_repl_addr;
+    uint32_t bus_req_wdata;
+    uint8_t  bus_count_end;
+    uint8_t  bus_rdy;
+    uint32_t bus_rdy_rdata;
+    uint32_t dm_hit_dphase_update_data[2];
+    uint32_t dm_mis_dphase_update_data;
+    uint8_t  bus_req, bus_write;
+    uint16_t bus_addr;
+    uint8_t  bus_wdata;
+    // QSPI_SRAM
+    uint8_t  req_read, req_wrte, addr_cont;
+    uint8_t  state_next_q, state_update;
+    uint8_t  seq_clr_q, seq_inc_q, seq_dec_q, seq_dec2_q;
+    uint8_t  bus_ready_set, bus_ready_clr;
+    uint8_t  addr_inc;
+    uint8_t  csn_assert, csn_negate;
+    uint8_t  sckenb_set, sckenb_clr;
+    uint8_t  txd_set_eqio, txd_set_rdcmd, txd_set_wrcmd, txd_set_addrh, txd_set_addrl;
+    uint8_t  txd_set_wdata_qspi, txd_set_wdata_qspi_fwd, txd_sft_1bit, txd_sft_4bit;
+    uint8_t  sio_e_set, sio_e_clr;
+    uint8_t  rxd_capture, rxd_set_hi, rxd_set_lo;
+    // UART
+    uint8_t  io_rdy;
+    uint8_t  io_rdata;
+    uint8_t  div0_aphase, div1_aphase, txd_aphase, rxd_aphase;
+    uint8_t  we, re;
+    // sasc
+    uint8_t  load_e;
+    uint8_t  start;
+    uint8_t  rx_we;
+    uint8_t  rx_sio_ce_d;
+    uint8_t  dpll_next_state;
+} sWIRE;
+
+//-----------------------------------
+// 23LC512
+//-----------------------------------
+typedef struct
+{
+    unsigned char *mem;
+    int      sqi;      // IOMode (0:SPI, 1:SQI)
+    uint8_t  dsi;      // DataShifterI
+    uint8_t  dso;      // DataShifterO
+    uint32_t cc;       // ClockCounter
+    uint8_t  inst;     // InstRegister
+    uint16_t addr;     // AddrRegister
+    uint8_t  so_enable;
+} sSRAM;
+
+//-----------------------------------
+// System
+//-----------------------------------
+struct cycle
+{
+    int      mode;
+    uint16_t ptr_end;
+    sREGS    r;
+    sSRAM    sram;
+    // Cycle
+    uint64_t cycle;
+    uint64_t ce_last;   // cycle of the last sio_ce
+    uint32_t ce_period; // cycles of a UART bit (0 until known)
+    // UART_RXD Generator (Host)
+    int      rx_busy;
+    uint64_t rx_start;
+    uint32_t rx_bit;
+    uint32_t rx_end;    // bits until the next byte can be sent
+    uint8_t  rx_data;
+    uint8_t  rx_seq;    // bytes sent in TB Mode
+    int      rx_wait;   // waiting for CYCLE_Feed_RXD()
+    // UART_TXD Decoder (Host)
+    int      tx_busy;
+    uint64_t tx_start;
+    uint32_t tx_bit;
+    uint8_t  tx_data;
+    uint8_t  data;      // byte of the last UART event
+    // Event
+    unsigned pending;   // bit mask of CYCLE_EVENT
+    // Statistics
+    uint64_t count;
+    uint64_t ic_hit;
+    uint64_t ic_miss;
+    uint64_t dc_hit;
+    uint64_t dc_miss;
+    uint64_t bus;
+    // Trace
+    FILE    *fp_trace;
+};
+
+//----------------------------------
+// Asynchronous Reset (RES_N=0)
+//----------------------------------
+static void Cycle_Reset(sREGS *r)
+{
+    int i;
+    //
+    // CPU
+    r->state = STATE_INIT;
+    r->seq = 0;
+    r->pc = 0;
+    r->ptr = 0;
+    r->indent = 0;
+    r->if_do_dphase = 0;
+    r->if_code_keep = OPCODE_NOP;
+    r->dr_do_dphase = 0;
+    r->dr_data_keep = 0;
+    r->ir_do_dphase = 0;
+    r->ir_data_keep = 0;
+    //
+    // CACHE
+    for (i = 0; i < 4; i++) {r->ic_a[i] = 0; r->ic_d[i] = 0; r->ic_v[i] = 0;}
+    for (i = 0; i < 2; i++) {r->dc_a[i] = 0; r->dc_d[i] = 0; r->dc_v[i] = 0;}
+    r->if_hit_dphase = 0;
+    r->if_hit_dphase_addr = 0;
+    r->if_mis_dphase = 0;
+    r->if_mis_dphase_addr = 0;
+    r->dm_hit_dphase = 0;
+    r->dm_hit_dphase_write = 0;
+    r->dm_hit_dphase_addr = 0;
+    r->dm_hit_dphase_wdata = 0;
+    r->dm_mis_dphase = 0;
+    r->dm_mis_dphase_write = 0;
+    r->dm_mis_dphase_addr = 0;
+    r->dm_mis_dphase_wdata = 0;
+    r->bus_count = 0;
+    r->bus_inst = 0;
+    r->bus_read = 0;
+    r->bus_wrte = 0;
+    r->bus_repl = 0;
+    r->bus_repl_addr = 0;
+    r->bus_pend_addr = 0;
+    r->bus_pend_wdata = 0;
+    r->bus_pend_rdata = 0;
+    r->if_mis_req_pend = 0;
+    r->if_mis_req_addr_pend = 0;
+    //
+    // QSPI_SRAM
+    r->q_addr = 0;
+    r->q_wdata = 0;
+    r->q_bus_rdy = 0;
+    r->q_cs_n = 1;
+    r->q_sckenb = 0;
+    r->q_sckenb2 = 0;
+    r->q_txd = 0;
+    r->q_sio_e = 0;
+    r->q_rxd_temp = 0;
+    r->q_rxd = 0;
+    r->q_state = QSPI_STUP;
+    r->q_seq = 0;
+    //
+    // UART
+    r->div0_dphase = 0;
+    r->div1_dphase = 0;
+    r->div0 = 0;
+    r->div1 = 0;
+    r->din = 0;
+    r->txd_dphase = 0;
+    r->rxd_dphase = 0;
+    //
+    // sasc (only Registers with reset)
+    r->ps = 0;
+    r->br_cnt = 0;
+    r->cnt = 0;
+    r->txf_empty_r = 1;
+    r->txd_o = 1;
+    r->tx_bit_cnt = 9;
+    r->shift_en_r = 0;
+    r->rx_bit_cnt = 0xa;
+    r->rxd_r1 = 1;
+    r->change = 0;
+    r->dpll_state = 1;
+    r->tx_fifo.wp = 0;
+    r->tx_fifo.rp = 0;
+    r->tx_fifo.gb = 0;
+    r->rx_fifo.wp = 0;
+    r->rx_fifo.rp = 0;
+    r->rx_fifo.gb = 0;
+    //
+    // tb.sv
+    r->detect_in = 0;
+}
+
+//----------------------------------
+// FIFO Status
+//----------------------------------
+static inline int FIFO_Empty(const sFIFO *f) {return (f->wp == f->rp) && !f->gb;}
+static inline int FIFO_Full (const sFIFO *f) {return (f->wp == f->rp) &&  f->gb;}
+
+//----------------------------------
+// FIFO Posedge
+//----------------------------------
+static void FIFO_Posedge(sFIFO *f, const sFIFO *o, uint8_t din, int we, int re)
+{
+    uint8_t wp_p1 = (o->wp + 1) & 3;
+    //
+    if (we) f->wp = wp_p1;
+    if (re) f->rp = (o->rp + 1) & 3;
+    if (we) f->mem[o->wp] = din;
+    if ((wp_p1 == o->rp) && we) f->gb = 1;
+    else if (re)                f->gb = 0;
+}
+
+//----------------------------------
+// Select a Nibble / Byte
+//----------------------------------
+static inline uint8_t Nibble(uint32_t data, int index) {return (data >> (index * 4)) & 0x0f;}
+static inline uint8_t Byte  (uint32_t data, int index) {return (data >> (index * 8)) & 0xff;}
+static inline uint32_t Byte_Set(uint32_t data, int index, uint8_t byte)
+{
+    return (data & ~(0xffu << (index * 8))) | ((uint32_t)byte << (index * 8));
+}
+
+//----------------------------------
+// UART Comb (uart.sv, sasc)
+//     IO_RDY and IO_RDATA come from registers.
+//----------------------------------
+static void UART_Comb_Ready(const sREGS *r, sWIRE *w)
+{
+    uint8_t dout = r->rx_fifo.mem[r->rx_fifo.rp];
+    //
+    w->io_rdata = (r->rxd_dphase)? dout
+                : (r->div0_dphase)? r->div0
+                : (r->div1_dphase)? r->div1
+                : 0x00;
+    w->io_rdy = (r->txd_dphase)? !FIFO_Full(&r->tx_fifo)
+              : (r->rxd_dphase)? !FIFO_Empty(&r->rx_fifo)
+              : 1;
+}
+
+//----------------------------------
+// CACHE Comb, Outputs to CPU
+//     IF_CODE, IF_RDY, DM_RDATA and DM_RDY
+//     come from registers.
+//----------------------------------
+static void CACHE_Comb_Ready(const sREGS *r, sWIRE *w)
+{
+    uint32_t d;
+    //
+    w->bus_count_end = (r->bus_count == 0);
+    w->bus_rdy = w->bus_count_end & r->q_bus_rdy;
+    w->bus_rdy_rdata = ((uint32_t)r->q_rxd << 24) | (r->bus_pend_rdata & 0x00ffffff);
+    w->if_slot = w->bus_rdy & !r->if_mis_req_pend;
+    w->dm_slot = w->bus_rdy | r->dm_hit_dphase;
+    //
+    // Instruction Fetch Code
+    if (r->if_hit_dphase & w->if_slot)
+        w->if_code = Nibble(r->ic_d[(r->if_hit_dphase_addr >> 3) & 3], r->if_hit_dphase_addr & 7);
+    else if (r->if_mis_dphase & w->if_slot)
+        w->if_code = Nibble(w->bus_rdy_rdata, r->if_mis_dphase_addr & 7);
+    else
+        w->if_code = OPCODE_NOP;
+    w->if_rdy = w->if_slot;
+    //
+    // Data Memory Read Data
+    if (r->dm_hit_dphase & !r->dm_hit_dphase_write & w->dm_slot)
+    {
+        d = r->dc_d[(r->dm_hit_dphase_addr >> 2) & 1];
+        w->dm_rdata = Byte(d, r->dm_hit_dphase_addr & 3);
+    }
+    else if (r->dm_mis_dphase & !r->dm_mis_dphase_write & w->dm_slot)
+        w->dm_rdata = Byte(w->bus_rdy_rdata, r->dm_mis_dphase_addr & 3);
+    else
+        w->dm_rdata = 0x00;
+    w->dm_rdy = w->dm_slot;
+}
+
+//----------------------------------
+// CPU Comb (cpu.sv)
+//----------------------------------
+static void CPU_Comb(const sCYCLE *psCYC, const sREGS *r, sWIRE *w)
+{
+    uint8_t if_code, dr_data, ir_data;
+    uint8_t if_do, dr_do, dw_do, ir_do, iw_do, io_addr;
+    uint8_t alufunc, aluinx_dr, aluinx_ir, aluinx, aluout;
+    int  ptr_end, indent_zero, indent_plus, aluzero;
+    //
+    w->slot = w->if_rdy & w->dm_rdy & w->io_rdy;
+    if_code = (r->if_do_dphase & w->if_rdy)? w->if_code  : r->if_code_keep;
+    dr_data = (r->dr_do_dphase & w->dm_rdy)? w->dm_rdata : r->dr_data_keep;
+    ir_data = (r->ir_do_dphase & w->io_rdy)? w->io_rdata : r->ir_data_keep;
+    ptr_end = (r->ptr == psCYC->ptr_end);
+    indent_zero = (r->indent == 0);
+    indent_plus = !(r->indent & 0x8000) && (r->indent & 0x7fff);
+    //
+    // aluzero is used by BEGIN and END only,
+    // where ALU passes dr_data through.
+    aluzero = (dr_data == 0x00);
+    //
+    // Default Outputs
+    w->state_next = STATE_INIT;
+    w->seq_clr = w->seq_inc = 0;
+    w->pc_clr = w->pc_inc = w->pc_dec = w->pc_inc2 = w->pc_dec2 = 0;
+    w->ptr_clr = w->ptr_inc = w->ptr_dec = 0;
+    w->indent_clr = w->indent_inc = w->indent_dec = 0;
+    if_do = dr_do = dw_do = ir_do = iw_do = 0;
+    io_addr = 0;
+    alufunc = ALUFUNC_ZERO;
+    aluinx_dr = aluinx_ir = 0;
+    //
+    // Overwrite Outputs
+    switch ((r->state << 4) | r->seq)
+    {
+        //---------------------------------
+        // Initialize CPU Resources
+        case (STATE_INIT << 4) | 0x0 :
+        {
+            w->pc_clr = 1;
+            w->ptr_clr = 1;
+            w->indent_clr = 1;
+            w->seq_inc = 1;
+            w->state_next = STATE_INIT;
+            break;
+        }
+        // Clear All Data Memory
+        case (STATE_INIT << 4) | 0x1 :
+        {
+            dw_do = 1;
+            alufunc = ALUFUNC_ZERO;
+            w->ptr_inc = 1;
+            w->seq_inc = ptr_end;
+            w->state_next = STATE_INIT;
+            break;
+        }
+        // Initialize UART Baud Rate (DIV0)
+        case (STATE_INIT << 4) | 0x2 :
+        {
+            dr_do = 1;
+            w->seq_inc = 1;
+            w->state_next = STATE_INIT;
+            break;
+        }
+        case (STATE_INIT << 4) | 0x3 :
+        {
+            aluinx_dr = 1;
+            alufunc = ALUFUNC_THRU;
+            iw_do = 1;
+            io_addr = 2;
+            w->ptr_inc = 1;
+            w->seq_inc = 1;
+            w->state_next = STATE_INIT;
+            break;
+        }
+        // Initialize UART Baud Rate (DIV1)
+        case (STATE_INIT << 4) | 0x4 :
+        {
+            dr_do = 1;
+            w->seq_inc = 1;
+            w->state_next = STATE_INIT;
+            break;
+        }
+        case (STATE_INIT << 4) | 0x5 :
+        {
+            aluinx_dr = 1;
+            alufunc = ALUFUNC_THRU;
+            iw_do = 1;
+            io_addr = 3;
+            w->ptr_clr = 1;
+            if_do = 1;
+            w->pc_inc = 1;
+            w->seq_clr = 1;
+            w->state_next = STATE_DECODE;
+            break;
+        }
+        //---------------------------------
+        // Dispatch along with if_code
+        case (STATE_DECODE << 4) | 0x0 :
+        {
+            switch (if_code)
+            {
+                case OPCODE_PINC :
+                case OPCODE_PDEC :
+                {
+                    w->ptr_inc = !(if_code & 1);
+                    w->ptr_dec =  (if_code & 1);
+                    if_do = 1;
+                    w->pc_inc = 1;
+                    w->seq_clr = 1;
+                    w->state_next = STATE_DECODE;
+                    break;
+                }
+                case OPCODE_INC   :
+                case OPCODE_DEC   :
+                case OPCODE_OUT   :
+                case OPCODE_BEGIN :
+                case OPCODE_END   :
+                {
+                    dr_do = 1;
+                    w->seq_inc = 1;
+                    w->state_next = 0x10 | if_code;
+                    break;
+                }
+                case OPCODE_IN :
+                {
+                    ir_do = 1;
+                    w->seq_inc = 1;
+                    w->state_next = STATE_IN;
+                    break;
+                }
+                case OPCODE_RESET :
+                {
+                    w->seq_clr = 1;
+                    w->state_next = STATE_INIT;
+                    break;
+                }
+                default : // NOP and No Operation
+                {
+                    if_do = 1;
+                    w->pc_inc = 1;
+                    w->seq_clr = 1;
+                    w->state_next = STATE_DECODE;
+                    break;
+                }
+            }
+            break;
+        }
+        //---------------------------------
+        // INC, DEC, from 2nd Step
+        case (STATE_INC << 4) | 0x1 :
+        case (STATE_DEC << 4) | 0x1 :
+        {
+            aluinx_dr = 1;
+            alufunc = r->state & 0x0f;
+            dw_do = 1;
+            if_do = 1;
+            w->pc_inc = 1;
+            w->seq_clr = 1;
+            w->state_next = STATE_DECODE;
+            break;
+        }
+        //---------------------------------
+        // OUT, from 2nd Step
+        case (STATE_OUT << 4) | 0x1 :
+        {
+            aluinx_dr = 1;
+            alufunc = ALUFUNC_THRU;
+            iw_do = 1;
+            if_do = 1;
+            w->pc_inc = 1;
+            w->seq_clr = 1;
+            w->state_next = STATE_DECODE;
+            break;
+        }
+        //---------------------------------
+        // IN, from 2nd Step
+        case (STATE_IN << 4) | 0x1 :
+        {
+            aluinx_ir = 1;
+            alufunc = ALUFUNC_THRU;
+            dw_do = 1;
+            if_do = 1;
+            w->pc_inc = 1;
+            w->seq_clr = 1;
+            w->state_next = STATE_DECODE;
+            break;
+        }
+        //---------------------------------
+        // BEGIN, from 2nd Step
+        case (STATE_BEGIN << 4) | 0x1 :
+        {
+            aluinx_dr = 1;
+            alufunc = ALUFUNC_THRU;
+            if_do = 1;
+            w->pc_inc = 1;
+            if (!aluzero)
+            {
+                w->seq_clr = 1;
+                w->state_next = STATE_DECODE;
+            }
+            else
+            {
+                w->indent_clr = 1;
+                w->seq_inc = 1;
+                w->state_next = STATE_BEGIN;
+            }
+            break;
+        }
+        case (STATE_BEGIN << 4) | 0x2 :
+        {
+            if_do = 1;
+            w->pc_inc = 1;
+            w->state_next = STATE_BEGIN;
+            if (indent_zero && (if_code == OPCODE_END))
+            {
+                w->seq_clr = 1;
+                w->state_next = STATE_DECODE;
+            }
+            else if (indent_plus && (if_code == OPCODE_END))
+                w->indent_dec = 1;
+            else if (if_code == OPCODE_BEGIN)
+                w->indent_inc = 1;
+            break;
+        }
+        //---------------------------------
+        // END, from 2nd Step
+        case (STATE_END << 4) | 0x1 :
+        {
+            aluinx_dr = 1;
+            alufunc = ALUFUNC_THRU;
+            if (aluzero)
+            {
+                if_do = 1;
+                w->pc_inc = 1;
+                w->seq_clr = 1;
+                w->state_next = STATE_DECODE;
+            }
+            else
+            {
+                w->pc_dec2 = 1;
+                w->indent_clr = 1;
+                w->seq_inc = 1;
+                w->state_next = STATE_END;
+            }
+            break;
+        }
+        case (STATE_END << 4) | 0x2 :
+        {
+            if_do = 1;
+            w->pc_dec = 1;
+            w->seq_inc = 1;
+            w->state_next = STATE_END;
+            break;
+        }
+        case (STATE_END << 4) | 0x3 :
+        {
+            w->state_next = STATE_END;
+            if (indent_zero && (if_code == OPCODE_BEGIN))
+            {
+                w->pc_inc2 = 1;
+                w->seq_inc = 1;
+            }
+            else
+            {
+                if_do = 1;
+                w->pc_dec = 1;
+                if (indent_plus && (if_code == OPCODE_BEGIN))
+                    w->indent_dec = 1;
+                else if (if_code == OPCODE_END)
+                    w->indent_inc = 1;
+            }
+            break;
+        }
+        case (STATE_END << 4) | 0x4 :
+        {
+            if_do = 1;
+            w->pc_inc = 1;
+            w->seq_clr = 1;
+            w->state_next = STATE_DECODE;
+            break;
+        }
+        //---------------------------------
+        default : // Never Reach Here
+        {
+            w->seq_clr = 1;
+            w->state_next = STATE_INIT;
+            break;
+        }
+    }
+    //
+    // ALU
+    aluinx = (aluinx_dr)? dr_data : (aluinx_ir)? ir_data : 0x00;
+    switch (alufunc)
+    {
+        case ALUFUNC_THRU : aluout = aluinx; break;
+        case ALUFUNC_INC  : aluout = (uint8_t)(aluinx + 1); break;
+        case ALUFUNC_DEC  : aluout = (uint8_t)(aluinx - 1); break;
+        default           : aluout = 0x00; break;
+    }
+    //
+    // Outputs
+    w->if_req   = if_do & w->slot;
+    w->if_addr  = r->pc;
+    w->dm_req   = (dr_do | dw_do) & w->slot;
+    w->dm_write = dw_do;
+    w->dm_addr  = r->ptr;
+    w->dm_wdata = aluout;
+    w->io_req   = (ir_do | iw_do) & w->slot;
+    w->io_write = iw_do;
+    w->io_addr  = io_addr;
+    w->io_wdata = aluout;
+}
+
+//----------------------------------
+// CACHE Comb, Requests from CPU (cache.sv)
+//----------------------------------
+static void CACHE_Comb(const sREGS *r, sWIRE *w)
+{
+    int  ie = (w->if_addr >> 3) & 3;
+    int  de = (w->dm_addr >> 2) & 1;
+    int  he = (r->dm_hit_dphase_addr >> 2) & 1;
+    uint8_t bus_count_0123 = !(r->bus_count & 4);
+    uint8_t req_data;
+    int  i;
+    //
+    // I-Cache
+    w->if_hit = w->if_req & r->ic_v[ie] & (r->ic_a[ie] == (w->if_addr >> 5));
+    w->if_mis_req = w->if_req & !w->if_hit;
+    //
+    // D-Cache
+    w->dm_hit = w->dm_req & r->dc_v[de] & (r->dc_a[de] == (w->dm_addr >> 3));
+    w->dm_mis_req = w->dm_req & !w->dm_hit;
+    w->bus_req_repl_addr = 0x8000 | (r->dc_a[de] << 3) | (de << 2);
+    //
+    // Update Data
+    for (i = 0; i < 2; i++)
+        w->dm_hit_dphase_update_data[i] = Byte_Set(r->dc_d[i], r->dm_hit_dphase_addr & 3, r->dm_hit_dphase_wdata);
+    w->dm_mis_dphase_update_data = Byte_Set(w->bus_rdy_rdata, r->dm_mis_dphase_addr & 3, r->dm_mis_dphase_wdata);
+    //
+    // Write Back Data to BUS
+    if (w->dm_mis_req & r->dm_hit_dphase & (de == 0) & (he == 0))
+        w->bus_req_wdata = w->dm_hit_dphase_update_data[0];
+    else if (w->dm_mis_req & r->dm_hit_dphase & (de == 1) & (he == 1))
+        w->bus_req_wdata = w->dm_hit_dphase_update_data[1];
+    else if (w->dm_mis_req)
+        w->bus_req_wdata = r->dc_d[de];
+    else if (r->dm_mis_dphase)
+        w->bus_req_wdata = w->dm_mis_dphase_update_data;
+    else
+        w->bus_req_wdata = 0;
+    //
+    // Bus Access Request (priority = Data)
+    w->bus_req_inst = (w->if_mis_req | r->if_mis_req_pend) & !w->dm_mis_req;
+    w->bus_req_read = w->dm_mis_req & !w->dm_write;
+    w->bus_req_wrte = w->dm_mis_req &  w->dm_write;
+    w->bus_req_repl = w->dm_mis_req & r->dc_v[de];
+    w->bus_req_addr = (w->dm_mis_req)? (0x8000 | w->dm_addr)
+                    : (r->if_mis_req_pend)? r->if_mis_req_addr_pend
+                    : (w->if_mis_req)? (w->if_addr >> 1)
+                    : 0x0000;
+    req_data = w->bus_req_read | w->bus_req_wrte;
+    //
+    // Bus Access
+    w->bus_req = w->bus_req_inst | req_data
+               | ((r->bus_inst | r->bus_read | r->bus_wrte) & !w->bus_count_end);
+    w->bus_write = (req_data & w->bus_req_repl)? 1
+                 : (w->bus_req_inst | r->bus_inst)? 0
+                 : ((r->bus_read | r->bus_wrte) & bus_count_0123)? 1
+                 : 0;
+    w->bus_addr = (req_data & !w->bus_req_repl)? (w->bus_req_addr & 0xfffc)
+                : (req_data &  w->bus_req_repl)? (w->bus_req_repl_addr & 0xfffc)
+                : (w->bus_req_inst)? (w->bus_req_addr & 0xfffc)
+                : ((r->bus_read | r->bus_wrte) & bus_count_0123)? ((r->bus_repl_addr & 0xfffc) | (r->bus_count & 3))
+                : (r->bus_read | r->bus_wrte)? ((r->bus_pend_addr & 0xfffc) | (r->bus_count & 3))
+                : (r->bus_inst)? ((r->bus_pend_addr & 0xfffc) | (r->bus_count & 3))
+                : 0x0000;
+    if (req_data)
+        w->bus_wdata = Byte(w->bus_req_wdata, 0);
+    else if ((r->bus_read | r->bus_wrte) && (r->bus_count >= 1) && (r->bus_count <= 3))
+        w->bus_wdata = Byte(r->bus_pend_wdata, r->bus_count);
+    else
+        w->bus_wdata = 0x00;
+}
+
+//----------------------------------
+// QSPI_SRAM Comb (qspi_sram.sv)
+//----------------------------------
+static void QSPI_Comb(const sREGS *r, sWIRE *w)
+{
+    uint8_t read = (r->q_state == QSPI_READ);
+    //
+    w->req_read = w->bus_req & !w->bus_write & r->q_bus_rdy;
+    w->req_wrte = w->bus_req &  w->bus_write & r->q_bus_rdy;
+    w->addr_cont = w->bus_req & (r->q_addr == w->bus_addr) & r->q_bus_rdy;
+    //
+    // Default Outputs
+    w->state_next_q = QSPI_STUP;
+    w->state_update = 0;
+    w->seq_clr_q = w->seq_inc_q = w->seq_dec_q = w->seq_dec2_q = 0;
+    w->bus_ready_set = w->bus_ready_clr = 0;
+    w->addr_inc = 0;
+    w->csn_assert = w->csn_negate = 0;
+    w->sckenb_set = w->sckenb_clr = 0;
+    w->txd_set_eqio = w->txd_set_rdcmd = w->txd_set_wrcmd = 0;
+    w->txd_set_addrh = w->txd_set_addrl = 0;
+    w->txd_set_wdata_qspi = w->txd_set_wdata_qspi_fwd = 0;
+    w->txd_sft_1bit = w->txd_sft_4bit = 0;
+    w->sio_e_set = w->sio_e_clr = 0;
+    w->rxd_capture = w->rxd_set_hi = w->rxd_set_lo = 0;
+    //
+    // Overwrite Outputs
+    switch ((r->q_state << 4) | r->q_seq)
+    {
+        //---------------------------------
+        // Startup
+        case (QSPI_STUP << 4) | 0x0 : case (QSPI_STUP << 4) | 0x1 :
+        case (QSPI_STUP << 4) | 0x2 : case (QSPI_STUP << 4) | 0x3 :
+        case (QSPI_STUP << 4) | 0x4 : case (QSPI_STUP << 4) | 0x5 :
+        case (QSPI_STUP << 4) | 0x6 : case (QSPI_STUP << 4) | 0x7 :
+        case (QSPI_STUP << 4) | 0x8 : case (QSPI_STUP << 4) | 0x9 :
+        case (QSPI_STUP << 4) | 0xa : case (QSPI_STUP << 4) | 0xb :
+        case (QSPI_STUP << 4) | 0xc : case (QSPI_STUP << 4) | 0xd :
+        case (QSPI_STUP << 4) | 0xe : case (QSPI_STUP << 4) | 0xf :
+        {
+            w->seq_clr_q = 1;
+            w->state_next_q = QSPI_INIT;
+            w->state_update = 1;
+            break;
+        }
+        //---------------------------------
+        // Send EQIO in SPI Mode
+        case (QSPI_INIT << 4) | 0x0 :
+        {
+            w->csn_assert = 1;
+            w->sckenb_set = 1;
+            w->txd_set_eqio = 1;
+            w->sio_e_set = 0x1;
+            w->seq_inc_q = 1;
+            break;
+        }
+        case (QSPI_INIT << 4) | 0x1 : case (QSPI_INIT << 4) | 0x2 :
+        case (QSPI_INIT << 4) | 0x3 : case (QSPI_INIT << 4) | 0x4 :
+        case (QSPI_INIT << 4) | 0x5 : case (QSPI_INIT << 4) | 0x6 :
+        case (QSPI_INIT << 4) | 0x7 :
+        {
+            w->txd_sft_1bit = 1;
+            w->bus_ready_set = (r->q_seq == 0x7);
+            w->seq_inc_q = 1;
+            break;
+        }
+        case (QSPI_INIT << 4) | 0x8 :
+        {
+            w->csn_negate = 1;
+            w->sckenb_clr = 1;
+            w->sio_e_clr = 0x1;
+            w->seq_clr_q = 1;
+            w->state_next_q = (w->req_wrte)? QSPI_WRTE : (w->req_read)? QSPI_READ : QSPI_IDLE;
+            w->bus_ready_clr = w->req_wrte | w->req_read;
+            w->state_update = 1;
+            break;
+        }
+        //---------------------------------
+        // Wait for Bus Access
+        case (QSPI_IDLE << 4) | 0x0 : case (QSPI_IDLE << 4) | 0x1 :
+        case (QSPI_IDLE << 4) | 0x2 : case (QSPI_IDLE << 4) | 0x3 :
+        case (QSPI_IDLE << 4) | 0x4 : case (QSPI_IDLE << 4) | 0x5 :
+        case (QSPI_IDLE << 4) | 0x6 : case (QSPI_IDLE << 4) | 0x7 :
+        case (QSPI_IDLE << 4) | 0x8 : case (QSPI_IDLE << 4) | 0x9 :
+        case (QSPI_IDLE << 4) | 0xa : case (QSPI_IDLE << 4) | 0xb :
+        case (QSPI_IDLE << 4) | 0xc : case (QSPI_IDLE << 4) | 0xd :
+        case (QSPI_IDLE << 4) | 0xe : case (QSPI_IDLE << 4) | 0xf :
+        {
+            w->seq_clr_q = 1;
+            w->state_next_q = (w->req_wrte)? QSPI_WRTE : (w->req_read)? QSPI_READ : QSPI_IDLE;
+            w->bus_ready_clr = w->req_wrte | w->req_read;
+            w->state_update = 1;
+            break;
+        }
+        //---------------------------------
+        // Command and Address (READ, WRITE)
+        case (QSPI_WRTE << 4) | 0x0 :
+        case (QSPI_READ << 4) | 0x0 :
+        {
+            w->csn_assert = 1;
+            w->sckenb_set = 1;
+            w->txd_set_rdcmd =  read;
+            w->txd_set_wrcmd = !read;
+            w->sio_e_set = 0xf;
+            w->seq_inc_q = 1;
+            break;
+        }
+        case (QSPI_WRTE << 4) | 0x1 : case (QSPI_WRTE << 4) | 0x3 :
+        case (QSPI_WRTE << 4) | 0x5 :
+        case (QSPI_READ << 4) | 0x1 : case (QSPI_READ << 4) | 0x3 :
+        case (QSPI_READ << 4) | 0x5 :
+        {
+            w->txd_sft_4bit = 1;
+            w->seq_inc_q = 1;
+            break;
+        }
+        case (QSPI_WRTE << 4) | 0x2 :
+        case (QSPI_READ << 4) | 0x2 :
+        {
+            w->txd_set_addrh = 1;
+            w->seq_inc_q = 1;
+            break;
+        }
+        case (QSPI_WRTE << 4) | 0x4 :
+        case (QSPI_READ << 4) | 0x4 :
+        {
+            w->txd_set_addrl = 1;
+            w->seq_inc_q = 1;
+            break;
+        }
+        //---------------------------------
+        // Write Data
+        case (QSPI_WRTE << 4) | 0x6 :
+        {
+            w->txd_set_wdata_qspi = 1;
+            w->seq_inc_q = 1;
+            break;
+        }
+        case (QSPI_WRTE << 4) | 0x7 :
+        {
+            w->txd_sft_4bit = 1;
+            w->bus_ready_set = 1;
+            w->addr_inc = 1;
+            w->seq_inc_q = 1;
+            break;
+        }
+        case (QSPI_WRTE << 4) | 0x8 :
+        {
+            if (w->req_wrte & w->addr_cont)
+            {
+                w->bus_ready_clr = 1;
+                w->txd_set_wdata_qspi_fwd = 1;
+                w->sckenb_set = 1;
+                w->sio_e_set = 0xf;
+                w->seq_dec_q = 1;
+            }
+            else if (w->req_wrte | w->req_read)
+            {
+                w->csn_negate = 1;
+                w->sckenb_clr = 1;
+                w->sio_e_clr = 0xf;
+                w->seq_clr_q = 1;
+                w->state_next_q = (w->req_wrte)? QSPI_WRTE : QSPI_READ;
+                w->bus_ready_clr = 1;
+                w->state_update = 1;
+            }
+            else // wait for bus access command
+            {
+                w->sckenb_clr = 1;
+                w->sio_e_clr = 0xf;
+            }
+            break;
+        }
+        //---------------------------------
+        // Read Data
+        case (QSPI_READ << 4) | 0x6 :
+        {
+            w->sio_e_clr = 0xf;
+            w->seq_inc_q = 1;
+            break;
+        }
+        case (QSPI_READ << 4) | 0x7 :
+        case (QSPI_READ << 4) | 0x8 :
+        {
+            w->seq_inc_q = 1;
+            break;
+        }
+        case (QSPI_READ << 4) | 0x9 :
+        {
+            w->rxd_capture = 1;
+            w->rxd_set_hi = 1;
+            w->addr_inc = 1;
+            w->seq_inc_q = 1;
+            break;
+        }
+        case (QSPI_READ << 4) | 0xa :
+        {
+            w->sckenb_clr = 1;
+            w->rxd_capture = 1;
+            w->rxd_set_lo = 1;
+            w->bus_ready_set = 1;
+            w->seq_inc_q = 1;
+            break;
+        }
+        case (QSPI_READ << 4) | 0xb :
+        {
+            if (w->req_read & w->addr_cont)
+            {
+                w->bus_ready_clr = 1;
+                w->sckenb_set = 1;
+                w->seq_dec2_q = 1;
+            }
+            else if (w->req_wrte | w->req_read)
+            {
+                w->csn_negate = 1;
+                w->sckenb_clr = 1;
+                w->sio_e_clr = 0xf;
+                w->seq_clr_q = 1;
+                w->state_next_q = (w->req_wrte)? QSPI_WRTE : QSPI_READ;
+                w->bus_ready_clr = 1;
+                w->state_update = 1;
+            }
+            break;
+        }
+        //---------------------------------
+        default : // Never Reach Here
+        {
+            w->seq_clr_q = 1;
+            w->state_next_q = QSPI_STUP;
+            w->state_update = 1;
+            break;
+        }
+    }
+}
+
+//----------------------------------
+// UART Comb, Requests from CPU (uart.sv, sasc)
+//----------------------------------
+static void UART_Comb(const sREGS *r, sWIRE *w)
+{
+    uint8_t io_w = w->io_req &  w->io_write & w->io_rdy;
+    uint8_t io_r = w->io_req & !w->io_write & w->io_rdy;
+    //
+    w->div0_aphase = io_w & (w->io_addr == 2);
+    w->div1_aphase = io_w & (w->io_addr == 3);
+    w->txd_aphase  = io_w & (w->io_addr == 0);
+    w->rxd_aphase  = io_r & (w->io_addr == 0);
+    w->we = r->txd_dphase & w->io_rdy;
+    w->re = r->rxd_dphase & w->io_rdy;
+    //
+    // sasc_top
+    w->load_e = r->load & r->sio_ce;
+    w->start = (r->rxd_r == 1) && (r->rxd_s == 0);
+    w->rx_we = !r->rx_valid_r && r->rx_valid && !FIFO_Full(&r->rx_fifo);
+    //
+    // Receiver DPLL
+    w->rx_sio_ce_d = 0;
+    switch (r->dpll_state)
+    {
+        case 0  : w->dpll_next_state = (r->change)? 0 : 1; break;
+        case 1  : w->rx_sio_ce_d = 1;
+                  w->dpll_next_state = (r->change)? 3 : 2; break;
+        case 2  : w->dpll_next_state = (r->change)? 0 : 3; break;
+        default : w->dpll_next_state = 0; break;
+    }
+}
+
+//----------------------------------
+// Evaluate all Combinational Logic
+//----------------------------------
+static void Cycle_Comb(const sCYCLE *psCYC, sWIRE *w)
+{
+    const sREGS *r = &psCYC->r;
+    //
+    UART_Comb_Ready(r, w);
+    CACHE_Comb_Ready(r, w);
+    CPU_Comb(psCYC, r, w);
+    CACHE_Comb(r, w);
+    QSPI_Comb(r, w);
+    UART_Comb(r, w);
+}
+
+//----------------------------------
+// QSPI SIO Pins (Open Drain with Pullup)
+//     23LC512 drives SIO only in READ of SQI Mode.
+//----------------------------------
+static uint8_t Cycle_SIO(const sCYCLE *psCYC)
+{
+    const sREGS *r = &psCYC->r;
+    const sSRAM *s = &psCYC->sram;
+    uint8_t sio = 0xf;
+    //
+    if (s->so_enable && s->sqi && (r->q_cs_n == 0)) sio = s->dso >> 4;
+    sio &= ~(r->q_sio_e & ~(r->q_txd >> 4)) & 0xf;
+    return sio;
+}
+
+//----------------------------------
+// 23LC512 at Rising Edge of SCK
+//----------------------------------
+static void SRAM_SCK_Rise(sSRAM *s, uint8_t sio, int cs_n)
+{
+    uint32_t cc = s->cc;
+    uint8_t  byte;
+    //
+    byte = (s->sqi)? (uint8_t)((s->dsi << 4) | sio) : (uint8_t)((s->dsi << 1) | (sio & 1));
+    s->dsi = byte;
+    if (cs_n == 0) s->cc = cc + 1;
+    //
+    // SPI Mode (EQIO only)
+    if (s->sqi == 0)
+    {
+        if (cc == 7)
+        {
+            s->inst = byte;
+            if (byte == SRAM_EQIO) s->sqi = 1;
+        }
+        return;
+    }
+    //
+    // SQI Mode
+    if (cc == 1) s->inst = byte;
+    if ((s->inst == SRAM_READ) || (s->inst == SRAM_WRITE))
+    {
+        if (cc == 3) s->addr = (uint16_t)((s->addr & 0x00ff) | (byte << 8));
+        if (cc == 5) s->addr = (uint16_t)((s->addr & 0xff00) | byte);
+    }
+    if ((s->inst == SRAM_WRITE) && (cc >= 7) && (cc & 1))
+    {
+        s->mem[s->addr] = byte;
+        s->addr++;
+    }
+}
+
+//----------------------------------
+// 23LC512 at Falling Edge of SCK
+//----------------------------------
+static void SRAM_SCK_Fall(sSRAM *s)
+{
+    if ((s->sqi == 0) || (s->inst != SRAM_READ)) return;
+    //
+    if ((s->cc >= 8) && ((s->cc & 1) == 0))
+    {
+        s->dso = s->mem[s->addr];
+        s->so_enable = 1;
+        s->addr++;
+    }
+    else
+        s->dso = (uint8_t)(s->dso << 4);
+}
+
+//----------------------------------
+// UART_RXD from Host
+//     Bit k of the frame (0:idle, 1:start,
+//     2-9:data, 10:stop) is seen from the
+//     (k * bit + 1)th cycle after the request,
+//     as tb.sv drives it 1ns after the clock.
+//----------------------------------
+static uint8_t Cycle_RXD(sCYCLE *psCYC)
+{
+    uint64_t k;
+    //
+    if (psCYC->rx_busy == 0) return 1;
+    k = (psCYC->cycle - psCYC->rx_start - 1) / psCYC->rx_bit;
+    if (k >= psCYC->rx_end) psCYC->rx_busy = 0;
+    if (k == 1) return 0;
+    if ((k >= 2) && (k <= 9)) return (psCYC->rx_data >> (k - 2)) & 1;
+    return 1;
+}
+
+//----------------------------------
+// Print a Trace Line
+//     Same format as TRACE_CYCLE in tb.sv
+//----------------------------------
+static void Cycle_Trace(const sCYCLE *psCYC, const sWIRE *w, uint8_t rxd)
+{
+    const sREGS *r = &psCYC->r;
+    //
+    fprintf(psCYC->fp_trace, "CYC %" PRIu64 " S=%02x%x PC=%04x PTR=%04x B=%d%d %04x %02x %02x %d Q=%x%x T=%d%d\n",
+        psCYC->cycle, r->state, r->seq, r->pc, r->ptr,
+        w->bus_req, w->bus_write, w->bus_addr, w->bus_wdata, r->q_rxd, r->q_bus_rdy,
+        r->q_state, r->q_seq, r->txd_o, rxd);
+}
+
+//----------------------------------
+// All Registers at Positive Edge
+//----------------------------------
+static void Cycle_Posedge(sCYCLE *psCYC, const sWIRE *w, uint8_t rxd)
+{
+    sREGS *r = &psCYC->r;
+    sREGS  o = psCYC->r; // values before the edge
+    uint8_t req_data = w->bus_req_read | w->bus_req_wrte;
+    int  i;
+    //
+    //----------------------------
+    // CPU
+    //----------------------------
+    if (w->if_req & w->if_rdy) r->if_do_dphase = 1;
+    else if (w->if_rdy)        r->if_do_dphase = 0;
+    if (o.if_do_dphase & w->if_rdy) r->if_code_keep = w->if_code;
+    if (w->dm_req & !w->dm_write & w->dm_rdy) r->dr_do_dphase = 1;
+    else if (w->dm_rdy)                       r->dr_do_dphase = 0;
+    if (o.dr_do_dphase & w->dm_rdy) r->dr_data_keep = w->dm_rdata;
+    if (w->io_req & !w->io_write & w->io_rdy) r->ir_do_dphase = 1;
+    else if (w->slot)                         r->ir_do_dphase = 0;
+    if (o.ir_do_dphase & w->io_rdy) r->ir_data_keep = w->io_rdata;
+    if (w->slot)
+    {
+        if      (w->pc_clr ) r->pc = 0;
+        else if (w->pc_inc ) r->pc = o.pc + 1;
+        else if (w->pc_dec ) r->pc = o.pc - 1;
+        else if (w->pc_inc2) r->pc = o.pc + 2;
+        else if (w->pc_dec2) r->pc = o.pc - 2;
+        if      (w->ptr_clr) r->ptr = 0;
+        else if (w->ptr_inc) r->ptr = (o.ptr + 1) & 0x7fff;
+        else if (w->ptr_dec) r->ptr = (o.ptr - 1) & 0x7fff;
+        if      (w->indent_clr) r->indent = 0;
+        else if (w->indent_inc) r->indent = o.indent + 1;
+        else if (w->indent_dec) r->indent = o.indent - 1;
+        r->state = w->state_next;
+        if      (w->seq_clr) r->seq = 0;
+        else if (w->seq_inc) r->seq = (o.seq + 1) & 0xf;
+    }
+    //
+    //----------------------------
+    // CACHE (I-Cache)
+    //----------------------------
+    if (w->if_hit & w->if_slot)
+    {
+        r->if_hit_dphase = 1;
+        r->if_hit_dphase_addr = w->if_addr & 0x1f;
+    }
+    else if (w->if_slot)
+    {
+        r->if_hit_dphase = 0;
+        r->if_hit_dphase_addr = 0;
+    }
+    if (w->if_mis_req & w->if_slot)
+    {
+        r->if_mis_dphase = 1;
+        r->if_mis_dphase_addr = w->if_addr;
+        r->ic_v[(w->if_addr >> 3) & 3] = 1;
+        r->ic_a[(w->if_addr >> 3) & 3] = w->if_addr >> 5;
+    }
+    else if (w->if_slot)
+    {
+        r->if_mis_dphase = 0;
+        r->if_mis_dphase_addr = 0;
+    }
+    if (o.if_mis_dphase & w->if_slot) r->ic_d[(o.if_mis_dphase_addr >> 3) & 3] = w->bus_rdy_rdata;
+    //
+    //----------------------------
+    // CACHE (D-Cache, Write Back)
+    //----------------------------
+    if (w->dm_hit & w->dm_slot)
+    {
+        r->dm_hit_dphase = 1;
+        r->dm_hit_dphase_write = w->dm_write;
+        r->dm_hit_dphase_addr = w->dm_addr & 7;
+        r->dm_hit_dphase_wdata = w->dm_wdata;
+    }
+    else if (w->dm_slot)
+    {
+        r->dm_hit_dphase = 0;
+        r->dm_hit_dphase_write = 0;
+        r->dm_hit_dphase_addr = 0;
+        r->dm_hit_dphase_wdata = 0;
+    }
+    if (w->dm_mis_req & w->dm_slot)
+    {
+        r->dm_mis_dphase = 1;
+        r->dm_mis_dphase_write = w->dm_write;
+        r->dm_mis_dphase_addr = w->dm_addr;
+        r->dm_mis_dphase_wdata = w->dm_wdata;
+        r->dc_v[(w->dm_addr >> 2) & 1] = 1;
+        r->dc_a[(w->dm_addr >> 2) & 1] = w->dm_addr >> 3;
+    }
+    else if (w->dm_slot)
+    {
+        r->dm_mis_dphase = 0;
+        r->dm_mis_dphase_write = 0;
+        r->dm_mis_dphase_addr = 0;
+        r->dm_mis_dphase_wdata = 0;
+    }
+    if (o.dm_hit_dphase & o.dm_hit_dphase_write & w->dm_slot)
+    {
+        i = (o.dm_hit_dphase_addr >> 2) & 1;
+        r->dc_d[i] = w->dm_hit_dphase_update_data[i];
+    }
+    else if (o.dm_mis_dphase & o.dm_mis_dphase_write & w->dm_slot)
+        r->dc_d[(o.dm_mis_dphase_addr >> 2) & 1] = w->dm_mis_dphase_update_data;
+    else if (o.dm_mis_dphase & w->dm_slot)
+        r->dc_d[(o.dm_mis_dphase_addr >> 2) & 1] = w->bus_rdy_rdata;
+    //
+    //----------------------------
+    // CACHE (Bus Access Sequencer)
+    //----------------------------
+    if (o.q_bus_rdy)
+    {
+        if (w->bus_req_inst)                  r->bus_count = 5;
+        else if (req_data &  w->bus_req_repl) r->bus_count = 1;
+        else if (req_data & !w->bus_req_repl) r->bus_count = 5;
+        else if (!w->bus_count_end)           r->bus_count = (o.bus_count + 1) & 7;
+        //
+        if (w->bus_req_inst)       r->bus_inst = 1;
+        else if (w->bus_count_end) r->bus_inst = 0;
+        if (w->bus_req_read)       r->bus_read = 1;
+        else if (w->bus_count_end) r->bus_read = 0;
+        if (w->bus_req_wrte)       r->bus_wrte = 1;
+        else if (w->bus_count_end) r->bus_wrte = 0;
+        if (req_data)
+        {
+            r->bus_repl = w->bus_req_repl;
+            r->bus_repl_addr = w->bus_req_repl_addr;
+        }
+        else if (w->bus_count_end)
+        {
+            r->bus_repl = 0;
+            r->bus_repl_addr = 0;
+        }
+        if (w->bus_req_inst | req_data) r->bus_pend_addr = w->bus_req_addr;
+        if (req_data) r->bus_pend_wdata = w->bus_req_wdata;
+        if ((o.bus_inst | o.bus_read | o.bus_wrte) && ((o.bus_count >= 5) || (o.bus_count == 0)))
+            r->bus_pend_rdata = Byte_Set(o.bus_pend_rdata, (o.bus_count - 5) & 3, o.q_rxd);
+    }
+    if (w->if_mis_req & w->dm_mis_req & w->bus_rdy)
+    {
+        r->if_mis_req_pend = 1;
+        r->if_mis_req_addr_pend = w->if_addr >> 1;
+    }
+    else if (o.if_mis_req_pend & !w->dm_mis_req & w->bus_rdy)
+    {
+        r->if_mis_req_pend = 0;
+        r->if_mis_req_addr_pend = 0;
+    }
+    //
+    //----------------------------
+    // QSPI_SRAM
+    //----------------------------
+    if (w->req_read | w->req_wrte) r->q_addr = w->bus_addr;
+    else if (w->addr_inc)          r->q_addr = o.q_addr + 1;
+    if (w->req_wrte) r->q_wdata = w->bus_wdata;
+    if (w->bus_ready_clr & o.q_bus_rdy)       r->q_bus_rdy = 0;
+    else if (w->bus_ready_set & !o.q_bus_rdy) r->q_bus_rdy = 1;
+    if (w->csn_assert)      r->q_cs_n = 0;
+    else if (w->csn_negate) r->q_cs_n = 1;
+    if (w->sckenb_set)      r->q_sckenb = 1;
+    else if (w->sckenb_clr) r->q_sckenb = 0;
+    if (w->txd_sft_1bit)                r->q_txd = (uint8_t)((o.q_txd << 1) | (o.q_txd >> 7));
+    else if (w->txd_set_eqio)           r->q_txd = 0x07; // 0x38 rotated
+    else if (w->txd_set_wdata_qspi)     r->q_txd = o.q_wdata;
+    else if (w->txd_set_wdata_qspi_fwd) r->q_txd = w->bus_wdata;
+    else if (w->txd_sft_4bit)           r->q_txd = (uint8_t)((o.q_txd << 4) | (o.q_txd >> 4));
+    else if (w->txd_set_rdcmd)          r->q_txd = SRAM_READ;
+    else if (w->txd_set_wrcmd)          r->q_txd = SRAM_WRITE;
+    else if (w->txd_set_addrh)          r->q_txd = o.q_addr >> 8;
+    else if (w->txd_set_addrl)          r->q_txd = o.q_addr & 0xff;
+    r->q_sio_e = w->sio_e_set | (o.q_sio_e & ~w->sio_e_clr);
+    if (w->rxd_set_hi)      r->q_rxd = (uint8_t)((o.q_rxd_temp << 4) | (o.q_rxd & 0x0f));
+    else if (w->rxd_set_lo) r->q_rxd = (uint8_t)((o.q_rxd & 0xf0) | o.q_rxd_temp);
+    if (w->state_update) r->q_state = w->state_next_q;
+    if      (w->seq_clr_q ) r->q_seq = 0;
+    else if (w->seq_inc_q ) r->q_seq = (o.q_seq + 1) & 0xf;
+    else if (w->seq_dec_q ) r->q_seq = (o.q_seq - 1) & 0xf;
+    else if (w->seq_dec2_q) r->q_seq = (o.q_seq - 2) & 0xf;
+    //
+    //----------------------------
+    // UART
+    //----------------------------
+    if (w->div0_aphase) r->div0_dphase = 1;
+    else if (w->io_rdy) r->div0_dphase = 0;
+    if (w->div1_aphase) r->div1_dphase = 1;
+    else if (w->io_rdy) r->div1_dphase = 0;
+    if (w->div0_aphase) r->div0 = w->io_wdata;
+    if (w->div1_aphase) r->div1 = w->io_wdata;
+    if (w->txd_aphase)  r->din = w->io_wdata;
+    else if (w->io_rdy) r->din = 0;
+    if (w->txd_aphase)  r->txd_dphase = 1;
+    else if (w->io_rdy) r->txd_dphase = 0;
+    if (w->rxd_aphase)  r->rxd_dphase = 1;
+    else if (w->io_rdy) r->rxd_dphase = 0;
+    //
+    //----------------------------
+    // sasc_brg
+    //----------------------------
+    r->ps = (o.ps_clr)? 0 : (uint8_t)(o.ps + 1);
+    r->ps_clr = (o.ps == o.div0);
+    if (o.br_clr)      r->br_cnt = 0;
+    else if (o.ps_clr) r->br_cnt = (uint8_t)(o.br_cnt + 1);
+    r->br_clr = (o.br_cnt == o.div1);
+    r->sio_ce_x4_r = o.br_clr;
+    r->sio_ce_x4_t = !o.sio_ce_x4_r && o.br_clr;
+    r->sio_ce_x4 = o.sio_ce_x4_t;
+    if (!o.sio_ce_x4_r && o.br_clr) r->cnt = (o.cnt + 1) & 3;
+    r->sio_ce_r = (o.cnt == 0);
+    r->sio_ce = !o.sio_ce_r & (o.cnt == 0);
+    //
+    //----------------------------
+    // sasc_top (Transmit)
+    //----------------------------
+    if (o.sio_ce) r->txf_empty_r = FIFO_Empty(&o.tx_fifo);
+    r->load = !o.txf_empty_r & !o.shift_en;
+    if (w->load_e)                  r->hold_reg = 0x200 | (o.tx_fifo.mem[o.tx_fifo.rp] << 1);
+    else if (o.shift_en & o.sio_ce) r->hold_reg = 0x200 | (o.hold_reg >> 1);
+    if (o.sio_ce) r->txd_o = (o.shift_en | o.shift_en_r)? (o.hold_reg & 1) : 1;
+    if (w->load_e)                  r->tx_bit_cnt = 0;
+    else if (o.shift_en & o.sio_ce) r->tx_bit_cnt = (o.tx_bit_cnt + 1) & 0xf;
+    r->shift_en = (o.tx_bit_cnt != 9);
+    if (o.sio_ce) r->shift_en_r = o.shift_en;
+    FIFO_Posedge(&r->tx_fifo, &o.tx_fifo, o.din, w->we, w->load_e);
+    //
+    //----------------------------
+    // sasc_top (Receive)
+    //----------------------------
+    r->rxd_dly = (uint8_t)(((o.rxd_dly << 1) | rxd) & 0x3f);
+    r->rxd_s = (o.rxd_dly >> 5) & 1;
+    r->rxd_r = o.rxd_s;
+    if (!o.rx_go && w->start)        r->rx_bit_cnt = 0;
+    else if (o.rx_go & o.rx_sio_ce) r->rx_bit_cnt = (o.rx_bit_cnt + 1) & 0xf;
+    r->rx_go = (o.rx_bit_cnt != 0xa);
+    r->rx_valid = (o.rx_bit_cnt == 9);
+    r->rx_valid_r = o.rx_valid;
+    if (o.rx_go & o.rx_sio_ce) r->rxr = (uint16_t)((o.rxd_s << 9) | (o.rxr >> 1));
+    if (o.sio_ce_x4) r->rxd_r1 = o.rxd_s;
+    if ((((o.rxd_dly >> 1) & 1) != o.rxd_r1) || (((o.rxd_dly >> 1) & 1) != o.rxd_s)) r->change = 1;
+    else if (o.sio_ce_x4) r->change = 0;
+    if (o.sio_ce_x4) r->dpll_state = w->dpll_next_state;
+    r->rx_sio_ce_r1 = w->rx_sio_ce_d;
+    r->rx_sio_ce_r2 = o.rx_sio_ce_r1;
+    r->rx_sio_ce = o.rx_sio_ce_r1 & !o.rx_sio_ce_r2;
+    FIFO_Posedge(&r->rx_fifo, &o.rx_fifo, (o.rxr >> 2) & 0xff, w->rx_we, w->re);
+    //
+    //----------------------------
+    // tb.sv
+    //----------------------------
+    r->detect_in = o.rxd_dphase;
+}
+
+//----------------------------------
+// UART_TXD to Host
+//     Same as tb.sv, sampled in the middle
+//     of each bit after the falling edge.
+//----------------------------------
+static unsigned Cycle_TXD(sCYCLE *psCYC, uint8_t txd_old)
+{
+    uint64_t t;
+    uint32_t half = psCYC->tx_bit / 2;
+    //
+    if (psCYC->tx_busy)
+    {
+        t = psCYC->cycle - psCYC->tx_start;
+        if ((t > half) && ((t - half) % psCYC->tx_bit == 0))
+        {
+            t = (t - half) / psCYC->tx_bit;
+            if ((t >= 1) && (t <= 8)) psCYC->tx_data |= txd_old << (t - 1);
+            if (t == 9)
+            {
+                psCYC->tx_busy = 0;
+                psCYC->data = psCYC->tx_data;
+                return 1u << CYCLE_EV_TXD;
+            }
+        }
+        return 0;
+    }
+    if ((txd_old == 1) && (psCYC->r.txd_o == 0))
+    {
+        psCYC->tx_bit = (psCYC->mode == CYCLE_MODE_TB)? CYCLE_TB_BIT : psCYC->ce_period;
+        psCYC->tx_busy = (psCYC->tx_bit > 0);
+        psCYC->tx_start = psCYC->cycle;
+        psCYC->tx_data = 0;
+    }
+    return 0;
+}
+
+//----------------------------------
+// UART_RXD Request from CPU
+//     tb.sv sends a byte at each rise of detect_in
+//     if it is not sending. In HW Mode, the host is
+//     asked for a byte while the CPU waits for it.
+//----------------------------------
+static unsigned Cycle_RXD_Request(sCYCLE *psCYC, uint8_t detect_old)
+{
+    sREGS *r = &psCYC->r;
+    //
+    if (psCYC->rx_busy || psCYC->rx_wait) return 0;
+    if (psCYC->mode == CYCLE_MODE_TB)
+    {
+        if ((detect_old == 1) || (r->detect_in == 0)) return 0;
+        psCYC->rx_bit = CYCLE_TB_BIT;
+        psCYC->rx_end = 10;
+        psCYC->rx_start = psCYC->cycle;
+        psCYC->rx_data = (uint8_t)(psCYC->rx_seq + 2);
+        psCYC->rx_seq++;
+        psCYC->rx_busy = 1;
+        psCYC->data = psCYC->rx_data;
+        return 1u << CYCLE_EV_RXD;
+    }
+    if (r->rxd_dphase && FIFO_Empty(&r->rx_fifo) && psCYC->ce_period)
+    {
+        psCYC->rx_bit = psCYC->ce_period;
+        psCYC->rx_end = 11; // wait for the stop bit
+        psCYC->rx_start = psCYC->cycle;
+        psCYC->rx_wait = 1;
+        return 1u << CYCLE_EV_RXD;
+    }
+    return 0;
+}
+
+//----------------------------------
+// One Clock Cycle
+//     Negative Edge, then Positive Edge
+//     Returns a bit mask of CYCLE_EVENT.
+//----------------------------------
+static unsigned Cycle_Clock(sCYCLE *psCYC, int reset)
+{
+    sREGS *r = &psCYC->r;
+    sSRAM *s = &psCYC->sram;
+    sWIRE  w;
+    uint8_t sio, rxd, txd_old, sck_old, csn_old, detect_old;
+    unsigned event = 0;
+    //
+    Cycle_Comb(psCYC, &w);
+    //
+    // During Reset, only Registers without Reset move.
+    if (reset)
+    {
+        Cycle_Posedge(psCYC, &w, 1);
+        Cycle_Reset(r);
+        return 0;
+    }
+    //
+    // Negative Edge (QSPI_SCK rises if enabled)
+    sio = Cycle_SIO(psCYC);
+    if (w.rxd_capture) r->q_rxd_temp = sio;
+    r->q_sckenb2 = r->q_sckenb;
+    if (r->q_sckenb) SRAM_SCK_Rise(s, sio, r->q_cs_n);
+    //
+    // Positive Edge
+    rxd = Cycle_RXD(psCYC);
+    if (psCYC->fp_trace) Cycle_Trace(psCYC, &w, rxd);
+    if ((r->state == STATE_DECODE) && (r->seq == 0) && w.slot)
+    {
+        psCYC->count++;
+        if (w.if_code == OPCODE_RESET) event |= 1u << CYCLE_EV_RESET;
+    }
+    if (w.if_req) {if (w.if_hit) psCYC->ic_hit++; else psCYC->ic_miss++;}
+    if (w.dm_req) {if (w.dm_hit) psCYC->dc_hit++; else psCYC->dc_miss++;}
+    if (w.bus_req & r->q_bus_rdy) psCYC->bus++;
+    txd_old = r->txd_o;
+    sck_old = r->q_sckenb;
+    csn_old = r->q_cs_n;
+    detect_old = r->detect_in;
+    Cycle_Posedge(psCYC, &w, rxd);
+    //
+    // 23LC512 (QSPI_SCK falls, then CS_N may fall)
+    if (sck_old) SRAM_SCK_Fall(s);
+    if (csn_old && !r->q_cs_n)
+    {
+        s->cc = 0;
+        s->so_enable = 0;
+    }
+    //
+    // UART Bit Width
+    if (r->sio_ce)
+    {
+        if (psCYC->ce_last) psCYC->ce_period = (uint32_t)(psCYC->cycle - psCYC->ce_last);
+        psCYC->ce_last = psCYC->cycle;
+    }
+    //
+    // UART to/from Host
+    event |= Cycle_TXD(psCYC, txd_old);
+    event |= Cycle_RXD_Request(psCYC, detect_old);
+    psCYC->cycle++;
+    return event;
+}
+
+//----------------------------------
+// Create a System
+//     sram is the whole 64KB image of 23LC512.
+//     Returns NULL if memory can't be allocated.
+//----------------------------------
+sCYCLE *CYCLE_Create(const unsigned char *sram, int mode)
+{
+    sCYCLE *psCYC;
+    int  i;
+    //
+    psCYC = (sCYCLE*)calloc(1, sizeof(sCYCLE));
+    if (psCYC == NULL) return NULL;
+    psCYC->sram.mem = (unsigned char*)malloc(CYCLE_SRAM_SIZE);
+    if (psCYC->sram.mem == NULL)
+    {
+        CYCLE_Destroy(psCYC);
+        return NULL;
+    }
+    memcpy(psCYC->sram.mem, sram, CYCLE_SRAM_SIZE);
+    psCYC->mode = mode;
+    psCYC->ptr_end = (mode == CYCLE_MODE_TB)? PTR_END_TB : PTR_END_HW;
+    //
+    // Registers without Reset (UART_RXD is idle)
+    psCYC->r.rxd_dly = 0x3f;
+    psCYC->r.rxd_s = 1;
+    psCYC->r.rxd_r = 1;
+    //
+    // Reset Cycles
+    Cycle_Reset(&psCYC->r);
+    for (i = 0; i < CYCLE_RESET; i++) Cycle_Clock(psCYC, 1);
+    return psCYC;
+}
+
+//----------------------------------
+// Destroy a System
+//----------------------------------
+void CYCLE_Destroy(sCYCLE *psCYC)
+{
+    if (psCYC == NULL) return;
+    free(psCYC->sram.mem);
+    free(psCYC);
+}
+
+//----------------------------------
+// Run Cycles
+//     Runs until an event or max_cycles
+//     (0 for no limit), and returns the
+//     event. Events of the same cycle are
+//     returned one by one.
+//----------------------------------
+int CYCLE_Run(sCYCLE *psCYC, uint64_t max_cycles)
+{
+    uint64_t n;
+    int  event;
+    //
+    for (n = 0; (psCYC->pending == 0) && ((max_cycles == 0) || (n < max_cycles)); n++)
+    {
+        psCYC->pending = Cycle_Clock(psCYC, 0);
+    }
+    if (psCYC->pending == 0) return CYCLE_EV_LIMIT;
+    for (event = CYCLE_EV_TXD; (psCYC->pending & (1u << event)) == 0; event++);
+    psCYC->pending &= ~(1u << event);
+    return event;
+}
+
+//----------------------------------
+// Send a Byte to UART_RXD
+//     Only after CYCLE_EV_RXD in HW Mode.
+//----------------------------------
+int CYCLE_Feed_RXD(sCYCLE *psCYC, unsigned char data)
+{
+    if (psCYC->rx_wait == 0) return CYCLE_ERR_STATE;
+    psCYC->rx_wait = 0;
+    psCYC->rx_data = data;
+    psCYC->rx_busy = 1;
+    return CYCLE_OK;
+}
+
+//----------------------------------
+// Get System State
+//----------------------------------
+void CYCLE_Get_State(const sCYCLE *psCYC, sCYCLE_STATE *psSTATE)
+{
+    psSTATE->cycle   = psCYC->cycle;
+    psSTATE->pc      = psCYC->r.pc;
+    psSTATE->ptr     = psCYC->r.ptr;
+    psSTATE->data    = psCYC->data;
+    psSTATE->count   = psCYC->count;
+    psSTATE->ic_hit  = psCYC->ic_hit;
+    psSTATE->ic_miss = psCYC->ic_miss;
+    psSTATE->dc_hit  = psCYC->dc_hit;
+    psSTATE->dc_miss = psCYC->dc_miss;
+    psSTATE->bus     = psCYC->bus;
+}
+
+//----------------------------------
+// Get Data Memory seen from CPU
+//     SRAM 0x8000-0xffff with the valid
+//     lines of D-Cache written over.
+//----------------------------------
+void CYCLE_Get_RAM(const sCYCLE *psCYC, unsigned char *ram)
+{
+    const sREGS *r = &psCYC->r;
+    uint32_t addr;
+    int  e, i;
+    //
+    memcpy(ram, psCYC->sram.mem + CYCLE_RAM_SIZE, CYCLE_RAM_SIZE);
+    for (e = 0; e < 2; e++)
+    {
+        if (r->dc_v[e] == 0) continue;
+        addr = ((uint32_t)r->dc_a[e] << 3) | (e << 2);
+        for (i = 0; i < 4; i++) ram[addr + i] = Byte(r->dc_d[e], i);
+    }
+}
+
+//----------------------------------
+// Set Trace Output (NULL to stop)
+//----------------------------------
+void CYCLE_Set_Trace(sCYCLE *psCYC, FILE *fp)
+{
+    psCYC->fp_trace = fp;
+}
+
+//===========================================================
+// End of File
+//===========================================================
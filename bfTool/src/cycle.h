@@ -0,0 +1,122 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : cycle.h
+// Description : Cycle-Based System Model Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef __CYCLE_H__
+#define __CYCLE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------------------------------
+// Usage
+//     A model of RTL/TOP/top.sv (CPU, CACHE, QSPI_SRAM and
+//     UART with sasc) connected to the 23LC512 SRAM, which
+//     is evaluated once per clock cycle. The SRAM image is
+//     the whole 64KB chip, code in 0x0000-0x7fff and data
+//     in 0x8000-0xffff.
+//
+//     psCYC = CYCLE_Create(sram, CYCLE_MODE_HW);
+//     while (1)
+//     {
+//         event = CYCLE_Run(psCYC, 0);
+//         CYCLE_Get_State(psCYC, &state);
+//         if (event == CYCLE_EV_TXD) putchar(state.data);
+//         if (event == CYCLE_EV_RXD) CYCLE_Feed_RXD(psCYC, getchar());
+//     }
+//     CYCLE_Destroy(psCYC);
+//
+//     CYCLE_MODE_TB models SIM/tb_TOP (SIMULATION defined,
+//     UART bit width fixed) and prints the same trace line
+//     per cycle as tb.sv with TRACE_CYCLE, so both traces
+//     can be compared with diff.
+//-----------------------------------------------------------
+
+//-----------------------------------
+// Parameters
+//-----------------------------------
+#define CYCLE_SRAM_SIZE 65536 // 23LC512
+#define CYCLE_RAM_SIZE  32768 // CPU Data Memory
+#define CYCLE_RESET     10    // cycles in reset before cycle 0
+#define CYCLE_TB_FINISH 50000 // TB_FINISH_COUNT
+#define CYCLE_TB_BIT    32    // TB_UART_BITWIDTH / TB_CYCLE
+
+//-----------------------------------
+// Mode
+//-----------------------------------
+enum CYCLE_MODE
+{
+    CYCLE_MODE_HW, // FPGA build, DIV0/DIV1 at 0xfffe/0xffff
+    CYCLE_MODE_TB  // SIMULATION build as in SIM/tb_TOP
+};
+
+//-----------------------------------
+// Event (returned by Run)
+//-----------------------------------
+enum CYCLE_EVENT
+{
+    CYCLE_EV_LIMIT, // max_cycles executed
+    CYCLE_EV_TXD,   // a byte was received from UART_TXD, in state.data
+    CYCLE_EV_RXD,   // UART_RXD is read, call CYCLE_Feed_RXD() (TB: sent by itself)
+    CYCLE_EV_RESET  // RESET was decoded, the CPU restarts by itself
+};
+
+//-----------------------------------
+// Result Code
+//-----------------------------------
+#define CYCLE_OK        0
+#define CYCLE_ERR_STATE 1 // no byte is requested
+
+//-----------------------------------
+// System State
+//-----------------------------------
+typedef struct
+{
+    uint64_t cycle;     // cycles since reset release
+    uint32_t pc;        // PC register (next fetch)
+    uint32_t ptr;       // PTR register
+    unsigned char data; // UART byte of the last TXD/RXD event
+    uint64_t count;     // instructions decoded
+    uint64_t ic_hit;    // I-Cache hits
+    uint64_t ic_miss;   // I-Cache misses
+    uint64_t dc_hit;    // D-Cache hits
+    uint64_t dc_miss;   // D-Cache misses
+    uint64_t bus;       // bytes accessed on SRAM
+} sCYCLE_STATE;
+
+//-----------------------------------
+// System (opaque)
+//-----------------------------------
+typedef struct cycle sCYCLE;
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+sCYCLE *CYCLE_Create(const unsigned char *sram, int mode);
+void CYCLE_Destroy(sCYCLE *psCYC);
+int  CYCLE_Run(sCYCLE *psCYC, uint64_t max_cycles);
+int  CYCLE_Feed_RXD(sCYCLE *psCYC, unsigned char data);
+void CYCLE_Get_State(const sCYCLE *psCYC, sCYCLE_STATE *psSTATE);
+void CYCLE_Get_RAM(const sCYCLE *psCYC, unsigned char *ram);
+void CYCLE_Set_Trace(sCYCLE *psCYC, FILE *fp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+//===========================================================
+// End of File
+//===========================================================
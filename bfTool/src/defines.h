@@ -23,6 +23,28 @@
 // Architecture
 #define MAXROM_DEFAULT (32768*2) // width 4bitx2
 #define MAXRAM_DEFAULT (32768  ) // width 8bit
+//
+// UART of bfCPU System (for Time Estimate)
+#define CLKFREQ_DEFAULT   10000000 // Hz
+#define UART_BAUD_DEFAULT 115200   // bps
+//
+// Input Sweep
+#define SWEEP_IN_MAX    3            // IN bytes swept (256^3 inputs)
+#define SWEEP_LANES     256          // lanes run together
+#define SWEEP_MAX_STEPS (1ULL << 28) // steps per input
+//
+// Fuzzing
+#define FUZZ_BUDGET_DEFAULT (1ULL << 24) // steps per run
+#define FUZZ_JOBS_MAX       256          // worker processes
+//
+// Record and Replay
+#define RECORD_OVERHEAD_DEFAULT 5 // % of run time for snapshots
+//
+// Debugger
+#define DEBUG_BRK_MAX 64 // breakpoints
+//
+// Superinstructions
+#define SUPER_MIN_PERMILLE 10 // fused if saving 1.0% of ops at least in the profile
 
 //-----------------------------------------------------------------------
 // Miscellaneous
@@ -45,8 +67,9 @@ enum DEBUG_LVL {DEBUG_NONE, DEBUG_MIN, DEBUG_MID, DEBUG_MAX};
 
 //-----------------------------------------------------------------------
 // Command Line Option
-enum BF_FUNC   {FUNC_ASM, FUNC_SIM};
-enum BF_OPT    {OPT_ROM, OPT_RAM, OPT_OBJ, OPT_VER, OPT_LIS, OPT_LOG, OPT_VERBOSE, OPT_ASCII};
+enum BF_FUNC   {FUNC_ASM, FUNC_SIM, FUNC_CMP};
+enum BF_OPT    {OPT_ROM, OPT_RAM, OPT_OBJ, OPT_VER, OPT_LIS, OPT_BIN, OPT_PRE, OPT_LOG, OPT_VERBOSE, OPT_ASCII, OPT_DUMP, OPT_CLK, OPT_BAUD, OPT_CYCLE, OPT_IO, OPT_CMP, OPT_SWEEP, OPT_LANES, OPT_FUZZ, OPT_JOBS, OPT_RUNS, OPT_BUDGET, OPT_RECORD, OPT_REPLAY, OPT_DEBUG, OPT_PROFILE, OPT_SUPER};
+enum BF_CYCLE  {CYCLE_NONE, CYCLE_FPGA, CYCLE_TB};
 enum BF_OPTARG {OPT_NO, OPT_YES};
 typedef struct
 {
@@ -56,15 +79,52 @@ typedef struct
     int opt_obj;
     int opt_ver;
     int opt_lis;
+    int opt_bin;
+    int opt_pre;
     int opt_log;
     int opt_verbose;
     int opt_ascii;
+    int opt_dump;
+    int opt_clk;
+    int opt_baud;
+    int opt_cycle;
+    int opt_io;
+    int opt_cmp;
+    int opt_sweep;
+    int opt_lanes;
+    int opt_fuzz;
+    int opt_jobs;
+    int opt_runs;
+    int opt_budget;
+    int opt_record;
+    int opt_replay;
+    int opt_debug;
+    int opt_profile;
+    int opt_super;
     char *opt_rom_byte;
     char *opt_ram_byte;
     char *opt_obj_name;
     char *opt_ver_name;
     char *opt_lis_name;
+    char *opt_bin_name;
+    char *opt_pre_name;
     char *opt_log_name;
+    char *opt_dump_name;
+    char *opt_clk_freq;
+    char *opt_baud_rate;
+    char *opt_cycle_mode;
+    char *opt_io_name;
+    char *opt_cmp_name;
+    char *opt_sweep_in;
+    char *opt_lanes_num;
+    char *opt_fuzz_dir;
+    char *opt_jobs_num;
+    char *opt_runs_num;
+    char *opt_budget_num;
+    char *opt_record_pct;
+    char *opt_replay_name;
+    char *opt_profile_name;
+    char *opt_super_name;
     char *input_file_name;
 } sOPTION;
 
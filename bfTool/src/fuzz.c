@@ -0,0 +1,614 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : fuzz.c
+// Description : Coverage-Guided Fuzzing Harness
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <dirent.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/wait.h>
+#endif
+//
+#include "bfsim.h"
+#include "defines.h"
+#include "fuzz.h"
+#include "utility.h"
+
+//-------------------------
+// Global Variables
+//-------------------------
+extern char *FUZZ_DIR;
+extern uint32_t FUZZ_JOBS;
+extern uint64_t FUZZ_RUNS;
+extern uint64_t FUZZ_BUDGET;
+
+//----------------------------------
+// Parameters
+//----------------------------------
+#define FUZZ_STACK  8   // mutations at most on an input
+#define FUZZ_SPLICE 16  // 1/16 of inputs are spliced
+#define FUZZ_REPORT 1.0 // seconds between reports
+
+//----------------------------------
+// Result of a Run
+//----------------------------------
+enum FUZZ_KIND {FUZZ_NORMAL, FUZZ_SLOW, FUZZ_ILLEGAL, FUZZ_KINDS};
+static const char *kind_dir[FUZZ_KINDS] = {NULL, "slow", "illegal"};
+
+//----------------------------------
+// Input
+//----------------------------------
+typedef struct
+{
+    uint32_t len;
+    unsigned char data[FUZZ_MAX_IN];
+} sFUZZ_INPUT;
+
+//----------------------------------
+// Counters of a Worker
+//     Written by the worker only.
+//----------------------------------
+typedef struct
+{
+    uint64_t runs;
+    uint64_t kind[FUZZ_KINDS];
+    uint64_t max_steps; // longest normal run
+    uint64_t pad[2];    // one cache line per worker
+} sFUZZ_WORKER;
+
+//----------------------------------
+// Shared by all Workers
+//     Hit count classes seen per coverage
+//     point, for each kind of run.
+//----------------------------------
+typedef struct
+{
+    atomic_uchar  seen[FUZZ_KINDS][BFSIM_COVER_SIZE];
+    atomic_ullong steps_seen; // log2 of normal run steps
+    atomic_uint   next_id;    // file id
+    atomic_uint   count;      // inputs in corpus
+    atomic_uchar  ready[FUZZ_CORPUS];
+    sFUZZ_INPUT   corpus[FUZZ_CORPUS];
+    atomic_int    stop;
+    sFUZZ_WORKER  worker[FUZZ_JOBS_MAX];
+} sFUZZ_SHARED;
+//
+static sFUZZ_SHARED *psSHARED = NULL;
+
+//----------------------------------
+// Values often meaningful to Programs
+//----------------------------------
+static const unsigned char interesting[] =
+{
+    0x00, 0x01, 0x7f, 0x80, 0xff, '\n', '\r', ' ', '0', '1', '9', '-', 'A', 'z'
+};
+
+//--------------------------------
+// Interrupt Handler for CTRL-C
+//--------------------------------
+static void Fuzz_Interrupt(int dummy)
+{
+    (void)dummy;
+    if (psSHARED) atomic_store(&psSHARED->stop, 1);
+}
+
+//----------------------------------
+// Random Number (xorshift64)
+//----------------------------------
+static inline uint32_t Fuzz_Rand(uint64_t *seed)
+{
+    uint64_t x = *seed;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *seed = x;
+    return (uint32_t)(x >> 32);
+}
+
+//----------------------------------
+// Class of a Hit Count (one bit each)
+//----------------------------------
+static inline unsigned char Fuzz_Class(unsigned char hits)
+{
+    if (hits <=   3) return (hits == 3)? 4 : hits;
+    if (hits <=   7) return 8;
+    if (hits <=  15) return 16;
+    if (hits <=  31) return 32;
+    if (hits <= 127) return 64;
+    return 128;
+}
+
+//----------------------------------
+// Merge a Coverage Map
+//     Returns the number of new classes.
+//----------------------------------
+static uint32_t Fuzz_Merge(atomic_uchar *seen, const unsigned char *map)
+{
+    uint64_t word;
+    uint32_t i, j;
+    uint32_t num = 0;
+    unsigned char class;
+    //
+    for (i = 0; i < BFSIM_COVER_SIZE; i = i + 8)
+    {
+        memcpy(&word, map + i, 8);
+        if (word == 0) continue;
+        for (j = i; j < i + 8; j++)
+        {
+            if (map[j] == 0) continue;
+            class = Fuzz_Class(map[j]);
+            if (atomic_load_explicit(&seen[j], memory_order_relaxed) & class) continue;
+            if ((atomic_fetch_or_explicit(&seen[j], class, memory_order_relaxed) & class) == 0) num++;
+        }
+    }
+    return num;
+}
+
+//----------------------------------
+// Count Coverage Points seen
+//----------------------------------
+static uint32_t Fuzz_Points(int kind)
+{
+    uint32_t i;
+    uint32_t num = 0;
+    //
+    for (i = 0; i < BFSIM_COVER_SIZE; i++)
+    {
+        if (atomic_load_explicit(&psSHARED->seen[kind][i], memory_order_relaxed)) num++;
+    }
+    return num;
+}
+
+//----------------------------------
+// Run an Input
+//     *psteps is the instruction count.
+//----------------------------------
+static int Fuzz_Run(sBFSIM *psSIM, unsigned char *map, const sFUZZ_INPUT *psIN, uint64_t *psteps)
+{
+    sBFSIM_STATE state;
+    uint32_t pos = 0;
+    int  event;
+    //
+    BFSIM_Restart(psSIM);
+    memset(map, 0, BFSIM_COVER_SIZE);
+    while(1)
+    {
+        event = BFSIM_Run(psSIM, 0);
+        if (event == BFSIM_EV_OUT) continue;
+        if ((event == BFSIM_EV_IN) && (pos < psIN->len))
+        {
+            BFSIM_Feed_Input(psSIM, psIN->data[pos++]);
+            continue;
+        }
+        break;
+    }
+    BFSIM_Get_State(psSIM, &state);
+    *psteps = (event == BFSIM_EV_RESET)? state.count_reset : state.count;
+    if ((event == BFSIM_EV_LIMIT) || (event == BFSIM_EV_HANG)) return FUZZ_SLOW;
+    if (event == BFSIM_EV_ILLEGAL) return FUZZ_ILLEGAL;
+    return FUZZ_NORMAL;
+}
+
+//----------------------------------
+// Make a Directory if not exists
+//----------------------------------
+static void Fuzz_Mkdir(const char *path)
+{
+#if defined(_WIN32)
+    if ((mkdir(path) == 0) || (errno == EEXIST)) return;
+#else
+    if ((mkdir(path, 0777) == 0) || (errno == EEXIST)) return;
+#endif
+    fprintf(stderr, "======== ERROR: Can't make \"%s\".\n", path);
+    exit(EXIT_FAILURE);
+}
+
+//----------------------------------
+// Save an Input as a File
+//----------------------------------
+static void Fuzz_Save(const sFUZZ_INPUT *psIN, int kind, uint32_t id)
+{
+    char fname[MAXLEN_WORD];
+    FILE *fp;
+    //
+    if (kind_dir[kind])
+        snprintf(fname, MAXLEN_WORD, "%s/%s/id%06u", FUZZ_DIR, kind_dir[kind], id);
+    else
+        snprintf(fname, MAXLEN_WORD, "%s/id%06u", FUZZ_DIR, id);
+    fp = fopen(fname, "wb");
+    if (fp == NULL) return; // the fuzzer goes on
+    fwrite(psIN->data, 1, psIN->len, fp);
+    fclose(fp);
+}
+
+//----------------------------------
+// Add an Input to the Corpus
+//----------------------------------
+static void Fuzz_Add(const sFUZZ_INPUT *psIN)
+{
+    uint32_t index;
+    //
+    index = atomic_fetch_add(&psSHARED->count, 1);
+    if (index >= FUZZ_CORPUS) return; // kept as a file only
+    psSHARED->corpus[index] = *psIN;
+    atomic_store_explicit(&psSHARED->ready[index], 1, memory_order_release);
+}
+
+//----------------------------------
+// Judge a Run
+//     Returns the number of new coverage
+//     classes among runs of the same kind.
+//----------------------------------
+static uint32_t Fuzz_Judge(const unsigned char *map, int kind, uint64_t steps, sFUZZ_WORKER *psWORKER)
+{
+    uint64_t class;
+    uint32_t num;
+    //
+    psWORKER->kind[kind]++;
+    num = Fuzz_Merge(psSHARED->seen[kind], map);
+    if (kind == FUZZ_NORMAL)
+    {
+        // Longer Runs are new Coverage too
+        psWORKER->max_steps = (steps > psWORKER->max_steps)? steps : psWORKER->max_steps;
+        class = 1ULL << ((steps)? 63 - __builtin_clzll(steps) : 0);
+        if ((atomic_fetch_or(&psSHARED->steps_seen, class) & class) == 0) num++;
+    }
+    return num;
+}
+
+//----------------------------------
+// Mutate an Input
+//----------------------------------
+static void Fuzz_Mutate(sFUZZ_INPUT *psIN, const sFUZZ_INPUT *psOTHER, uint64_t *seed)
+{
+    uint32_t num, i;
+    uint32_t pos, from, len;
+    //
+    // Splice with another Input
+    if ((psOTHER) && (psOTHER->len))
+    {
+        pos  = (psIN->len)? Fuzz_Rand(seed) % psIN->len : 0;
+        from = Fuzz_Rand(seed) % psOTHER->len;
+        len  = psOTHER->len - from;
+        len  = (pos + len > FUZZ_MAX_IN)? FUZZ_MAX_IN - pos : len;
+        memcpy(psIN->data + pos, psOTHER->data + from, len);
+        psIN->len = pos + len;
+    }
+    //
+    // Stacked Mutations
+    num = 1 + Fuzz_Rand(seed) % FUZZ_STACK;
+    for (i = 0; i < num; i++)
+    {
+        int op = Fuzz_Rand(seed) % 8;
+        //
+        if (psIN->len == 0) op = 4; // insert only
+        pos = (psIN->len)? Fuzz_Rand(seed) % psIN->len : 0;
+        switch(op)
+        {
+            // Flip a Bit
+            case 0 : {psIN->data[pos] ^= (unsigned char)(1 << (Fuzz_Rand(seed) & 7)); break;}
+            // Random Byte
+            case 1 : {psIN->data[pos] = (unsigned char)Fuzz_Rand(seed); break;}
+            // Interesting Value
+            case 2 : {psIN->data[pos] = interesting[Fuzz_Rand(seed) % sizeof(interesting)]; break;}
+            // Add or Subtract
+            case 3 :
+            {
+                len = 1 + Fuzz_Rand(seed) % 16;
+                psIN->data[pos] = (unsigned char)((Fuzz_Rand(seed) & 1)? psIN->data[pos] + len : psIN->data[pos] - len);
+                break;
+            }
+            // Insert a Byte
+            case 4 :
+            {
+                if (psIN->len == FUZZ_MAX_IN) break;
+                pos = Fuzz_Rand(seed) % (psIN->len + 1);
+                memmove(psIN->data + pos + 1, psIN->data + pos, psIN->len - pos);
+                psIN->data[pos] = (Fuzz_Rand(seed) & 1)? (unsigned char)Fuzz_Rand(seed)
+                                : interesting[Fuzz_Rand(seed) % sizeof(interesting)];
+                psIN->len++;
+                break;
+            }
+            // Delete a Byte
+            case 5 :
+            {
+                memmove(psIN->data + pos, psIN->data + pos + 1, psIN->len - pos - 1);
+                psIN->len--;
+                break;
+            }
+            // Copy a Block over
+            case 6 :
+            {
+                from = Fuzz_Rand(seed) % psIN->len;
+                len  = 1 + Fuzz_Rand(seed) % (psIN->len - ((from > pos)? from : pos));
+                memmove(psIN->data + pos, psIN->data + from, len);
+                break;
+            }
+            // Duplicate a Block (repeats a line or a number)
+            default :
+            {
+                len = 1 + Fuzz_Rand(seed) % (psIN->len - pos);
+                len = (psIN->len + len > FUZZ_MAX_IN)? FUZZ_MAX_IN - psIN->len : len;
+                memmove(psIN->data + pos + len, psIN->data + pos, psIN->len - pos);
+                psIN->len = psIN->len + len;
+                break;
+            }
+        }
+    }
+}
+
+//----------------------------------
+// Pick an Input from the Corpus
+//----------------------------------
+static const sFUZZ_INPUT *Fuzz_Pick(uint64_t *seed)
+{
+    uint32_t num, index;
+    //
+    num = atomic_load(&psSHARED->count);
+    num = (num < FUZZ_CORPUS)? num : FUZZ_CORPUS;
+    index = Fuzz_Rand(seed) % num;
+    if (atomic_load_explicit(&psSHARED->ready[index], memory_order_acquire) == 0) index = 0;
+    return &psSHARED->corpus[index];
+}
+
+//----------------------------------
+// Create a Machine for Fuzzing
+//----------------------------------
+static sBFSIM *Fuzz_Create(unsigned char *rom, const sBFSIM_CONFIG *psCONFIG, unsigned char **pmap)
+{
+    sBFSIM *psSIM;
+    //
+    psSIM = BFSIM_Create(rom, psCONFIG);
+    *pmap = (unsigned char*)malloc(BFSIM_COVER_SIZE);
+    if ((psSIM == NULL) || (*pmap == NULL))
+    {
+        fprintf(stderr, "======== ERROR: Can't allocate RAM area.\n");
+        exit(EXIT_FAILURE);
+    }
+    BFSIM_Set_Cover(psSIM, *pmap);
+    BFSIM_Set_Limit(psSIM, FUZZ_BUDGET);
+    return psSIM;
+}
+
+//----------------------------------
+// Worker
+//     runs : 0 until stopped
+//----------------------------------
+static void Fuzz_Worker(uint32_t id, unsigned char *rom, const sBFSIM_CONFIG *psCONFIG, uint64_t runs)
+{
+    sFUZZ_WORKER *psWORKER = &psSHARED->worker[id];
+    sFUZZ_INPUT input;
+    sBFSIM *psSIM;
+    unsigned char *map;
+    uint64_t seed = 0x9e3779b97f4a7c15ULL * (id + 1);
+    uint64_t steps;
+    uint64_t i;
+    int  kind;
+    //
+    psSIM = Fuzz_Create(rom, psCONFIG, &map);
+    for (i = 0; (runs == 0) || (i < runs); i++)
+    {
+        if (atomic_load_explicit(&psSHARED->stop, memory_order_relaxed)) break;
+        input = *Fuzz_Pick(&seed);
+        Fuzz_Mutate(&input, ((Fuzz_Rand(&seed) % FUZZ_SPLICE) == 0)? Fuzz_Pick(&seed) : NULL, &seed);
+        kind = Fuzz_Run(psSIM, map, &input, &steps);
+        if (Fuzz_Judge(map, kind, steps, psWORKER))
+        {
+            // Slow and Illegal ones are not mutated further
+            if (kind == FUZZ_NORMAL) Fuzz_Add(&input);
+            Fuzz_Save(&input, kind, atomic_fetch_add(&psSHARED->next_id, 1));
+        }
+        psWORKER->runs++;
+    }
+    BFSIM_Destroy(psSIM);
+    free(map);
+}
+
+//----------------------------------
+// Highest File ID in a Directory
+//----------------------------------
+static uint32_t Fuzz_Max_Id(const char *path)
+{
+    DIR *dir;
+    struct dirent *entry;
+    unsigned int id;
+    uint32_t max = 0;
+    //
+    dir = opendir(path);
+    if (dir == NULL) return 0;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if ((sscanf(entry->d_name, "id%u", &id) == 1) && (id + 1 > max)) max = id + 1;
+    }
+    closedir(dir);
+    return max;
+}
+
+//----------------------------------
+// Load Seeds from the Corpus Directory
+//     Runs them to know their coverage.
+//----------------------------------
+static void Fuzz_Load(unsigned char *rom, const sBFSIM_CONFIG *psCONFIG)
+{
+    char fname[MAXLEN_WORD];
+    DIR *dir;
+    struct dirent *entry;
+    struct stat st;
+    FILE *fp;
+    sFUZZ_INPUT input;
+    sFUZZ_WORKER dummy = {0};
+    sBFSIM *psSIM;
+    unsigned char *map;
+    uint64_t steps;
+    uint32_t num = 0;
+    int  kind;
+    //
+    psSIM = Fuzz_Create(rom, psCONFIG, &map);
+    dir = opendir(FUZZ_DIR);
+    while ((dir) && ((entry = readdir(dir)) != NULL))
+    {
+        snprintf(fname, MAXLEN_WORD, "%s/%s", FUZZ_DIR, entry->d_name);
+        if ((stat(fname, &st) != 0) || (!S_ISREG(st.st_mode))) continue;
+        fp = fopen(fname, "rb");
+        if (fp == NULL) continue;
+        input.len = (uint32_t)fread(input.data, 1, FUZZ_MAX_IN, fp);
+        fclose(fp);
+        //
+        kind = Fuzz_Run(psSIM, map, &input, &steps);
+        Fuzz_Judge(map, kind, steps, &dummy);
+        if (kind == FUZZ_NORMAL) Fuzz_Add(&input); // seeds are kept anyway
+        num++;
+    }
+    if (dir) closedir(dir);
+    //
+    // Default Seed
+    if (atomic_load(&psSHARED->count) == 0)
+    {
+        input.len = 2;
+        input.data[0] = '0';
+        input.data[1] = '\n';
+        kind = Fuzz_Run(psSIM, map, &input, &steps);
+        Fuzz_Judge(map, kind, steps, &dummy);
+        Fuzz_Add(&input);
+        if (num == 0) Fuzz_Save(&input, FUZZ_NORMAL, atomic_fetch_add(&psSHARED->next_id, 1));
+    }
+    printf("Fuzz: %u seeds in \"%s\", corpus %u\n", num, FUZZ_DIR, atomic_load(&psSHARED->count));
+    BFSIM_Destroy(psSIM);
+    free(map);
+}
+
+//----------------------------------
+// Report Progress
+//----------------------------------
+static void Fuzz_Report(uint32_t jobs, double start, const char *end)
+{
+    uint64_t runs = 0, slow = 0, illegal = 0, max_steps = 0;
+    uint32_t count, i;
+    double   time = Get_Time() - start;
+    //
+    for (i = 0; i < jobs; i++)
+    {
+        runs    = runs    + psSHARED->worker[i].runs;
+        slow    = slow    + psSHARED->worker[i].kind[FUZZ_SLOW];
+        illegal = illegal + psSHARED->worker[i].kind[FUZZ_ILLEGAL];
+        max_steps = (psSHARED->worker[i].max_steps > max_steps)? psSHARED->worker[i].max_steps : max_steps;
+    }
+    count = atomic_load(&psSHARED->count);
+    printf("\rFuzz: %" PRIu64 " runs (%.0f/s), corpus %u, points %u, slow %" PRIu64 ", illegal %" PRIu64 ", max steps %" PRIu64 "%s",
+        runs, (time > 0.0)? runs / time : 0.0, count, Fuzz_Points(FUZZ_NORMAL), slow, illegal, max_steps, end);
+    fflush(stdout);
+}
+
+//----------------------------------
+// Do Fuzzing
+//     Workers are processes sharing the
+//     coverage and the corpus in memory.
+//----------------------------------
+void Do_Fuzz(unsigned char *rom, const sBFSIM_CONFIG *psCONFIG)
+{
+    char path[MAXLEN_WORD + 16];
+    uint32_t jobs = FUZZ_JOBS;
+    uint32_t i, id;
+    double   start, last;
+    int  kind;
+    //
+    // Shared Area
+#if !defined(_WIN32)
+    psSHARED = (sFUZZ_SHARED*)mmap(NULL, sizeof(sFUZZ_SHARED), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (psSHARED == MAP_FAILED) psSHARED = NULL;
+    if (jobs == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        jobs = (cpus < 1)? 1 : (cpus > FUZZ_JOBS_MAX)? FUZZ_JOBS_MAX : (uint32_t)cpus;
+    }
+#else
+    psSHARED = (sFUZZ_SHARED*)calloc(1, sizeof(sFUZZ_SHARED));
+    jobs = 1;
+#endif
+    if (psSHARED == NULL)
+    {
+        fprintf(stderr, "======== ERROR: Can't allocate Fuzz area.\n");
+        exit(EXIT_FAILURE);
+    }
+    //
+    // Corpus Directory
+    Fuzz_Mkdir(FUZZ_DIR);
+    id = Fuzz_Max_Id(FUZZ_DIR);
+    for (kind = FUZZ_SLOW; kind < FUZZ_KINDS; kind++)
+    {
+        snprintf(path, sizeof(path), "%s/%s", FUZZ_DIR, kind_dir[kind]);
+        Fuzz_Mkdir(path);
+        id = (Fuzz_Max_Id(path) > id)? Fuzz_Max_Id(path) : id;
+    }
+    atomic_store(&psSHARED->next_id, id);
+    Fuzz_Load(rom, psCONFIG);
+    signal(SIGINT, Fuzz_Interrupt);
+    //
+    // Run Workers
+    start = Get_Time();
+#if !defined(_WIN32)
+    {
+        pid_t pid;
+        uint32_t alive = 0;
+        //
+        fflush(stdout);
+        for (i = 0; i < jobs; i++)
+        {
+            pid = fork();
+            if (pid == 0)
+            {
+                Fuzz_Worker(i, rom, psCONFIG, (FUZZ_RUNS)? FUZZ_RUNS / jobs + (i < FUZZ_RUNS % jobs) : 0);
+                _exit(EXIT_SUCCESS);
+            }
+            if (pid > 0) alive++;
+        }
+        if (alive == 0) Fuzz_Worker(0, rom, psCONFIG, FUZZ_RUNS);
+        last = start;
+        while (alive)
+        {
+            usleep(100000);
+            while (waitpid(-1, NULL, WNOHANG) > 0) alive--;
+            if ((isatty(STDOUT_FILENO)) && (Get_Time() - last >= FUZZ_REPORT))
+            {
+                Fuzz_Report(jobs, start, "   ");
+                last = Get_Time();
+            }
+        }
+    }
+#else
+    (void)last;
+    Fuzz_Worker(0, rom, psCONFIG, FUZZ_RUNS);
+#endif
+    //
+    // Summary
+    Fuzz_Report(jobs, start, "\n");
+    printf("      %u worker%s, %.3fs, inputs in \"%s\"\n", jobs, (jobs > 1)? "s" : "", Get_Time() - start, FUZZ_DIR);
+#if !defined(_WIN32)
+    munmap(psSHARED, sizeof(sFUZZ_SHARED));
+#else
+    free(psSHARED);
+#endif
+    psSHARED = NULL;
+}
+
+//===========================================================
+// End of Program
+//===========================================================
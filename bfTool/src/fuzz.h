@@ -0,0 +1,45 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : fuzz.h
+// Description : Coverage-Guided Fuzzing Harness Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+#include "bfsim.h"
+
+#ifndef __FUZZ_H__
+#define __FUZZ_H__
+
+//-----------------------------------------------------------
+// Corpus Directory (bfTool -s --fuzz=DIR)
+//     DIR/id000012          input kept for new coverage
+//     DIR/slow/id000034     input which ran out of budget
+//     DIR/illegal/id000056  input which hit an illegal code
+//
+// Each file is the byte stream given to IN. A run ends at
+// RESET, at an IN beyond the stream, at an illegal code or
+// at the budget. Files put in DIR are used as seeds.
+//-----------------------------------------------------------
+
+//-----------------------------------
+// Parameters
+//-----------------------------------
+#define FUZZ_MAX_IN 256  // bytes of an input
+#define FUZZ_CORPUS 8192 // inputs mutated from
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+void Do_Fuzz(unsigned char *rom, const sBFSIM_CONFIG *psCONFIG);
+
+#endif
+
+//===========================================================
+// End of Program
+//===========================================================
@@ -0,0 +1,295 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : iocmp.c
+// Description : I/O Event Trace Comparator
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+//
+#include "defines.h"
+#include "iocmp.h"
+
+//----------------------------------
+// Parameters
+//----------------------------------
+#define IOCMP_CONTEXT 4 // events shown before a mismatch
+
+static const char *dir_name[IOCMP_DIRS] = {"OUT", "IN "};
+
+//----------------------------------
+// Write an I/O Event
+//----------------------------------
+void IOCMP_Write(FILE *fp, int dir, unsigned char data, uint64_t cycle)
+{
+    if (fp == NULL) return;
+    if (cycle == IOCMP_NO_CYCLE)
+        fprintf(fp, "%s 0x%02x\n", dir_name[dir], data);
+    else
+        fprintf(fp, "%s 0x%02x @%" PRIu64 "\n", dir_name[dir], data, cycle);
+}
+
+//----------------------------------
+// Write the End of Run
+//----------------------------------
+void IOCMP_Write_End(FILE *fp, uint64_t cycles)
+{
+    if (fp == NULL) return;
+    fprintf(fp, "END @%" PRIu64 "\n", cycles);
+}
+
+//----------------------------------
+// Append an Event
+//----------------------------------
+static void IOCMP_Append(sIOTRACE *psTRACE, int dir, unsigned int data, uint32_t line, uint64_t cycle)
+{
+    sIOEVENT *event;
+    uint32_t size;
+    //
+    if (psTRACE->count == psTRACE->size)
+    {
+        size = (psTRACE->size)? psTRACE->size * 2 : 256;
+        event = (sIOEVENT*)realloc(psTRACE->event, sizeof(sIOEVENT) * size);
+        if (event == NULL)
+        {
+            fprintf(stderr, "======== ERROR: Can't allocate Event area.\n");
+            exit(EXIT_FAILURE);
+        }
+        psTRACE->event = event;
+        psTRACE->size  = size;
+    }
+    event = &psTRACE->event[psTRACE->count++];
+    event->dir   = dir;
+    event->data  = (unsigned char)data;
+    event->line  = line;
+    event->cycle = cycle;
+}
+
+//----------------------------------
+// Read I/O Events from a File
+//     Accepts an I/O Event File, a tb_TOP
+//     log and a bfTool log (see iocmp.h).
+//----------------------------------
+int IOCMP_Read(sIOTRACE *psTRACE, char *fname)
+{
+    FILE *fp;
+    char line[MAXLEN_LINE];
+    char *p;
+    unsigned int data;
+    uint64_t cycle;
+    uint64_t cyc_now = IOCMP_NO_CYCLE; // by CYC lines
+    uint32_t num = 0;
+    int  n;
+    //
+    psTRACE->fname  = fname;
+    psTRACE->event  = NULL;
+    psTRACE->count  = 0;
+    psTRACE->size   = 0;
+    psTRACE->cycles = IOCMP_NO_CYCLE;
+    //
+    fp = fopen(fname, "r");
+    if (fp == NULL) return RESULT_CANNOTFIND;
+    //
+    while (fgets(line, MAXLEN_LINE, fp))
+    {
+        num++;
+        cycle = IOCMP_NO_CYCLE;
+        // tb_TOP
+        if (sscanf(line, "===== UART TxD ===== (OUT) at 0x%x", &data) == 1)
+            IOCMP_Append(psTRACE, IOCMP_OUT, data, num, cyc_now);
+        else if (sscanf(line, "===== UART RxD ===== (IN ) at 0x%x", &data) == 1)
+            IOCMP_Append(psTRACE, IOCMP_IN, data, num, cyc_now);
+        else if (sscanf(line, "***** SIMULATION TIMEOUT ***** at %" SCNu64, &cycle) == 1)
+            psTRACE->cycles = cycle;
+        else if (sscanf(line, "CYC %" SCNu64, &cycle) == 1)
+            cyc_now = cycle;
+        // I/O Event File
+        else if ((n = sscanf(line, "OUT 0x%x @%" SCNu64, &data, &cycle)) >= 1)
+            IOCMP_Append(psTRACE, IOCMP_OUT, data, num, (n == 2)? cycle : cyc_now);
+        else if ((n = sscanf(line, "IN 0x%x @%" SCNu64, &data, &cycle)) >= 1)
+            IOCMP_Append(psTRACE, IOCMP_IN, data, num, (n == 2)? cycle : cyc_now);
+        else if (sscanf(line, "END @%" SCNu64, &cycle) == 1)
+            psTRACE->cycles = cycle;
+        // bfTool log
+        else
+        {
+            if (sscanf(line, "CYCLE=%" SCNu64, &cycle) != 1) cycle = cyc_now;
+            if ((p = strstr(line, "OUTPUT=0x")) && (sscanf(p, "OUTPUT=0x%x", &data) == 1))
+                IOCMP_Append(psTRACE, IOCMP_OUT, data, num, cycle);
+            else if ((p = strstr(line, "INPUT=0x")) && (sscanf(p, "INPUT=0x%x", &data) == 1))
+                IOCMP_Append(psTRACE, IOCMP_IN, data, num, cycle);
+        }
+    }
+    fclose(fp);
+    //
+    // Run Length by the Trace if not Reported
+    if ((psTRACE->cycles == IOCMP_NO_CYCLE) && (cyc_now != IOCMP_NO_CYCLE)) psTRACE->cycles = cyc_now + 1;
+    return RESULT_OK;
+}
+
+//----------------------------------
+// Free I/O Events
+//----------------------------------
+void IOCMP_Free(sIOTRACE *psTRACE)
+{
+    if (psTRACE->event) free(psTRACE->event);
+    psTRACE->event = NULL;
+    psTRACE->count = 0;
+    psTRACE->size  = 0;
+}
+
+//----------------------------------
+// Index Events of a Direction
+//----------------------------------
+static uint32_t IOCMP_Index(sIOTRACE *psTRACE, int dir, uint32_t *index)
+{
+    uint32_t i, n = 0;
+    //
+    for (i = 0; i < psTRACE->count; i++)
+    {
+        if (psTRACE->event[i].dir == dir) index[n++] = i;
+    }
+    return n;
+}
+
+//----------------------------------
+// Print an Event for Context
+//----------------------------------
+static void IOCMP_Print_Event(sIOTRACE *psTRACE, uint32_t *index, uint32_t n, uint32_t k)
+{
+    sIOEVENT *event;
+    //
+    if (k >= n)
+    {
+        printf("    %-33s", "(none)");
+        return;
+    }
+    event = &psTRACE->event[index[k]];
+    if (event->cycle == IOCMP_NO_CYCLE)
+        printf("    #%-5u 0x%02x line %-6u %9s", k + 1, event->data, event->line, "");
+    else
+        printf("    #%-5u 0x%02x line %-6u @%-8" PRIu64, k + 1, event->data, event->line, event->cycle);
+}
+
+//----------------------------------
+// Print Cycle per Event of a Run
+//----------------------------------
+static void IOCMP_Print_Rate(sIOTRACE *psTRACE, uint32_t out, uint32_t in)
+{
+    if ((psTRACE->cycles == IOCMP_NO_CYCLE) || (psTRACE->count == 0)) return;
+    printf("\"%s\" : %" PRIu64 " cycles, %u events (OUT %u, IN %u), %.1f cycles/event\n",
+        psTRACE->fname, psTRACE->cycles, psTRACE->count, out, in,
+        (double)psTRACE->cycles / psTRACE->count);
+}
+
+//----------------------------------
+// Compare I/O Events
+//     OUT and IN are aligned separately, as a
+//     UART log shows a byte when its frame ends
+//     while a model shows it when executed.
+//     A run stopped earlier (e.g. by timeout)
+//     is not a mismatch. Returns RESULT_NO at
+//     the first mismatch.
+//----------------------------------
+int IOCMP_Compare(sIOTRACE *psREF, sIOTRACE *psLOG)
+{
+    uint32_t *index_ref, *index_log;
+    uint32_t num_ref[IOCMP_DIRS], num_log[IOCMP_DIRS];
+    uint32_t i, k, n;
+    int  dir;
+    int  result = RESULT_OK;
+    //
+    index_ref = (uint32_t*)malloc(sizeof(uint32_t) * (psREF->count + 1));
+    index_log = (uint32_t*)malloc(sizeof(uint32_t) * (psLOG->count + 1));
+    if ((index_ref == NULL) || (index_log == NULL))
+    {
+        fprintf(stderr, "======== ERROR: Can't allocate Event area.\n");
+        exit(EXIT_FAILURE);
+    }
+    //
+    for (dir = 0; dir < IOCMP_DIRS; dir++)
+    {
+        num_ref[dir] = IOCMP_Index(psREF, dir, index_ref);
+        num_log[dir] = IOCMP_Index(psLOG, dir, index_log);
+        n = (num_ref[dir] < num_log[dir])? num_ref[dir] : num_log[dir];
+        for (i = 0; i < n; i++)
+        {
+            if (psREF->event[index_ref[i]].data != psLOG->event[index_log[i]].data) break;
+        }
+        if (i == n)
+        {
+            printf("%s : %u events match", dir_name[dir], n);
+            if (num_ref[dir] != num_log[dir])
+                printf(" (\"%s\" has %u, \"%s\" has %u)", psREF->fname, num_ref[dir], psLOG->fname, num_log[dir]);
+            printf("\n");
+            continue;
+        }
+        //
+        // Mismatch with Context
+        printf("======== MISMATCH: %s #%u\n", dir_name[dir], i + 1);
+        printf("    %-33s    %-33s\n", psREF->fname, psLOG->fname);
+        for (k = (i > IOCMP_CONTEXT)? i - IOCMP_CONTEXT : 0; k <= i + 1; k++)
+        {
+            if ((k >= num_ref[dir]) && (k >= num_log[dir])) break;
+            IOCMP_Print_Event(psREF, index_ref, num_ref[dir], k);
+            IOCMP_Print_Event(psLOG, index_log, num_log[dir], k);
+            printf("%s\n", (k == i)? " <<<<" : "");
+        }
+        result = RESULT_NO;
+        break;
+    }
+    //
+    // Cycle per Event
+    if (result == RESULT_OK)
+    {
+        IOCMP_Print_Rate(psREF, num_ref[IOCMP_OUT], num_ref[IOCMP_IN]);
+        IOCMP_Print_Rate(psLOG, num_log[IOCMP_OUT], num_log[IOCMP_IN]);
+    }
+    free(index_ref);
+    free(index_log);
+    return result;
+}
+
+//----------------------------------
+// Do Comparison
+//     InputFile against RefFile
+//----------------------------------
+void Do_Cmp(sOPTION *psOPTION)
+{
+    sIOTRACE ref, log;
+    int  result;
+    //
+    if (IOCMP_Read(&ref, psOPTION->opt_cmp_name) != RESULT_OK)
+    {
+        fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", psOPTION->opt_cmp_name);
+        exit(EXIT_FAILURE);
+    }
+    if (IOCMP_Read(&log, psOPTION->input_file_name) != RESULT_OK)
+    {
+        fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", psOPTION->input_file_name);
+        exit(EXIT_FAILURE);
+    }
+    if ((ref.count == 0) || (log.count == 0))
+    {
+        fprintf(stderr, "======== ERROR: No I/O Event in \"%s\".\n", (ref.count)? log.fname : ref.fname);
+        exit(EXIT_FAILURE);
+    }
+    //
+    result = IOCMP_Compare(&ref, &log);
+    IOCMP_Free(&ref);
+    IOCMP_Free(&log);
+    if (result != RESULT_OK) exit(EXIT_FAILURE);
+}
+
+//===========================================================
+// End of Program
+//===========================================================
@@ -0,0 +1,75 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : iocmp.h
+// Description : I/O Event Trace Comparator Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include "defines.h"
+
+#ifndef __IOCMP_H__
+#define __IOCMP_H__
+
+//-----------------------------------------------------------
+// I/O Event File (bfTool --io)
+//     OUT 0x06 @1234    byte sent by out (cycle if known)
+//     IN  0x02 @1002    byte taken by in
+//     END @50000        cycles of the whole run
+//
+// Lines read as I/O Events
+//     ===== UART TxD ===== (OUT) at 0x06  tb_TOP log
+//     ===== UART RxD ===== (IN ) at 0x02  tb_TOP log
+//     ***** SIMULATION TIMEOUT ***** at 50000
+//     CYC 1234 ...                         cycle of events below
+//     ... OUTPUT=0x06 ... / ... INPUT=0x02 bfTool log
+//     CYCLE=1234 OUTPUT=0x06 ...           bfTool --cycle log
+//-----------------------------------------------------------
+
+//-----------------------------------
+// Event
+//-----------------------------------
+enum IOCMP_DIR {IOCMP_OUT, IOCMP_IN, IOCMP_DIRS};
+#define IOCMP_NO_CYCLE UINT64_MAX
+
+typedef struct
+{
+    int      dir;   // IOCMP_OUT or IOCMP_IN
+    unsigned char data;
+    uint32_t line;  // line number in the file
+    uint64_t cycle; // IOCMP_NO_CYCLE if unknown
+} sIOEVENT;
+
+//-----------------------------------
+// Event Stream of a File
+//-----------------------------------
+typedef struct
+{
+    char     *fname;
+    sIOEVENT *event;
+    uint32_t count;
+    uint32_t size;   // allocated entries
+    uint64_t cycles; // IOCMP_NO_CYCLE if unknown
+} sIOTRACE;
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+void IOCMP_Write(FILE *fp, int dir, unsigned char data, uint64_t cycle);
+void IOCMP_Write_End(FILE *fp, uint64_t cycles);
+int  IOCMP_Read(sIOTRACE *psTRACE, char *fname);
+void IOCMP_Free(sIOTRACE *psTRACE);
+int  IOCMP_Compare(sIOTRACE *psREF, sIOTRACE *psLOG);
+void Do_Cmp(sOPTION *psOPTION);
+
+#endif
+
+//===========================================================
+// End of Program
+//===========================================================
@@ -24,17 +24,34 @@
 #include <sys/types.h>
 
 #include "asm.h"
+#include "baud.h"
 #include "defines.h"
+#include "iocmp.h"
 #include "sim.h"
 
 //=====================
 // Architecture
 //=====================
-int MAXROM = MAXROM_DEFAULT;
-int MAXRAM = MAXRAM_DEFAULT;
+uint32_t MAXROM = MAXROM_DEFAULT;
+uint32_t MAXRAM = MAXRAM_DEFAULT;
 int VERBOSE = 0;
 int ASCII = 0;
 int SIM_LOG = 0;
+int UART_EST = 0;
+sBAUD UART_DIV; // UART Divider Setting for the Estimate
+int CYCLE_SIM = CYCLE_NONE;
+int CLK_FREQ = CLKFREQ_DEFAULT;
+int SWEEP_IN = 0;
+uint32_t SWEEP_WIDTH = SWEEP_LANES;
+char *FUZZ_DIR = NULL;
+uint32_t FUZZ_JOBS = 0; // number of CPUs
+uint64_t FUZZ_RUNS = 0; // until Ctrl-C
+uint64_t FUZZ_BUDGET = FUZZ_BUDGET_DEFAULT;
+uint32_t RECORD = 0; // overhead in % (0: not recorded)
+char *REPLAY_FILE = NULL;
+int DEBUGGER = 0;
+char *PROFILE_FILE = NULL;
+char *SUPER_FILE = NULL;
 
 //=====================
 // Globals
@@ -97,10 +114,12 @@ void Print_Usage(void)
     printf("$ bfTool [options] InputFile                               \n");
     printf("    --asm, -a : Assembler (Default)                        \n");
     printf("    --sim, -s : Simulator                                  \n");
+    printf("    --cmp, -m : I/O Compare against a Reference File       \n");
     printf("-----------------------------------------------------------\n");
     printf("Architecture :                                             \n");
     printf("    --rom, -i : ROM Size in bytes (Default %3dbytes)       \n", MAXROM_DEFAULT);
     printf("    --ram, -d : RAM Size in bytes (Default %3dbytes)       \n", MAXRAM_DEFAULT);
+    printf("                Max 4294967295, RAM is mapped on demand    \n");
     printf("-----------------------------------------------------------\n");
     printf("Assembler :                                                \n");
     printf("    InputFile is a Source List : InputFile.asm             \n");
@@ -108,15 +127,39 @@ void Print_Usage(void)
     printf("        InputFile.hex : Object File in Hex Format          \n");
     printf("        InputFile.v   : Object File in Verilog Format      \n");
     printf("        InputFile.lis : Assemble List File                 \n");
+    printf("        InputFile.bin : Object File in Packed Binary       \n");
     printf("    You can specify each file name by following options    \n");
     printf("    --obj, -o : Object Hex File Name (Intel Hex)           \n");
     printf("    --ver, -v : Object Hex File Name (Verilog  )           \n");
     printf("    --lis, -l : Assemble List                              \n");
+    printf("    --bin, -n : Object Binary File Name (Packed Binary)    \n");
+    printf("    --preload, -p : Raw Data File to be preloaded in RAM   \n");
     printf("-----------------------------------------------------------\n");
-    printf("Simulator : InputFile is a Object Hex File.                \n");
+    printf("Simulator : InputFile is a Object Hex or Binary File.      \n");
     printf("    --log,     -g : Log File Name (Default: InputFile.sim) \n");
     printf("    --verbose, -b : Print Log Messages on STDOUT           \n");
     printf("    --ascii,   -t : I/O is in ASCII Characters             \n");
+    printf("    --dump,    -u : Dump RAM to a File after the Run       \n");
+    printf("    --clk,     -c : Clock in Hz for UART Time (10MHz)      \n");
+    printf("    --baud,    -r : Baud Rate for UART Time (115200)       \n");
+    printf("    --cycle,   -y : Cycle Model of RTL (=sim as tb_TOP)    \n");
+    printf("    --io,      -e : I/O Event File Name (OUT/IN per line)  \n");
+    printf("    --sweep,   -w : Run all values of first N Inputs (1-3) \n");
+    printf("    --lanes,   -k : Lanes run together in Sweep (256)      \n");
+    printf("    --fuzz,    -z : Fuzz Inputs, Corpus in the Directory   \n");
+    printf("    --jobs,    -j : Fuzz Workers (Default: CPUs)           \n");
+    printf("    --runs,    -x : Fuzz Runs in total (Default: Ctrl-C)   \n");
+    printf("    --budget,  -f : Steps per Fuzz Run (Default 16777216)  \n");
+    printf("    --record,  -q : Record for Going Back after Ctrl-C     \n");
+    printf("                    (=PCT : Overhead in %%, Default 5)      \n");
+    printf("    --replay,  -h : Inputs from an I/O Event File first    \n");
+    printf("    --debug,   -D : Debugger Prompt at Start and Ctrl-C    \n");
+    printf("    --profile, -P : Profile Ops of the Run into the File   \n");
+    printf("    --super,   -S : Superinstructions from a Profile File  \n");
+    printf("-----------------------------------------------------------\n");
+    printf("I/O Compare : InputFile is a tb_TOP log, a bfTool log or   \n");
+    printf("    an I/O Event File, and is compared with the Reference  \n");
+    printf("    File given by --cmp. OUT and IN are aligned separately.\n");
     printf("-----------------------------------------------------------\n");
 }
 
@@ -130,7 +173,9 @@ uint32_t Parse_Command_Line(int argc, char **argv, sOPTION *psOPTION)
     int error = 0;
     //
     char *endptr;
-    long long_num;
+    unsigned long long long_num;
+    int clk_freq;
+    int baud_rate;
     //
     // Define Long Option
     static struct option long_option[] =
@@ -142,9 +187,28 @@ uint32_t Parse_Command_Line(int argc, char **argv, sOPTION *psOPTION)
         {"obj", required_argument, NULL, 'o'},
         {"ver", required_argument, NULL, 'v'},
         {"lis", required_argument, NULL, 'l'},
+        {"bin", required_argument, NULL, 'n'},
+        {"preload", required_argument, NULL, 'p'},
         {"log", optional_argument, NULL, 'g'},
         {"verbose", no_argument  , NULL, 'b'},
         {"ascii"  , no_argument  , NULL, 't'},
+        {"dump"   , required_argument, NULL, 'u'},
+        {"clk"    , required_argument, NULL, 'c'},
+        {"baud"   , required_argument, NULL, 'r'},
+        {"cycle"  , optional_argument, NULL, 'y'},
+        {"io"     , required_argument, NULL, 'e'},
+        {"cmp"    , required_argument, NULL, 'm'},
+        {"sweep"  , required_argument, NULL, 'w'},
+        {"lanes"  , required_argument, NULL, 'k'},
+        {"fuzz"   , required_argument, NULL, 'z'},
+        {"jobs"   , required_argument, NULL, 'j'},
+        {"runs"   , required_argument, NULL, 'x'},
+        {"budget" , required_argument, NULL, 'f'},
+        {"record" , optional_argument, NULL, 'q'},
+        {"replay" , required_argument, NULL, 'h'},
+        {"debug"  , no_argument      , NULL, 'D'},
+        {"profile", required_argument, NULL, 'P'},
+        {"super"  , required_argument, NULL, 'S'},
         {NULL , no_argument      , NULL, 0  }
     };
     //
@@ -155,19 +219,56 @@ uint32_t Parse_Command_Line(int argc, char **argv, sOPTION *psOPTION)
     psOPTION->opt_obj = OPT_NO;
     psOPTION->opt_ver = OPT_NO; // Work around for Core Dump in Hands-on-Seminar on 2026.03.05.
     psOPTION->opt_lis = OPT_NO;
+    psOPTION->opt_bin = OPT_NO;
+    psOPTION->opt_pre = OPT_NO;
     psOPTION->opt_log = OPT_NO;
     psOPTION->opt_verbose = OPT_NO;
     psOPTION->opt_ascii   = OPT_NO;
+    psOPTION->opt_dump    = OPT_NO;
+    psOPTION->opt_clk     = OPT_NO;
+    psOPTION->opt_baud    = OPT_NO;
+    psOPTION->opt_cycle   = OPT_NO;
+    psOPTION->opt_io      = OPT_NO;
+    psOPTION->opt_cmp     = OPT_NO;
+    psOPTION->opt_sweep   = OPT_NO;
+    psOPTION->opt_lanes   = OPT_NO;
+    psOPTION->opt_fuzz    = OPT_NO;
+    psOPTION->opt_jobs    = OPT_NO;
+    psOPTION->opt_runs    = OPT_NO;
+    psOPTION->opt_budget  = OPT_NO;
+    psOPTION->opt_record  = OPT_NO;
+    psOPTION->opt_replay  = OPT_NO;
+    psOPTION->opt_debug   = OPT_NO;
+    psOPTION->opt_profile = OPT_NO;
+    psOPTION->opt_super   = OPT_NO;
     psOPTION->opt_rom_byte = NULL;
     psOPTION->opt_ram_byte = NULL;
     psOPTION->opt_obj_name = NULL;
     psOPTION->opt_ver_name = NULL;
     psOPTION->opt_lis_name = NULL;
+    psOPTION->opt_bin_name = NULL;
+    psOPTION->opt_pre_name = NULL;
     psOPTION->opt_log_name = NULL;
+    psOPTION->opt_dump_name = NULL;
+    psOPTION->opt_clk_freq  = NULL;
+    psOPTION->opt_baud_rate = NULL;
+    psOPTION->opt_cycle_mode = NULL;
+    psOPTION->opt_io_name    = NULL;
+    psOPTION->opt_cmp_name   = NULL;
+    psOPTION->opt_sweep_in   = NULL;
+    psOPTION->opt_lanes_num  = NULL;
+    psOPTION->opt_fuzz_dir   = NULL;
+    psOPTION->opt_jobs_num   = NULL;
+    psOPTION->opt_runs_num   = NULL;
+    psOPTION->opt_budget_num = NULL;
+    psOPTION->opt_record_pct = NULL;
+    psOPTION->opt_replay_name = NULL;
+    psOPTION->opt_profile_name = NULL;
+    psOPTION->opt_super_name   = NULL;
     psOPTION->input_file_name = NULL;
     //
     // Parse Option Line
-    while ((c = getopt_long(argc, argv, "asi:d:o:v:l:g::bt", long_option, &long_option_index)) != -1)
+    while ((c = getopt_long(argc, argv, "asi:d:o:v:l:n:p:g::btu:c:r:y::e:m:w:k:z:j:x:f:q::h:DP:S:", long_option, &long_option_index)) != -1)
     {
         switch(c)
         {
@@ -211,6 +312,18 @@ uint32_t Parse_Command_Line(int argc, char **argv, sOPTION *psOPTION)
                 psOPTION->opt_lis_name = optarg;
                 break;
             }
+            case 'n' :
+            {
+                psOPTION->opt_bin = OPT_YES;
+                psOPTION->opt_bin_name = optarg;
+                break;
+            }
+            case 'p' :
+            {
+                psOPTION->opt_pre = OPT_YES;
+                psOPTION->opt_pre_name = optarg;
+                break;
+            }
             case 'g' :
             {
                 psOPTION->opt_log = OPT_YES;
@@ -227,6 +340,108 @@ uint32_t Parse_Command_Line(int argc, char **argv, sOPTION *psOPTION)
                 psOPTION->opt_ascii = OPT_YES;
                 break;
             }
+            case 'u' :
+            {
+                psOPTION->opt_dump = OPT_YES;
+                psOPTION->opt_dump_name = optarg;
+                break;
+            }
+            case 'c' :
+            {
+                psOPTION->opt_clk = OPT_YES;
+                psOPTION->opt_clk_freq = optarg;
+                break;
+            }
+            case 'r' :
+            {
+                psOPTION->opt_baud = OPT_YES;
+                psOPTION->opt_baud_rate = optarg;
+                break;
+            }
+            case 'y' :
+            {
+                psOPTION->opt_cycle = OPT_YES;
+                psOPTION->opt_cycle_mode = optarg;
+                break;
+            }
+            case 'e' :
+            {
+                psOPTION->opt_io = OPT_YES;
+                psOPTION->opt_io_name = optarg;
+                break;
+            }
+            case 'm' :
+            {
+                psOPTION->func = FUNC_CMP;
+                psOPTION->opt_cmp = OPT_YES;
+                psOPTION->opt_cmp_name = optarg;
+                break;
+            }
+            case 'w' :
+            {
+                psOPTION->opt_sweep = OPT_YES;
+                psOPTION->opt_sweep_in = optarg;
+                break;
+            }
+            case 'k' :
+            {
+                psOPTION->opt_lanes = OPT_YES;
+                psOPTION->opt_lanes_num = optarg;
+                break;
+            }
+            case 'z' :
+            {
+                psOPTION->opt_fuzz = OPT_YES;
+                psOPTION->opt_fuzz_dir = optarg;
+                break;
+            }
+            case 'j' :
+            {
+                psOPTION->opt_jobs = OPT_YES;
+                psOPTION->opt_jobs_num = optarg;
+                break;
+            }
+            case 'x' :
+            {
+                psOPTION->opt_runs = OPT_YES;
+                psOPTION->opt_runs_num = optarg;
+                break;
+            }
+            case 'f' :
+            {
+                psOPTION->opt_budget = OPT_YES;
+                psOPTION->opt_budget_num = optarg;
+                break;
+            }
+            case 'q' :
+            {
+                psOPTION->opt_record = OPT_YES;
+                psOPTION->opt_record_pct = optarg;
+                break;
+            }
+            case 'h' :
+            {
+                psOPTION->opt_replay = OPT_YES;
+                psOPTION->opt_replay_name = optarg;
+                break;
+            }
+            case 'D' :
+            {
+                psOPTION->opt_debug = OPT_YES;
+                break;
+            }
+            case 'P' :
+            {
+                psOPTION->opt_profile = OPT_YES;
+                psOPTION->opt_profile_name = optarg;
+                break;
+            }
+            case 'S' :
+            {
+                psOPTION->opt_super = OPT_YES;
+                psOPTION->opt_super_name = optarg;
+                break;
+            }
             default  :
             {
                 fprintf(stderr, "Undefined Option \"%c\", ignored.\n", c);
@@ -253,13 +468,16 @@ uint32_t Parse_Command_Line(int argc, char **argv, sOPTION *psOPTION)
     // Decode ROM/RAM Size and Set them in each global variable
     if (psOPTION->opt_rom)
     {
-        long_num = strtol(psOPTION->opt_rom_byte, &endptr, 10);
-        if ((errno == ERANGE) || (*endptr != '\0') || (long_num < 0) || (long_num > LONG_MAX))
+        errno = 0;
+        long_num = strtoull(psOPTION->opt_rom_byte, &endptr, 10);
+        if ((errno == ERANGE) || (*endptr != '\0') || (*psOPTION->opt_rom_byte == '-')
+         || (long_num == 0) || (long_num > UINT32_MAX))
         {
             fprintf(stderr, "ROM Size is Illegal.\n");
             error = 1;
+            long_num = MAXROM_DEFAULT;
         }
-        MAXROM = (int)long_num;;
+        MAXROM = (uint32_t)long_num;
     }
     else
     {
@@ -268,35 +486,258 @@ uint32_t Parse_Command_Line(int argc, char **argv, sOPTION *psOPTION)
     //
     if (psOPTION->opt_ram)
     {
-        long_num = strtol(psOPTION->opt_ram_byte, &endptr, 10);
-        if ((errno == ERANGE) || (*endptr != '\0') || (long_num < 0) || (long_num > LONG_MAX))
+        errno = 0;
+        long_num = strtoull(psOPTION->opt_ram_byte, &endptr, 10);
+        if ((errno == ERANGE) || (*endptr != '\0') || (*psOPTION->opt_ram_byte == '-')
+         || (long_num == 0) || (long_num > UINT32_MAX))
         {
             fprintf(stderr, "RAM Size is Illegal.\n");
             error = 1;
+            long_num = MAXRAM_DEFAULT;
         }
-        MAXRAM = (int)long_num;;
+        MAXRAM = (uint32_t)long_num;
     }
     else
     {
         MAXRAM = MAXRAM_DEFAULT;
     }
+    // UART Time Estimate (same Divider as bfRun)
+    if ((psOPTION->opt_clk) || (psOPTION->opt_baud))
+    {
+        clk_freq  = CLKFREQ_DEFAULT;
+        baud_rate = UART_BAUD_DEFAULT;
+        if (psOPTION->opt_clk)
+        {
+            errno = 0;
+            long_num = strtoull(psOPTION->opt_clk_freq, &endptr, 10);
+            if ((errno == ERANGE) || (*endptr != '\0') || (*psOPTION->opt_clk_freq == '-')
+             || (long_num == 0) || (long_num > INT_MAX))
+            {
+                fprintf(stderr, "Clock Frequency is Illegal.\n");
+                error = 1;
+                long_num = CLKFREQ_DEFAULT;
+            }
+            clk_freq = (int)long_num;
+            CLK_FREQ = clk_freq;
+        }
+        if (psOPTION->opt_baud)
+        {
+            errno = 0;
+            long_num = strtoull(psOPTION->opt_baud_rate, &endptr, 10);
+            if ((errno == ERANGE) || (*endptr != '\0') || (*psOPTION->opt_baud_rate == '-')
+             || (long_num == 0) || (long_num > INT_MAX))
+            {
+                fprintf(stderr, "Baud Rate is Illegal.\n");
+                error = 1;
+                long_num = UART_BAUD_DEFAULT;
+            }
+            baud_rate = (int)long_num;
+        }
+        if (BAUD_Search((double)clk_freq, (double)baud_rate, &UART_DIV))
+        {
+            fprintf(stderr, "Baud Rate %d is not available at %dHz (Error %+.2f%%).\n",
+                baud_rate, clk_freq, UART_DIV.error);
+            error = 1;
+        }
+        UART_EST = 1;
+    }
+    // Cycle Model of RTL (FPGA or tb_TOP)
+    if (psOPTION->opt_cycle)
+    {
+        CYCLE_SIM = CYCLE_FPGA;
+        if (psOPTION->opt_cycle_mode)
+        {
+            if (strcmp(psOPTION->opt_cycle_mode, "sim") == 0)
+            {
+                CYCLE_SIM = CYCLE_TB;
+            }
+            else
+            {
+                fprintf(stderr, "Cycle Model \"%s\" is Illegal.\n", psOPTION->opt_cycle_mode);
+                error = 1;
+            }
+        }
+        if ((MAXROM != MAXROM_DEFAULT) || (MAXRAM != MAXRAM_DEFAULT))
+        {
+            fprintf(stderr, "Cycle Model needs the Default ROM/RAM Size.\n");
+            error = 1;
+        }
+    }
+    // Input Sweep
+    if (psOPTION->opt_sweep)
+    {
+        errno = 0;
+        long_num = strtoull(psOPTION->opt_sweep_in, &endptr, 10);
+        if ((errno == ERANGE) || (*endptr != '\0') || (*psOPTION->opt_sweep_in == '-')
+         || (long_num == 0) || (long_num > SWEEP_IN_MAX))
+        {
+            fprintf(stderr, "Number of Swept Inputs is Illegal.\n");
+            error = 1;
+            long_num = 0;
+        }
+        SWEEP_IN = (int)long_num;
+        if (psOPTION->opt_cycle)
+        {
+            fprintf(stderr, "Sweep is not available on the Cycle Model.\n");
+            error = 1;
+        }
+    }
+    if (psOPTION->opt_lanes)
+    {
+        errno = 0;
+        long_num = strtoull(psOPTION->opt_lanes_num, &endptr, 10);
+        if ((errno == ERANGE) || (*endptr != '\0') || (*psOPTION->opt_lanes_num == '-')
+         || (long_num == 0) || (long_num > 65536))
+        {
+            fprintf(stderr, "Number of Lanes is Illegal.\n");
+            error = 1;
+            long_num = SWEEP_LANES;
+        }
+        SWEEP_WIDTH = (uint32_t)long_num;
+    }
+    // Fuzzing
+    if (psOPTION->opt_fuzz)
+    {
+        FUZZ_DIR = psOPTION->opt_fuzz_dir;
+        if ((psOPTION->opt_sweep) || (psOPTION->opt_cycle))
+        {
+            fprintf(stderr, "Fuzzing is not available with Sweep or the Cycle Model.\n");
+            error = 1;
+        }
+    }
+    if (psOPTION->opt_jobs)
+    {
+        errno = 0;
+        long_num = strtoull(psOPTION->opt_jobs_num, &endptr, 10);
+        if ((errno == ERANGE) || (*endptr != '\0') || (*psOPTION->opt_jobs_num == '-')
+         || (long_num == 0) || (long_num > FUZZ_JOBS_MAX))
+        {
+            fprintf(stderr, "Number of Fuzz Workers is Illegal.\n");
+            error = 1;
+            long_num = 0;
+        }
+        FUZZ_JOBS = (uint32_t)long_num;
+    }
+    if (psOPTION->opt_runs)
+    {
+        errno = 0;
+        long_num = strtoull(psOPTION->opt_runs_num, &endptr, 10);
+        if ((errno == ERANGE) || (*endptr != '\0') || (*psOPTION->opt_runs_num == '-'))
+        {
+            fprintf(stderr, "Number of Fuzz Runs is Illegal.\n");
+            error = 1;
+            long_num = 0;
+        }
+        FUZZ_RUNS = (uint64_t)long_num;
+    }
+    if (psOPTION->opt_budget)
+    {
+        errno = 0;
+        long_num = strtoull(psOPTION->opt_budget_num, &endptr, 10);
+        if ((errno == ERANGE) || (*endptr != '\0') || (*psOPTION->opt_budget_num == '-')
+         || (long_num == 0))
+        {
+            fprintf(stderr, "Steps per Fuzz Run is Illegal.\n");
+            error = 1;
+            long_num = FUZZ_BUDGET_DEFAULT;
+        }
+        FUZZ_BUDGET = (uint64_t)long_num;
+    }
+    // Record and Replay
+    if (psOPTION->opt_record)
+    {
+        long_num = RECORD_OVERHEAD_DEFAULT;
+        if (psOPTION->opt_record_pct)
+        {
+            errno = 0;
+            long_num = strtoull(psOPTION->opt_record_pct, &endptr, 10);
+            if ((errno == ERANGE) || (*endptr != '\0') || (*psOPTION->opt_record_pct == '-')
+             || (long_num == 0) || (long_num > 100))
+            {
+                fprintf(stderr, "Overhead of Record is Illegal.\n");
+                error = 1;
+                long_num = RECORD_OVERHEAD_DEFAULT;
+            }
+        }
+        RECORD = (uint32_t)long_num;
+        if ((psOPTION->opt_sweep) || (psOPTION->opt_fuzz) || (psOPTION->opt_cycle))
+        {
+            fprintf(stderr, "Record is not available with Sweep, Fuzzing or the Cycle Model.\n");
+            error = 1;
+        }
+    }
+    if (psOPTION->opt_replay)
+    {
+        REPLAY_FILE = psOPTION->opt_replay_name;
+    }
+    // Debugger
+    if (psOPTION->opt_debug)
+    {
+        DEBUGGER = 1;
+        if ((psOPTION->opt_sweep) || (psOPTION->opt_fuzz) || (psOPTION->opt_cycle))
+        {
+            fprintf(stderr, "Debugger is not available with Sweep, Fuzzing or the Cycle Model.\n");
+            error = 1;
+        }
+    }
+    // Profile and Superinstructions
+    if ((psOPTION->opt_profile) || (psOPTION->opt_super))
+    {
+        PROFILE_FILE = psOPTION->opt_profile_name;
+        SUPER_FILE   = psOPTION->opt_super_name;
+        if ((psOPTION->opt_profile) && (psOPTION->opt_super))
+        {
+            fprintf(stderr, "Profile and Superinstructions can't be given together.\n");
+            error = 1;
+        }
+        if ((psOPTION->opt_sweep) || (psOPTION->opt_fuzz) || (psOPTION->opt_cycle))
+        {
+            fprintf(stderr, "Profile or Superinstructions are not available with Sweep, Fuzzing or the Cycle Model.\n");
+            error = 1;
+        }
+        if ((psOPTION->opt_log) || (psOPTION->opt_verbose))
+        {
+            fprintf(stderr, "Profile or Superinstructions need the Fast Model (without Log).\n");
+            error = 1;
+        }
+    }
+    //
     // Options for Simulation 
     SIM_LOG = (psOPTION->opt_log == OPT_YES)? 1 : 0;
     VERBOSE = (psOPTION->opt_verbose == OPT_YES)? 1 : 0;
     ASCII   = (psOPTION->opt_ascii   == OPT_YES)? 1 : 0;
     //
     DEBUG_printf(DEBUG_MAX, "psOPTION->func    = %d\n", psOPTION->func);
-    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_rom = %d, byte = %d\n", psOPTION->opt_rom, MAXROM);
-    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_ram = %d, byte = %d\n", psOPTION->opt_ram, MAXRAM);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_rom = %d, byte = %u\n", psOPTION->opt_rom, MAXROM);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_ram = %d, byte = %u\n", psOPTION->opt_ram, MAXRAM);
     DEBUG_printf(DEBUG_MAX, "psOPTION->opt_obj = %d, name = %s\n", psOPTION->opt_obj, psOPTION->opt_obj_name);
     DEBUG_printf(DEBUG_MAX, "psOPTION->opt_ver = %d, name = %s\n", psOPTION->opt_ver, psOPTION->opt_ver_name);
     DEBUG_printf(DEBUG_MAX, "psOPTION->opt_lis = %d, name = %s\n", psOPTION->opt_lis, psOPTION->opt_lis_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_bin = %d, name = %s\n", psOPTION->opt_bin, psOPTION->opt_bin_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_pre = %d, name = %s\n", psOPTION->opt_pre, psOPTION->opt_pre_name);
     if (psOPTION->opt_log_name == NULL)
         DEBUG_printf(DEBUG_MAX, "psOPTION->opt_log = %d\n"           , psOPTION->opt_log);
     else
         DEBUG_printf(DEBUG_MAX, "psOPTION->opt_log = %d, name = %s\n", psOPTION->opt_log, psOPTION->opt_log_name);
     DEBUG_printf(DEBUG_MAX, "psOPTION->opt_verbose = %d\n"       , psOPTION->opt_verbose);
     DEBUG_printf(DEBUG_MAX, "psOPTION->opt_ascii   = %d\n"       , psOPTION->opt_ascii  );
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_dump = %d, name = %s\n", psOPTION->opt_dump, psOPTION->opt_dump_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_clk  = %d, freq = %s\n", psOPTION->opt_clk, psOPTION->opt_clk_freq);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_baud = %d, rate = %s\n", psOPTION->opt_baud, psOPTION->opt_baud_rate);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_cycle = %d, mode = %s\n", psOPTION->opt_cycle, psOPTION->opt_cycle_mode);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_io   = %d, name = %s\n", psOPTION->opt_io, psOPTION->opt_io_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_cmp  = %d, name = %s\n", psOPTION->opt_cmp, psOPTION->opt_cmp_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_sweep = %d, in = %s\n", psOPTION->opt_sweep, psOPTION->opt_sweep_in);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_lanes = %d, num = %s\n", psOPTION->opt_lanes, psOPTION->opt_lanes_num);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_fuzz  = %d, dir = %s\n", psOPTION->opt_fuzz, psOPTION->opt_fuzz_dir);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_jobs  = %d, num = %s\n", psOPTION->opt_jobs, psOPTION->opt_jobs_num);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_runs  = %d, num = %s\n", psOPTION->opt_runs, psOPTION->opt_runs_num);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_budget = %d, num = %s\n", psOPTION->opt_budget, psOPTION->opt_budget_num);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_record = %d, pct = %s\n", psOPTION->opt_record, psOPTION->opt_record_pct);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_replay = %d, name = %s\n", psOPTION->opt_replay, psOPTION->opt_replay_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_debug  = %d\n", psOPTION->opt_debug);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_profile = %d, name = %s\n", psOPTION->opt_profile, psOPTION->opt_profile_name);
+    DEBUG_printf(DEBUG_MAX, "psOPTION->opt_super   = %d, name = %s\n", psOPTION->opt_super, psOPTION->opt_super_name);
     DEBUG_printf(DEBUG_MAX, "psOPTION->input_file_name = %s\n", psOPTION->input_file_name);
     //
     return error;
@@ -324,6 +765,7 @@ int main (int argc, char **argv)
     {
         case FUNC_ASM : {Do_Asm(&option); break;}
         case FUNC_SIM : {Do_Sim(&option); break;}
+        case FUNC_CMP : {Do_Cmp(&option); break;}
         default : break;
     }
     //
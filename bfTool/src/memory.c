@@ -0,0 +1,186 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : memory.c
+// Description : Memory Allocation Routine
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // memfd_create(), fallocate()
+#endif
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+//
+#include "memory.h"
+
+//------------------------------------------------
+// Allocate Zero-cleared Memory
+//     Anonymous pages are mapped on first touch,
+//     so a huge area costs nothing until used.
+//------------------------------------------------
+unsigned char *MEM_Alloc(uint64_t size)
+{
+    if ((size == 0) || (size > (uint64_t)SIZE_MAX)) return NULL;
+#if !defined(_WIN32)
+    void *mem = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return (mem == MAP_FAILED)? NULL : (unsigned char*)mem;
+#else
+    return (unsigned char*)calloc((size_t)size, 1);
+#endif
+}
+
+//------------------------------------------------
+// Clear Memory to Zero
+//     Whole pages are given back to the kernel
+//     and come back as zero pages on next touch.
+//------------------------------------------------
+void MEM_Clear(unsigned char *mem, uint64_t size)
+{
+#if !defined(_WIN32)
+    uint64_t page = (uint64_t)sysconf(_SC_PAGESIZE);
+    uint64_t body = size - (size % page); // mem is page aligned
+    if ((body > 0) && (madvise(mem, (size_t)body, MADV_DONTNEED) == 0))
+    {
+        memset(mem + body, 0, (size_t)(size - body));
+        return;
+    }
+#endif
+    memset(mem, 0, (size_t)size);
+}
+
+//------------------------------------------------
+// Free Memory
+//------------------------------------------------
+void MEM_Free(unsigned char *mem, uint64_t size)
+{
+    if (mem == NULL) return;
+#if !defined(_WIN32)
+    munmap(mem, (size_t)size);
+#else
+    free(mem);
+#endif
+}
+
+//------------------------------------------------
+// Search a Byte Backward (memrchr)
+//------------------------------------------------
+unsigned char *MEM_Rchr(const unsigned char *mem, int ch, uint64_t size)
+{
+#if defined(__GLIBC__)
+    return (unsigned char*)memrchr(mem, ch, (size_t)size);
+#else
+    while (size > 0)
+    {
+        size--;
+        if (mem[size] == (unsigned char)ch) return (unsigned char*)(mem + size);
+    }
+    return NULL;
+#endif
+}
+
+//------------------------------------------------
+// Allocate Ring Memory
+//     If the size is a multiple of the page size,
+//     one memfd is mapped twice back to back, so
+//     mem[i] and mem[i + size] are the same byte
+//     for 0 <= i < size. Otherwise (or if memfd is
+//     not available, or mirror is 0) a plain area
+//     is allocated and mirrored is 0.
+//------------------------------------------------
+int MEM_Ring_Alloc(sRING *psRING, uint64_t size, int mirror)
+{
+    psRING->mem      = NULL;
+    psRING->size     = size;
+    psRING->fd       = -1;
+    psRING->mirrored = 0;
+#if defined(__linux__)
+    uint64_t page = (uint64_t)sysconf(_SC_PAGESIZE);
+    if ((mirror) && (size > 0) && ((size % page) == 0) && (size <= (uint64_t)SIZE_MAX / 2))
+    {
+        unsigned char *base;
+        void *view0;
+        void *view1;
+        int fd;
+        //
+        fd = memfd_create("bfTool_ram", MFD_CLOEXEC);
+        if ((fd >= 0) && (ftruncate(fd, (off_t)size) == 0))
+        {
+            // Reserve address space for 2 views, then map over it
+            base = (unsigned char*)mmap(NULL, (size_t)(size * 2), PROT_NONE,
+                                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if ((void*)base != MAP_FAILED)
+            {
+                view0 = mmap(base,        (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+                view1 = mmap(base + size, (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+                if ((view0 != MAP_FAILED) && (view1 != MAP_FAILED))
+                {
+                    psRING->mem      = base;
+                    psRING->fd       = fd;
+                    psRING->mirrored = 1;
+                    return 0;
+                }
+                munmap(base, (size_t)(size * 2));
+            }
+        }
+        if (fd >= 0) close(fd);
+    }
+#endif
+    //
+    // Plain Area
+    psRING->mem = MEM_Alloc(size);
+    return (psRING->mem == NULL)? -1 : 0;
+}
+
+//------------------------------------------------
+// Clear Ring Memory to Zero
+//     madvise() does not zero shared pages, so the
+//     memfd backing store is punched out instead.
+//------------------------------------------------
+void MEM_Ring_Clear(sRING *psRING)
+{
+#if defined(__linux__)
+    if (psRING->mirrored)
+    {
+        if (fallocate(psRING->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, 0, (off_t)psRING->size) == 0) return;
+        memset(psRING->mem, 0, (size_t)psRING->size);
+        return;
+    }
+#endif
+    MEM_Clear(psRING->mem, psRING->size);
+}
+
+//------------------------------------------------
+// Free Ring Memory
+//------------------------------------------------
+void MEM_Ring_Free(sRING *psRING)
+{
+    if (psRING->mem == NULL) return;
+#if defined(__linux__)
+    if (psRING->mirrored)
+    {
+        munmap(psRING->mem, (size_t)(psRING->size * 2));
+        close(psRING->fd);
+        psRING->mem = NULL;
+        return;
+    }
+#endif
+    MEM_Free(psRING->mem, psRING->size);
+    psRING->mem = NULL;
+}
+
+//===========================================================
+// End of File
+//===========================================================
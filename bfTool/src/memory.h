@@ -0,0 +1,46 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : memory.h
+// Description : Memory Allocation Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef __MEMORY_H__
+#define __MEMORY_H__
+
+//-------------------------------
+// Ring Memory
+//     When mirrored, mem[0..size*2-1] is valid
+//     and mem[i + size] aliases mem[i].
+//-------------------------------
+typedef struct
+{
+    unsigned char *mem;
+    uint64_t size;
+    int      fd;       // memfd (-1 if not mirrored)
+    int      mirrored; // 1 if mapped twice back to back
+} sRING;
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+unsigned char *MEM_Alloc(uint64_t size);
+void MEM_Clear(unsigned char *mem, uint64_t size);
+void MEM_Free(unsigned char *mem, uint64_t size);
+unsigned char *MEM_Rchr(const unsigned char *mem, int ch, uint64_t size);
+int  MEM_Ring_Alloc(sRING *psRING, uint64_t size, int mirror);
+void MEM_Ring_Clear(sRING *psRING);
+void MEM_Ring_Free(sRING *psRING);
+
+#endif
+//===========================================================
+// End of File
+//===========================================================
@@ -0,0 +1,268 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : ptrange.c
+// Description : Static Pointer Range Analysis
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+//
+#include "bfsim.h"
+#include "ptrange.h"
+
+//-----------------------------------
+// Interval of Pointer Offsets
+//     lo > hi : not reached
+//-----------------------------------
+typedef struct
+{
+    int64_t lo;
+    int64_t hi;
+} sIVL;
+//
+static const sIVL ivl_none = {1, 0};
+static const sIVL ivl_zero = {0, 0};
+//
+#define IVL_NONE(a) ((a).lo > (a).hi)
+
+//-----------------------------------
+// Work Area
+//-----------------------------------
+typedef struct
+{
+    const unsigned char *rom;
+    uint32_t rom_size;
+    uint32_t entry;
+    uint32_t ram_size;
+    uint32_t *jump;  // BEGIN : PC of END, END : loop number
+    sIVL     *move;  // per loop : pointer moved by one iteration
+    sIVL     *stack; // states after the loops being walked
+} sWORK;
+
+//----------------------------------
+// Add Intervals
+//----------------------------------
+static sIVL Ivl_Add(sIVL a, sIVL b)
+{
+    sIVL r;
+    //
+    if ((IVL_NONE(a)) || (IVL_NONE(b))) return ivl_none;
+    r.lo = ((a.lo == -PTRANGE_INF) || (b.lo == -PTRANGE_INF))? -PTRANGE_INF : a.lo + b.lo;
+    r.hi = ((a.hi ==  PTRANGE_INF) || (b.hi ==  PTRANGE_INF))?  PTRANGE_INF : a.hi + b.hi;
+    return r;
+}
+
+//----------------------------------
+// Join Intervals
+//----------------------------------
+static sIVL Ivl_Join(sIVL a, sIVL b)
+{
+    if (IVL_NONE(a)) return b;
+    if (IVL_NONE(b)) return a;
+    a.lo = (b.lo < a.lo)? b.lo : a.lo;
+    a.hi = (b.hi > a.hi)? b.hi : a.hi;
+    return a;
+}
+
+//----------------------------------
+// States at the Head of a Loop
+//     All of s + k * move for k >= 0.
+//----------------------------------
+static sIVL Ivl_Loop(sIVL s, sIVL move)
+{
+    if ((IVL_NONE(s)) || (IVL_NONE(move))) return s;
+    if (move.lo < 0) s.lo = -PTRANGE_INF;
+    if (move.hi > 0) s.hi =  PTRANGE_INF;
+    return s;
+}
+
+//----------------------------------
+// Walk a Loop Body
+//     From the body start at offset 0, with
+//     the loops inside already summarized.
+//     Returns the offset at the END.
+//----------------------------------
+static sIVL Walk_Body(sWORK *psWORK, uint32_t from, uint32_t to)
+{
+    sIVL s = ivl_zero;
+    uint32_t pc;
+    //
+    for (pc = from; pc < to; pc++)
+    {
+        switch(psWORK->rom[pc])
+        {
+            case BFSIM_CODE_PINC  : s = Ivl_Add(s, (sIVL){ 1,  1}); break;
+            case BFSIM_CODE_PDEC  : s = Ivl_Add(s, (sIVL){-1, -1}); break;
+            case BFSIM_CODE_RESET : s = ivl_none; break;
+            case BFSIM_CODE_BEGIN :
+            {
+                s = Ivl_Loop(s, psWORK->move[psWORK->jump[psWORK->jump[pc]]]);
+                pc = psWORK->jump[pc];
+                break;
+            }
+            default : break;
+        }
+    }
+    return s;
+}
+
+//----------------------------------
+// Walk the Program
+//     s is the state at PC 0 (other than
+//     the entry). Returns the state at the
+//     end of ROM (where PC wraps around).
+//----------------------------------
+static sIVL Walk_Program(sWORK *psWORK, sIVL s, sPTRANGE *psRANGE, uint8_t *safe)
+{
+    sIVL reach = ivl_none;
+    sIVL t, m;
+    uint32_t pc, n;
+    uint32_t depth = 0;
+    int64_t last = (int64_t)psWORK->ram_size - 1;
+    //
+    for (pc = 0; pc < psWORK->rom_size; pc++)
+    {
+        if (pc == psWORK->entry) s = Ivl_Join(s, ivl_zero);
+        reach = Ivl_Join(reach, s);
+        switch(psWORK->rom[pc])
+        {
+            case BFSIM_CODE_PINC  :
+            case BFSIM_CODE_PDEC  :
+            {
+                t = Ivl_Add(s, (psWORK->rom[pc] == BFSIM_CODE_PINC)? (sIVL){1, 1} : (sIVL){-1, -1});
+                if ((safe) && (!IVL_NONE(s)) && (s.lo >= 0) && (s.hi <= last) && (t.lo >= 0) && (t.hi <= last))
+                    safe[pc >> 3] |= (uint8_t)(1 << (pc & 7));
+                s = t;
+                break;
+            }
+            case BFSIM_CODE_RESET : s = ivl_none; break;
+            case BFSIM_CODE_BEGIN :
+            {
+                n = psWORK->jump[psWORK->jump[pc]];
+                m = psWORK->move[n];
+                s = Ivl_Loop(s, m);
+                psWORK->stack[depth++] = s;
+                //
+                // Loop moving by itself (not by a loop inside)
+                if ((psRANGE) && (!IVL_NONE(s)) && (!IVL_NONE(m)) && ((m.lo != 0) || (m.hi != 0))
+                 && (m.lo != -PTRANGE_INF) && (m.hi != PTRANGE_INF))
+                {
+                    if (psRANGE->num_loop < PTRANGE_LOOP_MAX)
+                    {
+                        psRANGE->loop[psRANGE->num_loop] = pc;
+                        psRANGE->move[psRANGE->num_loop] = (m.lo == m.hi)? m.lo : 0;
+                    }
+                    psRANGE->num_loop++;
+                }
+                break;
+            }
+            case BFSIM_CODE_END : s = psWORK->stack[--depth]; break;
+            default : break;
+        }
+    }
+    reach = Ivl_Join(reach, s);
+    if (psRANGE)
+    {
+        psRANGE->lo = (IVL_NONE(reach))? 0 : reach.lo;
+        psRANGE->hi = (IVL_NONE(reach))? 0 : reach.hi;
+    }
+    return s;
+}
+
+//----------------------------------
+// Match Brackets and Summarize Loops
+//     Inner loops end first, so each body is
+//     walked once when its END is found.
+//     Returns 0 if brackets are not balanced
+//     or the entry is inside a loop.
+//----------------------------------
+static int Summarize_Loops(sWORK *psWORK)
+{
+    uint32_t *open;
+    uint32_t depth = 0;
+    uint32_t num = 0;
+    uint32_t pc, begin;
+    int  ok = 1;
+    //
+    open = (uint32_t*)malloc(sizeof(uint32_t) * ((uint64_t)psWORK->rom_size / 2 + 1));
+    if (open == NULL) return 0;
+    for (pc = 0; (pc < psWORK->rom_size) && (ok); pc++)
+    {
+        if ((pc == psWORK->entry) && (depth)) ok = 0;
+        if (psWORK->rom[pc] == BFSIM_CODE_BEGIN) open[depth++] = pc;
+        if (psWORK->rom[pc] != BFSIM_CODE_END) continue;
+        if (depth == 0) {ok = 0; break;}
+        begin = open[--depth];
+        psWORK->jump[begin] = pc;
+        psWORK->jump[pc] = num;
+        psWORK->move[num] = Walk_Body(psWORK, begin + 1, pc);
+        num++;
+    }
+    free(open);
+    return (ok) && (depth == 0);
+}
+
+//----------------------------------
+// Analyze the Pointer Range
+//     safe : bitmap of rom_size bits cleared
+//            by the caller (or NULL)
+//     Returns -1 if memory can't be allocated.
+//----------------------------------
+int PTRANGE_Analyze(const unsigned char *rom, uint32_t rom_size, uint32_t entry, uint32_t ram_size,
+                    sPTRANGE *psRANGE, uint8_t *safe)
+{
+    sWORK work;
+    sIVL in = ivl_none;
+    sIVL out;
+    int  i;
+    //
+    memset(psRANGE, 0, sizeof(sPTRANGE));
+    psRANGE->lo = -PTRANGE_INF;
+    psRANGE->hi =  PTRANGE_INF;
+    work.rom      = rom;
+    work.rom_size = rom_size;
+    work.entry    = entry;
+    work.ram_size = ram_size;
+    work.jump  = (uint32_t*)malloc(sizeof(uint32_t) * (uint64_t)rom_size);
+    work.move  = (sIVL*)malloc(sizeof(sIVL) * ((uint64_t)rom_size / 2 + 1));
+    work.stack = (sIVL*)malloc(sizeof(sIVL) * ((uint64_t)rom_size / 2 + 1));
+    if ((work.jump == NULL) || (work.move == NULL) || (work.stack == NULL))
+    {
+        free(work.jump);
+        free(work.move);
+        free(work.stack);
+        return -1;
+    }
+    //
+    if (Summarize_Loops(&work))
+    {
+        // State at PC 0 when PC wraps around at the end of ROM
+        // (widened to unbounded if it keeps growing)
+        for (i = 0; i < 4; i++)
+        {
+            out = Walk_Program(&work, in, NULL, NULL);
+            if ((IVL_NONE(out)) || ((!IVL_NONE(in)) && (out.lo >= in.lo) && (out.hi <= in.hi))) break;
+            if ((i > 0) && (out.lo < in.lo)) out.lo = -PTRANGE_INF;
+            if ((i > 0) && (out.hi > in.hi)) out.hi =  PTRANGE_INF;
+            in = Ivl_Join(in, out);
+        }
+        if (i == 4) in = (sIVL){-PTRANGE_INF, PTRANGE_INF};
+        Walk_Program(&work, in, psRANGE, safe);
+        psRANGE->valid = 1;
+    }
+    free(work.jump);
+    free(work.move);
+    free(work.stack);
+    return 0;
+}
+
+//===========================================================
+// End of Program
+//===========================================================
@@ -0,0 +1,67 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : ptrange.h
+// Description : Static Pointer Range Analysis Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+
+#ifndef __PTRANGE_H__
+#define __PTRANGE_H__
+
+//-----------------------------------------------------------
+// Usage
+//     Bounds the data pointer over all runs of a program
+//     without running it. The pointer starts at 0 from the
+//     entry (and after RESET), P++/P-- move it by one, and
+//     a loop whose body moves it by the same amount every
+//     iteration in total (0 for a balanced loop) keeps it
+//     within the range of one iteration. Other loops, such
+//     as scans ([>], [<<]), make the range unbounded in the
+//     direction they move, and are listed.
+//
+//     PTRANGE_Analyze(rom, rom_size, entry, ram_size, &range, safe);
+//     if (range.hi < PTRANGE_INF) ... // pointer never goes above range.hi
+//
+//     Offsets are counted without wrap, so range.lo < 0
+//     means the pointer may wrap below 0. The optional
+//     bitmap safe (a bit per PC) tells the P++/P-- which
+//     are proven not to wrap on a RAM of ram_size bytes.
+//-----------------------------------------------------------
+
+//-----------------------------------
+// Parameters
+//-----------------------------------
+#define PTRANGE_INF      INT64_MAX // unbounded
+#define PTRANGE_LOOP_MAX 16        // unbounded loops listed
+
+//-----------------------------------
+// Result of the Analysis
+//-----------------------------------
+typedef struct
+{
+    int      valid;    // 0 if not analyzed (brackets, entry in a loop)
+    int64_t  lo;       // lowest pointer (-PTRANGE_INF if unbounded)
+    int64_t  hi;       // highest pointer (PTRANGE_INF if unbounded)
+    uint32_t num_loop; // loops which make the range unbounded
+    uint32_t loop[PTRANGE_LOOP_MAX]; // their PCs of BEGIN (first ones)
+    int64_t  move[PTRANGE_LOOP_MAX]; // pointer moved per iteration (0 if varies)
+} sPTRANGE;
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+int PTRANGE_Analyze(const unsigned char *rom, uint32_t rom_size, uint32_t entry, uint32_t ram_size,
+                    sPTRANGE *psRANGE, uint8_t *safe);
+
+#endif
+
+//===========================================================
+// End of Program
+//===========================================================
@@ -0,0 +1,324 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : replay.c
+// Description : Record and Replay of a Run
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+//
+#include "bfsim.h"
+#include "replay.h"
+
+//----------------------------------
+// Parameters
+//----------------------------------
+#define REPLAY_INTERVAL_INIT (1ULL << 20) // instructions
+#define REPLAY_MARGIN        (1ULL << 16) // stepped before the index
+
+//----------------------------------
+// CPU Time in Seconds
+//----------------------------------
+static double REPLAY_Time(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+//----------------------------------
+// Set the Limit for the next Snapshot
+//----------------------------------
+static void REPLAY_Set_Limit(sREPLAY *psREC)
+{
+    BFSIM_Set_Limit(psREC->psSIM, psREC->next - psREC->base);
+}
+
+//----------------------------------
+// Take a Snapshot at the Current Index
+//----------------------------------
+static void REPLAY_Snap(sREPLAY *psREC)
+{
+    sREPLAY_SNAP *snap;
+    sBFSNAP *psPREV;
+    uint32_t size;
+    //
+    if (psREC->num_snap == psREC->size_snap)
+    {
+        size = (psREC->size_snap)? psREC->size_snap * 2 : 256;
+        snap = (sREPLAY_SNAP*)realloc(psREC->snap, sizeof(sREPLAY_SNAP) * size);
+        if (snap == NULL)
+        {
+            fprintf(stderr, "======== ERROR: Can't allocate Snapshot area.\n");
+            exit(EXIT_FAILURE);
+        }
+        psREC->snap = snap;
+        psREC->size_snap = size;
+    }
+    psPREV = (psREC->num_snap)? psREC->snap[psREC->num_snap - 1].psSNAP : NULL;
+    snap = &psREC->snap[psREC->num_snap];
+    snap->index  = REPLAY_Index(psREC);
+    snap->base   = psREC->base;
+    snap->in_pos = psREC->in_pos;
+    snap->psSNAP = BFSIM_Snap_Save(psREC->psSIM, psPREV);
+    if (snap->psSNAP == NULL)
+    {
+        fprintf(stderr, "======== ERROR: Can't allocate Snapshot area.\n");
+        exit(EXIT_FAILURE);
+    }
+    psREC->bytes = psREC->bytes + BFSIM_Snap_Bytes(snap->psSNAP);
+    psREC->num_snap++;
+}
+
+//----------------------------------
+// Thin out Snapshots
+//     Every other snapshot is freed, except
+//     the first and the last, and the
+//     interval is doubled.
+//----------------------------------
+static void REPLAY_Thin(sREPLAY *psREC)
+{
+    uint32_t i, n = 1;
+    //
+    for (i = 1; i < psREC->num_snap - 1; i++)
+    {
+        if (i & 1)
+            psREC->bytes = psREC->bytes - BFSIM_Snap_Free(psREC->snap[i].psSNAP);
+        else
+            psREC->snap[n++] = psREC->snap[i];
+    }
+    psREC->snap[n++] = psREC->snap[psREC->num_snap - 1];
+    psREC->num_snap = n;
+    if (psREC->interval < REPLAY_INTERVAL_MAX) psREC->interval = psREC->interval * 2;
+}
+
+//----------------------------------
+// Create a Recorder
+//     overhead : target of snapshot time
+//                in % of run time
+//     The machine should be just created.
+//----------------------------------
+sREPLAY *REPLAY_Create(sBFSIM *psSIM, uint32_t overhead)
+{
+    sREPLAY *psREC;
+    //
+    psREC = (sREPLAY*)calloc(1, sizeof(sREPLAY));
+    if (psREC == NULL) return NULL;
+    psREC->psSIM    = psSIM;
+    psREC->ratio    = (double)overhead / 100.0;
+    psREC->interval = REPLAY_INTERVAL_INIT;
+    psREC->next     = REPLAY_INTERVAL_INIT;
+    REPLAY_Snap(psREC);
+    REPLAY_Set_Limit(psREC);
+    psREC->time_mark = REPLAY_Time();
+    return psREC;
+}
+
+//----------------------------------
+// Destroy a Recorder
+//----------------------------------
+void REPLAY_Destroy(sREPLAY *psREC)
+{
+    uint32_t i;
+    //
+    if (psREC == NULL) return;
+    BFSIM_Set_Limit(psREC->psSIM, 0);
+    for (i = 0; i < psREC->num_snap; i++) BFSIM_Snap_Free(psREC->snap[i].psSNAP);
+    free(psREC->snap);
+    free(psREC->in);
+    free(psREC);
+}
+
+//----------------------------------
+// Current Index
+//----------------------------------
+uint64_t REPLAY_Index(sREPLAY *psREC)
+{
+    sBFSIM_STATE state;
+    //
+    BFSIM_Get_State(psREC->psSIM, &state);
+    return psREC->base + state.count;
+}
+
+//----------------------------------
+// Limit reached in the Live Run
+//     Takes a snapshot and adapts the
+//     interval to the time it took.
+//----------------------------------
+void REPLAY_Limit(sREPLAY *psREC)
+{
+    double t_run, t_snap, now;
+    uint64_t index = REPLAY_Index(psREC);
+    //
+    if (index >= psREC->next)
+    {
+        now = REPLAY_Time();
+        t_run = now - psREC->time_mark;
+        REPLAY_Snap(psREC);
+        t_snap = REPLAY_Time() - now;
+        psREC->time_run  = psREC->time_run  + t_run;
+        psREC->time_snap = psREC->time_snap + t_snap;
+        //
+        // Adapt the Interval
+        if ((t_snap > t_run * psREC->ratio) && (psREC->interval < REPLAY_INTERVAL_MAX))
+            psREC->interval = psREC->interval * 2;
+        else if ((t_snap * 4 < t_run * psREC->ratio) && (psREC->interval > REPLAY_INTERVAL_MIN))
+            psREC->interval = psREC->interval / 2;
+        while ((psREC->bytes > REPLAY_MEM_MAX) && (psREC->num_snap > 2)) REPLAY_Thin(psREC);
+        psREC->next = index + psREC->interval;
+        psREC->time_mark = REPLAY_Time();
+    }
+    REPLAY_Set_Limit(psREC);
+}
+
+//----------------------------------
+// RESET executed in the Live Run
+//----------------------------------
+void REPLAY_Reset(sREPLAY *psREC)
+{
+    sBFSIM_STATE state;
+    //
+    BFSIM_Get_State(psREC->psSIM, &state);
+    psREC->base = psREC->base + state.count_reset + 1; // RESET counted
+    REPLAY_Set_Limit(psREC);
+}
+
+//----------------------------------
+// Input given in the Live Run
+//----------------------------------
+void REPLAY_Input(sREPLAY *psREC, unsigned char data)
+{
+    unsigned char *in;
+    uint32_t size;
+    //
+    if (psREC->num_in == psREC->size_in)
+    {
+        size = (psREC->size_in)? psREC->size_in * 2 : 4096;
+        in = (unsigned char*)realloc(psREC->in, size);
+        if (in == NULL)
+        {
+            fprintf(stderr, "======== ERROR: Can't allocate Input area.\n");
+            exit(EXIT_FAILURE);
+        }
+        psREC->in = in;
+        psREC->size_in = size;
+    }
+    psREC->in[psREC->num_in++] = data;
+    psREC->in_pos = psREC->num_in;
+}
+
+//----------------------------------
+// Handle an Event in Replay
+//     Returns 1 to go on.
+//----------------------------------
+static int REPLAY_Event(sREPLAY *psREC, int event)
+{
+    sBFSIM_STATE state;
+    //
+    switch(event)
+    {
+        case BFSIM_EV_LIMIT :
+        case BFSIM_EV_OUT   :
+        case BFSIM_EV_BREAK :
+        case BFSIM_EV_WATCH : return 1;
+        case BFSIM_EV_IN    :
+        {
+            if (psREC->in_pos >= psREC->num_in) return 0;
+            BFSIM_Feed_Input(psREC->psSIM, psREC->in[psREC->in_pos++]);
+            return 1;
+        }
+        case BFSIM_EV_RESET :
+        {
+            BFSIM_Get_State(psREC->psSIM, &state);
+            psREC->base = psREC->base + state.count_reset + 1; // RESET counted
+            return 1;
+        }
+        default : return 0; // STOP, ILLEGAL, HANG
+    }
+}
+
+//----------------------------------
+// Find the last Snapshot at or before an Index
+//----------------------------------
+static uint32_t REPLAY_Find(sREPLAY *psREC, uint64_t index)
+{
+    uint32_t lo = 0, hi = psREC->num_snap - 1, mid;
+    //
+    while (lo < hi)
+    {
+        mid = (lo + hi + 1) / 2;
+        if (psREC->snap[mid].index <= index) lo = mid; else hi = mid - 1;
+    }
+    return lo;
+}
+
+//----------------------------------
+// Load a Snapshot
+//----------------------------------
+static void REPLAY_Load(sREPLAY *psREC, uint32_t k)
+{
+    BFSIM_Snap_Load(psREC->psSIM, psREC->snap[k].psSNAP);
+    psREC->base   = psREC->snap[k].base;
+    psREC->in_pos = psREC->snap[k].in_pos;
+}
+
+//----------------------------------
+// Go to an Index
+//     Starts from the nearest snapshot (or from
+//     the current index if nearer), runs the fast
+//     model up to a margin before the index and
+//     steps the rest. If the fast
+//     model went past (a long scan), the margin is
+//     widened and the snapshot loaded again.
+//     Trace should be off. Returns BFSIM_EV_LIMIT
+//     when the index is reached, or the event which
+//     stopped the replay.
+//----------------------------------
+int REPLAY_Goto(sREPLAY *psREC, uint64_t index)
+{
+    uint64_t margin = REPLAY_MARGIN;
+    uint64_t now;
+    uint32_t k;
+    int  event = BFSIM_EV_LIMIT;
+    //
+    if (index > psREC->end) index = psREC->end;
+    k = REPLAY_Find(psREC, index);
+    now = REPLAY_Index(psREC);
+    if ((index < now) || (psREC->snap[k].index > now)) REPLAY_Load(psREC, k);
+    while (1)
+    {
+        // Fast up to the Margin
+        while (((now = REPLAY_Index(psREC)) < index) && (index - now > margin))
+        {
+            BFSIM_Set_Limit(psREC->psSIM, index - margin - psREC->base);
+            event = BFSIM_Run(psREC->psSIM, 0);
+            if (REPLAY_Event(psREC, event) == 0) break;
+            event = BFSIM_EV_LIMIT;
+        }
+        if (REPLAY_Index(psREC) <= index) break;
+        REPLAY_Load(psREC, k);
+        margin = margin * 4;
+    }
+    //
+    // Step the Rest
+    BFSIM_Set_Limit(psREC->psSIM, 0);
+    while ((event == BFSIM_EV_LIMIT) && ((now = REPLAY_Index(psREC)) < index))
+    {
+        event = BFSIM_Run(psREC->psSIM, index - now);
+        if (REPLAY_Event(psREC, event) == 0) break;
+        event = BFSIM_EV_LIMIT;
+    }
+    REPLAY_Set_Limit(psREC);
+    return event;
+}
+
+//===========================================================
+// End of Program
+//===========================================================
@@ -0,0 +1,107 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : replay.h
+// Description : Record and Replay of a Run Header
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <stdint.h>
+#include "bfsim.h"
+
+#ifndef __REPLAY_H__
+#define __REPLAY_H__
+
+//-----------------------------------------------------------
+// Usage
+//     A run is recorded as the bytes given to IN and the
+//     snapshots taken every interval instructions. The
+//     interval is doubled or halved so that the time to
+//     take snapshots stays below the given percentage of
+//     the time to run.
+//
+//     psREC = REPLAY_Create(psSIM, 5);
+//     while (1)
+//     {
+//         event = BFSIM_Run(psSIM, 0);
+//         if (event == BFSIM_EV_LIMIT) REPLAY_Limit(psREC);
+//         if (event == BFSIM_EV_RESET) REPLAY_Reset(psREC);
+//         if (event == BFSIM_EV_IN   ) REPLAY_Input(psREC, data);
+//     }
+//     REPLAY_Goto(psREC, index); // any index up to the end
+//     REPLAY_Destroy(psREC);
+//
+//     The instruction index counts from the start of the
+//     run across RESETs (RESET itself counted as one).
+//     REPLAY_Goto() loads the nearest snapshot before the
+//     index and replays the recorded inputs from there, so
+//     going back costs about one interval whatever the
+//     length of the run.
+//-----------------------------------------------------------
+
+//-----------------------------------
+// Parameters
+//-----------------------------------
+#define REPLAY_INTERVAL_MIN (1ULL << 16) // instructions
+#define REPLAY_INTERVAL_MAX (1ULL << 40)
+#define REPLAY_MEM_MAX      (256ULL << 20) // bytes of snapshots
+
+//-----------------------------------
+// Snapshot of the Run
+//-----------------------------------
+typedef struct
+{
+    uint64_t index;  // instructions since the start
+    uint64_t base;   // index after the last RESET
+    uint32_t in_pos; // inputs taken
+    sBFSNAP *psSNAP;
+} sREPLAY_SNAP;
+
+//-----------------------------------
+// Recorder
+//-----------------------------------
+typedef struct
+{
+    sBFSIM  *psSIM;
+    double   ratio;    // target of snapshot time / run time
+    // Snapshots
+    sREPLAY_SNAP *snap;
+    uint32_t num_snap;
+    uint32_t size_snap; // allocated entries
+    uint64_t bytes;     // allocated by snapshots
+    uint64_t interval;  // instructions between snapshots
+    uint64_t next;      // index of the next snapshot
+    // Time
+    double   time_mark; // CPU time after the last snapshot
+    double   time_run;  // CPU time of the run in total
+    double   time_snap; // CPU time of snapshots in total
+    // Inputs
+    unsigned char *in;
+    uint32_t num_in;
+    uint32_t size_in;   // allocated bytes
+    // Position
+    uint64_t base;      // index after the last RESET
+    uint32_t in_pos;    // inputs taken
+    uint64_t end;       // index of the live run
+} sREPLAY;
+
+//-------------------------------
+// Prototypes
+//-------------------------------
+sREPLAY *REPLAY_Create(sBFSIM *psSIM, uint32_t overhead);
+void REPLAY_Destroy(sREPLAY *psREC);
+uint64_t REPLAY_Index(sREPLAY *psREC);
+void REPLAY_Limit(sREPLAY *psREC);
+void REPLAY_Reset(sREPLAY *psREC);
+void REPLAY_Input(sREPLAY *psREC, unsigned char data);
+int  REPLAY_Goto(sREPLAY *psREC, uint64_t index);
+
+#endif
+
+//===========================================================
+// End of Program
+//===========================================================
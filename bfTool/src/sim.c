@@ -10,12 +10,22 @@
 // Copyright (C) 2025 M.Maruyama
 //===========================================================
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "asm.h"
+#include "baud.h"
+#include "bfsim.h"
+#include "binfile.h"
+#include "cycle.h"
+#include "fuzz.h"
+#include "iocmp.h"
+#include "replay.h"
 #include "defines.h"
+#include "hexfile.h"
 #include "utility.h"
 #include "sim.h"
 
@@ -23,338 +33,1335 @@
 // Global Variables
 //-------------------------
 int ctrl_c = 0;
-int MAXPTR = 0;
-extern int MAXROM;
-extern int MAXRAM;
+extern uint32_t MAXROM;
+extern uint32_t MAXRAM;
 extern int VERBOSE;
 extern int ASCII;
+extern int UART_EST;
+extern sBAUD UART_DIV;
+extern int CYCLE_SIM;
+extern int CLK_FREQ;
+extern int SWEEP_IN;
+extern uint32_t SWEEP_WIDTH;
+extern char *FUZZ_DIR;
+extern uint32_t RECORD;
+extern char *REPLAY_FILE;
+extern int DEBUGGER;
+extern char *PROFILE_FILE;
+extern char *SUPER_FILE;
+static sBFSIM *psSIM_ACTIVE = NULL;
+static sCYCLE *psCYCLE_ACTIVE = NULL;
+static sREPLAY *psREC_ACTIVE = NULL;
+static FILE *fp_io = NULL; // I/O Event File
+static char *fname_dump_active = NULL;
+static uint64_t uart_out = 0; // bytes by OUT
+static uint64_t uart_in  = 0; // bytes by IN
+static sIOTRACE replay_in;      // inputs by --replay
+static uint32_t replay_pos = 0; // events of replay_in taken
+static volatile int sim_running = 0; // in BFSIM_Run (stopped by Ctrl-C if Profiled)
+static double   run_time    = 0.0; // seconds in BFSIM_Run
+static uint64_t run_count   = 0;   // instructions run
+static double   super_time  = 0.0; // of the Profile Run read by --super
+static uint64_t super_count = 0;
+
+//----------------------------------
+// Report UART Time Estimate
+//     Time on the wire of the bytes
+//     by OUT and IN, at the Divider
+//     which bfRun sets for the Clock.
+//----------------------------------
+static void Sim_UART_Report(void)
+{
+    if (UART_EST == 0) return;
+    printf("\nUART Estimate: OUT %" PRIu64 " bytes, IN %" PRIu64 " bytes, %.3fs at %.0fbps (div0=%d div1=%d Error=%+.2f%%)\n",
+        uart_out, uart_in, BAUD_Time(&UART_DIV, (double)(uart_out + uart_in)),
+        UART_DIV.baud, UART_DIV.div0, UART_DIV.div1, UART_DIV.error);
+}
+
+//----------------------------------
+// Dump RAM to a Raw File
+//     Same layout as bfRun --dump,
+//     to be compared with cmp.
+//----------------------------------
+static void Sim_Dump_RAM(const unsigned char *ram, uint32_t size, char *fname)
+{
+    FILE *fp;
+    //
+    if ((fp = fopen(fname, "wb")) == NULL)
+    {
+        fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", fname);
+        exit(EXIT_FAILURE);
+    }
+    if (fwrite(ram, 1, size, fp) != size)
+    {
+        fprintf(stderr, "======== ERROR: Can't write \"%s\".\n", fname);
+        exit(EXIT_FAILURE);
+    }
+    fclose(fp);
+}
+
+//----------------------------------
+// Report Cycle Model Statistics
+//----------------------------------
+static void Sim_Cycle_Report(sCYCLE *psCYC)
+{
+    sCYCLE_STATE state;
+    uint64_t ic, dc;
+    //
+    CYCLE_Get_State(psCYC, &state);
+    ic = state.ic_hit + state.ic_miss;
+    dc = state.dc_hit + state.dc_miss;
+    printf("\nCycle Model: %" PRIu64 " cycles, %.6fs at %dHz, %" PRIu64 " instructions (CPI=%.2f)\n",
+        state.cycle, (double)state.cycle / CLK_FREQ, CLK_FREQ,
+        state.count, (state.count)? (double)state.cycle / state.count : 0.0);
+    printf("I-Cache Hit %.2f%%, D-Cache Hit %.2f%%, SRAM %" PRIu64 " bytes\n",
+        (ic)? 100.0 * state.ic_hit / ic : 0.0, (dc)? 100.0 * state.dc_hit / dc : 0.0, state.bus);
+}
+
+//----------------------------------
+// Names in the Profile
+//----------------------------------
+static const char *prof_op_name[BFSIM_PROF_OP_NUM] = {">", "+", ".", "[", "]", "[>]"};
+static const char *prof_loop_name[BFSIM_LOOP_NUM] = {"scan  [>]", "clear [-]", "mul   [->+<]", "other"};
+static const char *super_name[BFSIM_SUPER_NUM] = {"+>", ">+", "+]", ">]", ">[", "[-]", "[->+<]"};
+
+//----------------------------------
+// Percentage of Ops
+//----------------------------------
+static double Sim_Percent(uint64_t n, uint64_t ops)
+{
+    return (ops)? 100.0 * (double)n / (double)ops : 0.0;
+}
+
+//----------------------------------
+// Million Instructions per Second
+//----------------------------------
+static double Sim_MIPS(uint64_t count, double time)
+{
+    return (time > 0.0)? (double)count / time / 1.0e6 : 0.0;
+}
+
+//----------------------------------
+// Write the Profile File
+//     Op pairs and loop shapes for reading,
+//     then the lines read by --super.
+//----------------------------------
+static void Sim_Profile_Write(sBFSIM *psSIM, char *fname)
+{
+    FILE *fp;
+    sBFSIM_PROFILE prof;
+    uint64_t pair[BFSIM_PROF_OP_NUM][BFSIM_PROF_OP_NUM];
+    uint64_t best;
+    uint32_t from = 0, to = 0;
+    uint32_t i, j;
+    //
+    BFSIM_Get_Profile(psSIM, &prof);
+    if ((fp = fopen(fname, "w")) == NULL)
+    {
+        fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", fname);
+        exit(EXIT_FAILURE);
+    }
+    fprintf(fp, "// bfTool Profile\n");
+    fprintf(fp, "// %" PRIu64 " instructions, %" PRIu64 " ops in %.3fs (%.1f MIPS)\n",
+        run_count, prof.ops, run_time, Sim_MIPS(run_count, run_time));
+    //
+    // Op Pairs (most run first)
+    fprintf(fp, "//\n// Op Pairs : runs (%% of ops)\n");
+    memcpy(pair, prof.pair, sizeof(pair));
+    while(1)
+    {
+        best = 0;
+        for (i = 0; i < BFSIM_PROF_OP_NUM; i++)
+        {
+            for (j = 0; j < BFSIM_PROF_OP_NUM; j++)
+            {
+                if (pair[i][j] > best) {best = pair[i][j]; from = i; to = j;}
+            }
+        }
+        if (best == 0) break;
+        fprintf(fp, "//     %-3s %-3s : %14" PRIu64 " (%5.1f%%)\n",
+            prof_op_name[from], prof_op_name[to], best, Sim_Percent(best, prof.ops));
+        pair[from][to] = 0;
+    }
+    //
+    // Loop Shapes
+    fprintf(fp, "//\n// Loop Shapes : loops, BEGIN runs, END runs\n");
+    for (i = 0; i < BFSIM_LOOP_NUM; i++)
+    {
+        fprintf(fp, "//     %-12s : %6" PRIu64 " %14" PRIu64 " %14" PRIu64 "\n",
+            prof_loop_name[i], prof.loop_num[i], prof.loop_entry[i], prof.loop_iter[i]);
+    }
+    fprintf(fp, "//\n// Hottest Loops : ops inside (%% of ops)\n");
+    for (i = 0; i < prof.num_hot; i++)
+    {
+        fprintf(fp, "//     PC=0x%02x %-12s : %14" PRIu64 " (%5.1f%%)\n",
+            prof.hot_pc[i], prof_loop_name[prof.hot_shape[i]], prof.hot_ops[i], Sim_Percent(prof.hot_ops[i], prof.ops));
+    }
+    //
+    // Read by --super
+    fprintf(fp, "//\n// Superinstructions : ops saved at most (%% of ops)\n");
+    fprintf(fp, "instructions %" PRIu64 "\n", run_count);
+    fprintf(fp, "seconds %.6f\n", run_time);
+    fprintf(fp, "ops %" PRIu64 "\n", prof.ops);
+    for (i = 0; i < BFSIM_SUPER_NUM; i++)
+    {
+        fprintf(fp, "save %-6s %14" PRIu64 " // %5.1f%%\n", super_name[i], prof.save[i], Sim_Percent(prof.save[i], prof.ops));
+    }
+    fclose(fp);
+    printf("\nProfile: %" PRIu64 " instructions, %" PRIu64 " ops in %.3fs (%.1f MIPS), written to \"%s\"\n",
+        run_count, prof.ops, run_time, Sim_MIPS(run_count, run_time), fname);
+}
+
+//----------------------------------
+// Select Superinstructions from a Profile File
+//----------------------------------
+static uint32_t Sim_Super_Select(char *fname)
+{
+    FILE *fp;
+    char line[MAXLEN_LINE];
+    char key [MAXLEN_WORD];
+    char name[MAXLEN_WORD];
+    sBFSIM_PROFILE prof;
+    uint32_t mask;
+    int  i, ok;
+    //
+    if ((fp = fopen(fname, "r")) == NULL)
+    {
+        fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", fname);
+        exit(EXIT_FAILURE);
+    }
+    memset(&prof, 0, sizeof(prof));
+    while (fgets(line, sizeof(line), fp))
+    {
+        if ((sscanf(line, "%255s", key) != 1) || (strncmp(key, "//", 2) == 0)) continue;
+        ok = 0;
+        if (strcmp(key, "instructions") == 0) ok = (sscanf(line, "%*s %" SCNu64, &super_count) == 1);
+        if (strcmp(key, "seconds"     ) == 0) ok = (sscanf(line, "%*s %lf", &super_time) == 1);
+        if (strcmp(key, "ops"         ) == 0) ok = (sscanf(line, "%*s %" SCNu64, &prof.ops) == 1);
+        if ((strcmp(key, "save") == 0) && (sscanf(line, "%*s %255s", name) == 1))
+        {
+            for (i = 0; i < BFSIM_SUPER_NUM; i++)
+            {
+                if (strcmp(name, super_name[i]) == 0) ok = (sscanf(line, "%*s %*s %" SCNu64, &prof.save[i]) == 1);
+            }
+        }
+        if (ok == 0)
+        {
+            fprintf(stderr, "======== ERROR: Illegal Line in Profile \"%s\" : %s", fname, line);
+            exit(EXIT_FAILURE);
+        }
+    }
+    fclose(fp);
+    //
+    // Selection
+    mask = BFSIM_Select_Super(&prof, SUPER_MIN_PERMILLE);
+    printf("Superinstructions:");
+    for (i = 0; i < BFSIM_SUPER_NUM; i++)
+    {
+        if (mask & (1 << i)) printf(" %s (%.1f%%)", super_name[i], Sim_Percent(prof.save[i], prof.ops));
+    }
+    if (mask == 0) printf(" none saves %.1f%% of ops", SUPER_MIN_PERMILLE / 10.0);
+    printf("\n");
+    return mask;
+}
+
+//----------------------------------
+// Report the Profile, or the Speedup
+// by Superinstructions
+//----------------------------------
+static void Sim_Profile_Report(sBFSIM *psSIM)
+{
+    if (PROFILE_FILE) Sim_Profile_Write(psSIM, PROFILE_FILE);
+    if (SUPER_FILE)
+    {
+        printf("\nSuperinstructions: %" PRIu64 " instructions in %.3fs (%.1f MIPS), x%.2f of the Profile Run (%.1f MIPS)\n",
+            run_count, run_time, Sim_MIPS(run_count, run_time),
+            (Sim_MIPS(super_count, super_time) > 0.0)? Sim_MIPS(run_count, run_time) / Sim_MIPS(super_count, super_time) : 0.0,
+            Sim_MIPS(super_count, super_time));
+    }
+}
+
+//----------------------------------
+// Run the Machine, timed for the Profile
+//----------------------------------
+static int Sim_Run(sBFSIM *psSIM, uint64_t max_steps)
+{
+    sBFSIM_STATE before, after;
+    double start;
+    int  event;
+    //
+    BFSIM_Get_State(psSIM, &before);
+    start = Get_Time();
+    sim_running = 1;
+    event = BFSIM_Run(psSIM, max_steps);
+    sim_running = 0;
+    run_time = run_time + Get_Time() - start;
+    BFSIM_Get_State(psSIM, &after);
+    run_count = run_count + ((event == BFSIM_EV_RESET)? after.count_reset + 1 : after.count) - before.count;
+    return event;
+}
 
 //--------------------------------
 // Interrupt Hander for CTRL-C
 //--------------------------------
 void Interrupt_Handler(int dummy)
 {
+    sBFSIM_STATE state;
+    sCYCLE_STATE cycle;
+    unsigned char *ram;
+    uint32_t size;
+    uint32_t maxptr = 0;
+    //
+    // Stop into the Debugger if Recorded or Debugged,
+    // or stop the Run to report the Profile (Abort if again)
+    if (((psREC_ACTIVE) || ((DEBUGGER) && (psSIM_ACTIVE)) || ((sim_running) && ((PROFILE_FILE) || (SUPER_FILE))))
+     && (ctrl_c == 0))
+    {
+        ctrl_c = 1;
+        BFSIM_Stop(psSIM_ACTIVE);
+        return;
+    }
     ctrl_c = 1;
-    printf("\nAborted: MAXPTR=0x%04x(%d)\n", MAXPTR, MAXPTR);
+    if (psSIM_ACTIVE)
+    {
+        BFSIM_Get_State(psSIM_ACTIVE, &state);
+        maxptr = state.maxptr;
+        ram = BFSIM_Get_RAM(psSIM_ACTIVE, &size);
+        if (fname_dump_active) Sim_Dump_RAM(ram, size, fname_dump_active);
+        Sim_UART_Report();
+        Sim_Profile_Report(psSIM_ACTIVE);
+    }
+    if (psCYCLE_ACTIVE)
+    {
+        unsigned char buf[CYCLE_RAM_SIZE];
+        //
+        CYCLE_Get_State(psCYCLE_ACTIVE, &cycle);
+        if (fname_dump_active)
+        {
+            CYCLE_Get_RAM(psCYCLE_ACTIVE, buf);
+            Sim_Dump_RAM(buf, CYCLE_RAM_SIZE, fname_dump_active);
+        }
+        Sim_Cycle_Report(psCYCLE_ACTIVE);
+        IOCMP_Write_End(fp_io, cycle.cycle);
+        printf("\nAborted: CYCLE=%" PRIu64 "\n", cycle.cycle);
+        exit(EXIT_FAILURE);
+    }
+    printf("\nAborted: MAXPTR=0x%04x(%u)\n", maxptr, maxptr);
     exit(EXIT_FAILURE);
 }
 
 //----------------------------------
-// bfCPU Model
+// Output Instruction
 //----------------------------------
-void bfCPU_Model(FILE *fp, unsigned char *rom)
+static void Sim_Output(FILE *fp, uint32_t pc, uint32_t ptr, unsigned char data)
+{
+    if (ASCII == 0)
+    {
+        printf("PC=0x%02x ROM[0x%02x]=0x%1x (OUT  ) ", pc, pc, CODE_OUT);
+        printf("--> PTR=0x%02x RAM[0x%02x]=0x%02x OUTPUT=0x%02x(%3d)(%c)\n", ptr, ptr, data, data, data, data);
+        if (fp) fprintf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (OUT  ) ", pc, pc, CODE_OUT);
+        if (fp) fprintf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x OUTPUT=0x%02x(%3d)(%c)\n", ptr, ptr, data, data, data, data);
+    }
+    else
+    {
+        DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (OUT  ) ", pc, pc, CODE_OUT);
+        DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x OUTPUT=0x%02x(%3d)(%c)\n", ptr, ptr, data, data, data, data);
+        printf("%c", data);
+        if (VERBOSE) printf("\n");
+    }
+}
+
+//----------------------------------
+// Input Instruction
+//----------------------------------
+static unsigned char Sim_Input(uint32_t pc)
 {
-    int  i;
-    int  pc;
-    int  ptr;
-    int  count;
-    unsigned char code;
     unsigned char data;
+    //
+    // Inputs from the Replay File first
+    while (replay_pos < replay_in.count)
+    {
+        if (replay_in.event[replay_pos].dir != IOCMP_IN) {replay_pos++; continue;}
+        data = replay_in.event[replay_pos++].data;
+        if (ASCII == 0)
+        {
+            printf("PC=0x%02x ROM[0x%02x]=0x%1x (IN   ) ", pc, pc, CODE_IN);
+            printf("Input 8bit Hex Number? %02x\n", data);
+        }
+        return data;
+    }
+    //
+    if (ASCII == 0)
+    {
+        printf("PC=0x%02x ROM[0x%02x]=0x%1x (IN   ) ", pc, pc, CODE_IN);
+        printf("Input 8bit Hex Number? ");
+        while(1)
+        {
+            if (Get_Hex_from_STDIN(&data) == RESULT_OK) break;
+            if (ctrl_c) {data = 0; break;}
+        }
+    }
+    else
+    {
+        if (VERBOSE) printf("Input an ASCII Character? ");
+        while(1)
+        {
+            if (Get_ASCII_from_STDIN(&data) == RESULT_OK) break;
+            if (ctrl_c) {data = 0; break;}
+        }
+        if (VERBOSE) printf("\n");
+    }
+    return data;
+}
+
+//----------------------------------
+// Wait for Enter after Reset
+//----------------------------------
+static void Sim_Reset_Wait(void)
+{
+    printf("Hit Enter to Reset\n");
+    while(1)
+    {
+        int ch = getchar();
+        if ((ch == '\n') || (ch == '\r')) break;
+    }
+}
+
+//----------------------------------
+// Scan never ends (until Ctrl-C)
+//----------------------------------
+static void Sim_Hang(void)
+{
+    while (ctrl_c == 0)
+    {
+#if !defined(_WIN32)
+        pause();
+#endif
+    }
+}
+
+//----------------------------------
+// Trace each Instruction
+//     OUT and IN are completed by
+//     Sim_Output() and Sim_Input().
+//----------------------------------
+static void Sim_Trace(void *user, const sBFSIM_TRACE *psTRACE)
+{
+    FILE *fp = (FILE*)user;
+    const char *name;
+    uint32_t pc = psTRACE->pc;
+    uint32_t ptr = psTRACE->ptr;
+    unsigned char data = psTRACE->data;
+    //
+    // Input Data (Count was printed before the prompt)
+    if (psTRACE->code == CODE_IN)
+    {
+        DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (IN   ) ", pc, pc, CODE_IN);
+        DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x INPUT=0x%02x(%3d)(%c)\n", ptr, ptr, data, data, data, data);
+        return;
+    }
+    //
+    // Print Count
+    DUAL_printf(fp, "%05" PRIu64 " : ", psTRACE->count);
+    switch(psTRACE->code)
+    {
+        case CODE_PINC  : name = "P++  "; break;
+        case CODE_PDEC  : name = "P--  "; break;
+        case CODE_INC   : name = "INC  "; break;
+        case CODE_DEC   : name = "DEC  "; break;
+        case CODE_BEGIN : name = "BEGIN"; break;
+        case CODE_END   : name = "END  "; break;
+        case CODE_RESET : name = "RESET"; break;
+        case CODE_NOP   : name = "NOP  "; break;
+        default         : return; // OUT, Illegal
+    }
+    DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (%s) ", pc, pc, psTRACE->code, name);
+    DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x(%3d)\n", ptr, ptr, data, data);
+}
+
+//----------------------------------
+// Debugger State
+//----------------------------------
+typedef struct
+{
+    uint32_t brk[DEBUG_BRK_MAX];     // breakpoints set by p
+    uint32_t num_brk;
+    uint32_t watch[BFSIM_WATCH_MAX]; // watchpoints set by w
+    uint32_t num_watch;
+    int      out;       // break on OUT
+    uint32_t over;      // breakpoint of n (UINT32_MAX if none)
+    uint64_t step_to;   // index to stop at by s (0 if none)
+    uint64_t resume;    // index the run was resumed at
+    uint64_t base;      // index after the last RESET (not recorded)
+} sDEBUG;
+//
+static sDEBUG dbg;
+
+//----------------------------------
+// Current Instruction Index
+//     Counts from the start of the run
+//     across RESETs (RESET itself one).
+//----------------------------------
+static uint64_t Sim_Index(sBFSIM *psSIM, sREPLAY *psREC)
+{
+    sBFSIM_STATE state;
+    //
+    if (psREC) return REPLAY_Index(psREC);
+    BFSIM_Get_State(psSIM, &state);
+    return dbg.base + state.count;
+}
+
+//----------------------------------
+// Print the Position
+//----------------------------------
+static void Sim_Debug_State(sBFSIM *psSIM, sREPLAY *psREC)
+{
+    sBFSIM_STATE state;
+    unsigned char *ram;
+    uint32_t size;
+    //
+    BFSIM_Get_State(psSIM, &state);
+    ram = BFSIM_Get_RAM(psSIM, &size);
+    printf("#%" PRIu64 " : %05" PRIu64 " : PC=0x%02x ROM[0x%02x]=0x%1x PTR=0x%02x RAM[0x%02x]=0x%02x(%3d)\n",
+        Sim_Index(psSIM, psREC), state.count, state.pc, state.pc, state.code,
+        state.ptr, state.ptr, ram[state.ptr], ram[state.ptr]);
+}
+
+//----------------------------------
+// Print RAM around an Address
+//     The cell at PTR is marked by [].
+//----------------------------------
+static void Sim_Debug_RAM(sBFSIM *psSIM, uint64_t addr, uint64_t len)
+{
+    sBFSIM_STATE state;
     unsigned char *ram;
-    int  indent;
+    uint32_t size;
+    uint64_t i;
     //
-    // Allocate RAM
-    ram = (unsigned char*)malloc(sizeof(unsigned char) * MAXRAM);
-    if (ram == NULL)
+    BFSIM_Get_State(psSIM, &state);
+    ram = BFSIM_Get_RAM(psSIM, &size);
+    if (addr >= size) {printf("Address is beyond the RAM.\n"); return;}
+    if (len > size - addr) len = size - addr;
+    for (i = 0; i < len; i++)
     {
-        fprintf(stderr, "======== ERROR: Can't allocate RAM area.\n");
-        exit(EXIT_FAILURE);
+        if ((i == 0) || (((addr + i) & 0x0f) == 0)) printf("%s0x%04" PRIx64 " :", (i)? "\n" : "", addr + i);
+        printf((addr + i == state.ptr)? "[%02x]" : " %02x ", ram[addr + i]);
     }
+    printf("\n");
+}
+
+//----------------------------------
+// Toggle a Breakpoint
+//----------------------------------
+static void Sim_Debug_Break(sBFSIM *psSIM, uint32_t pc)
+{
+    uint32_t i;
     //
-    // Initialize Model
-    pc = 0;
-    ptr = 0;
-    count = 0;
-    MAXPTR = 0;
-    for (i = 0; i < MAXRAM; i++) ram[i] = 0x00;
+    for (i = 0; i < dbg.num_brk; i++)
+    {
+        if (dbg.brk[i] == pc) break;
+    }
+    if (i < dbg.num_brk)
+    {
+        dbg.brk[i] = dbg.brk[--dbg.num_brk];
+        if (pc != dbg.over) BFSIM_Set_Break(psSIM, pc, 0);
+        printf("Breakpoint at PC=0x%02x cleared.\n", pc);
+    }
+    else if ((dbg.num_brk == DEBUG_BRK_MAX) || (BFSIM_Set_Break(psSIM, pc, 1) != BFSIM_OK))
+    {
+        printf("Can't set a Breakpoint at PC=0x%02x.\n", pc);
+    }
+    else
+    {
+        dbg.brk[dbg.num_brk++] = pc;
+        printf("Breakpoint at PC=0x%02x set.\n", pc);
+    }
+}
+
+//----------------------------------
+// Toggle a Watchpoint
+//----------------------------------
+static void Sim_Debug_Watch(sBFSIM *psSIM, uint32_t addr)
+{
+    uint32_t i;
     //
-    // Run
-    while(1)
+    for (i = 0; i < dbg.num_watch; i++)
     {
-        // Fetch
-        code = rom[pc];
-        //
-        // Print Count
-        DUAL_printf(fp, "%05d : ", count);
-        //
-        // Decode and Exec
-        switch(code)
+        if (dbg.watch[i] == addr) break;
+    }
+    if (i < dbg.num_watch)
+    {
+        dbg.watch[i] = dbg.watch[--dbg.num_watch];
+        BFSIM_Set_Watch(psSIM, addr, 0);
+        printf("Watchpoint at RAM[0x%02x] cleared.\n", addr);
+    }
+    else if (BFSIM_Set_Watch(psSIM, addr, 1) != BFSIM_OK)
+    {
+        printf("Can't set a Watchpoint at RAM[0x%02x].\n", addr);
+    }
+    else
+    {
+        dbg.watch[dbg.num_watch++] = addr;
+        printf("Watchpoint at RAM[0x%02x] set.\n", addr);
+    }
+}
+
+//----------------------------------
+// Clear the Breakpoint of Step Over
+//----------------------------------
+static void Sim_Debug_Over_Clear(sBFSIM *psSIM)
+{
+    uint32_t i;
+    //
+    if (dbg.over == UINT32_MAX) return;
+    for (i = 0; i < dbg.num_brk; i++)
+    {
+        if (dbg.brk[i] == dbg.over) break;
+    }
+    if (i == dbg.num_brk) BFSIM_Set_Break(psSIM, dbg.over, 0);
+    dbg.over = UINT32_MAX;
+}
+
+//----------------------------------
+// Step over a Loop
+//     At a BEGIN, a breakpoint is put next
+//     to the matching END. Returns 0 if the
+//     current instruction is not a BEGIN.
+//----------------------------------
+static int Sim_Debug_Over(sBFSIM *psSIM, const unsigned char *rom)
+{
+    sBFSIM_STATE state;
+    uint32_t pc;
+    int  depth = 0;
+    //
+    BFSIM_Get_State(psSIM, &state);
+    if (rom[state.pc] != CODE_BEGIN) return 0;
+    for (pc = state.pc; pc < MAXROM; pc++)
+    {
+        if (rom[pc] == CODE_BEGIN) depth++;
+        if ((rom[pc] == CODE_END) && (--depth == 0)) break;
+    }
+    if (pc == MAXROM)
+    {
+        printf("No matching END.\n");
+        return 0;
+    }
+    dbg.over = (pc == MAXROM - 1)? 0 : pc + 1;
+    BFSIM_Set_Break(psSIM, dbg.over, 1);
+    return 1;
+}
+
+//----------------------------------
+// Debugger Prompt
+//     s [N]          : step N instructions (1)
+//     n              : step over a loop at BEGIN
+//     c              : continue
+//     b [N]          : back N instructions (1) *
+//     g INDEX        : go to an instruction index *
+//     p [PC]         : toggle a breakpoint (list)
+//     w [ADDR]       : toggle a watchpoint (list)
+//     o              : toggle break on OUT
+//     m [ADDR [LEN]] : print RAM (around PTR)
+//     q              : quit
+//     * Recorded runs only. s, g and c move in
+//       the history until its end.
+//     Returns 1 to continue the run.
+//----------------------------------
+static int Sim_Debug(sBFSIM *psSIM, sREPLAY *psREC, const unsigned char *rom)
+{
+    char line[MAXLEN_LINE];
+    char cmd;
+    long long arg1, arg2;
+    sBFSIM_STATE state;
+    uint64_t index;
+    uint32_t i;
+    int  n, event;
+    //
+    BFSIM_Cancel_Stop(psSIM);
+    Sim_Debug_Over_Clear(psSIM);
+    dbg.step_to = 0;
+    if (psREC)
+    {
+        psREC->end = REPLAY_Index(psREC);
+        printf("\nHistory : #0-#%" PRIu64 ", %u Snapshots every %" PRIu64 " instructions (%.1fMB, %.1f%% of Run Time)\n",
+            psREC->end, psREC->num_snap, psREC->interval, (double)psREC->bytes / (1 << 20),
+            (psREC->time_run > 0)? psREC->time_snap * 100.0 / psREC->time_run : 0.0);
+    }
+    Sim_Debug_State(psSIM, psREC);
+    while (1)
+    {
+        printf("Debug (s [N], n, c, b [N], g IDX, p [PC], w [ADR], o, m [ADR [LEN]], q)? ");
+        fflush(stdout);
+        if (fgets(line, MAXLEN_LINE, stdin) == NULL) return 0;
+        n = sscanf(line, " %c %lli %lli", &cmd, &arg1, &arg2);
+        if (n < 1) continue;
+        if (((n >= 2) && (arg1 < 0)) || ((n >= 3) && (arg2 < 0)))
         {
-            // CODE_PINC     0
-            case CODE_PINC :
-            {
-                DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (P++  ) ", pc, pc, code);
-                ptr = INC_PTR(ptr);
-                MAXPTR = (ptr > MAXPTR)? ptr : MAXPTR;
-                DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x(%3d)\n", ptr, ptr, ram[ptr], ram[ptr]);
-                pc = INC_PC(pc);
-                break;
-            }
-            // CODE_PDEC     1
-            case CODE_PDEC :
+            printf("Negative Number.\n");
+            continue;
+        }
+        index = Sim_Index(psSIM, psREC);
+        BFSIM_Get_State(psSIM, &state);
+        switch(cmd)
+        {
+            case 'q' : return 0;
+            case 'p' :
             {
-                DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (P--  ) ", pc, pc, code);
-                ptr = DEC_PTR(ptr); 
-                DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x(%3d)\n", ptr, ptr, ram[ptr], ram[ptr]);
-                pc = INC_PC(pc);
-                break;
+                if (n >= 2) {Sim_Debug_Break(psSIM, (uint32_t)arg1); continue;}
+                for (i = 0; i < dbg.num_brk; i++) printf("Breakpoint at PC=0x%02x\n", dbg.brk[i]);
+                continue;
             }
-            // CODE_INC      2
-            case CODE_INC :
+            case 'w' :
             {
-                DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (INC  ) ", pc, pc, code);
-                ram[ptr] = ram[ptr] + 1;
-                DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x(%3d)\n", ptr, ptr, ram[ptr],ram[ptr]);
-                pc = INC_PC(pc);
-                break;
+                if (n >= 2) {Sim_Debug_Watch(psSIM, (uint32_t)arg1); continue;}
+                for (i = 0; i < dbg.num_watch; i++) printf("Watchpoint at RAM[0x%02x]\n", dbg.watch[i]);
+                continue;
             }
-            // CODE_DEC      3
-            case CODE_DEC :
+            case 'o' :
             {
-                DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (DEC  ) ", pc, pc, code);
-                ram[ptr] = ram[ptr] - 1;
-                DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x(%3d)\n", ptr, ptr, ram[ptr], ram[ptr]);
-                pc = INC_PC(pc);
-                break;
+                dbg.out = !dbg.out;
+                printf("Break on OUT %s.\n", (dbg.out)? "set" : "cleared");
+                continue;
             }
-            // CODE_OUT      4
-            case CODE_OUT :
+            case 'm' :
             {
-                if (ASCII == 0)
-                {
-                    printf("PC=0x%02x ROM[0x%02x]=0x%1x (OUT  ) ", pc, pc, code);
-                    printf("--> PTR=0x%02x RAM[0x%02x]=0x%02x OUTPUT=0x%02x(%3d)(%c)\n", ptr, ptr, ram[ptr], ram[ptr], ram[ptr], ram[ptr]);
-                    if (fp) fprintf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (OUT  ) ", pc, pc, code);
-                    if (fp) fprintf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x OUTPUT=0x%02x(%3d)(%c)\n", ptr, ptr, ram[ptr], ram[ptr], ram[ptr], ram[ptr]);
-                }
-                else
-                {
-                    DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (OUT  ) ", pc, pc, code);
-                    DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x OUTPUT=0x%02x(%3d)(%c)\n", ptr, ptr, ram[ptr], ram[ptr], ram[ptr], ram[ptr]);
-                    printf("%c", ram[ptr]);
-                    if (VERBOSE) printf("\n");
-                }
-                pc = INC_PC(pc);
-                break;
+                if (n < 2) arg1 = (state.ptr < 0x20)? 0 : (state.ptr & ~0x0f) - 0x10;
+                if (n < 3) arg2 = 0x40;
+                Sim_Debug_RAM(psSIM, (uint64_t)arg1, (uint64_t)arg2);
+                continue;
             }
-            // CODE_IN       5
-            case CODE_IN :
+            case 's' :
+            case 'n' :
+            case 'c' :
+            case 'b' :
+            case 'g' : break;
+            default  :
             {
-                if (ASCII == 0)
-                {
-                    printf("PC=0x%02x ROM[0x%02x]=0x%1x (IN   ) ", pc, pc, code);
-                    printf("Input 8bit Hex Number? ");
-                    while(1)
-                    {
-                        if (Get_Hex_from_STDIN(&data) == RESULT_OK) break;
-                        if (ctrl_c) {data = 0; break;}
-                    }
-                    ram[ptr] = data;
-                }
-                else
-                {
-                    if (VERBOSE) printf("Input an ASCII Character? ");
-                    while(1)
-                    {
-                        if (Get_ASCII_from_STDIN(&data) == RESULT_OK) break;
-                        if (ctrl_c) {data = 0; break;}
-                    }
-                    ram[ptr] = data;
-                    if (VERBOSE) printf("\n");
-                }
-                //
-                DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (IN   ) ", pc, pc, code);
-                DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x INPUT=0x%02x(%3d)(%c)\n", ptr, ptr, ram[ptr], ram[ptr], data, data);
-                pc = INC_PC(pc);
-                break;
+                printf("Unknown Command \"%c\".\n", cmd);
+                continue;
             }
-            // CODE_BEGIN    6
-            case CODE_BEGIN :
-            {
-                DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (BEGIN) ", pc, pc, code);
-                DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x(%3d)\n", ptr, ptr, ram[ptr], ram[ptr]);
-                if (ram[ptr] == 0)
-                {
-                    indent = 0;
-                    pc = INC_PC(pc);
-                    while(1)
-                    {
-                        code = rom[pc];
-                             if ((indent == 0) && (code == CODE_END)) {pc = INC_PC(pc); break;}
-                        else if ((indent >  0) && (code == CODE_END)) {pc = INC_PC(pc); indent--;}
-                        else if (code == CODE_BEGIN) {pc = INC_PC(pc); indent++;}
-                        else pc = INC_PC(pc);
-                        if (ctrl_c) break;
-                    }
-                }
-                else
-                {
-                    pc = INC_PC(pc);
-                }
-                break;
-            }
-            // CODE_END      7
-            case CODE_END :
-            {
-                DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (END  ) ", pc, pc, code);
-                DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x(%3d)\n", ptr, ptr, ram[ptr], ram[ptr]);
-                if (ram[ptr] != 0)
-                {
-                    indent = 0;
-                    pc = DEC_PC(pc);
-                    while(1)
-                    {
-                        code = rom[pc];
-                             if ((indent == 0) && (code == CODE_BEGIN)) {pc = INC_PC(pc); break;}
-                        else if ((indent >  0) && (code == CODE_BEGIN)) {pc = DEC_PC(pc); indent--;}
-                        else if (code == CODE_END) {pc = DEC_PC(pc); indent++;}
-                        else pc = DEC_PC(pc);
-                        if (ctrl_c) break;
-                    }
-                }
-                else
-                {
-                    pc = INC_PC(pc);
-                }
-                break;
-            }
-            // CODE_RESET    8
-            case CODE_RESET :
+        }
+        //
+        // Move in the History
+        if ((psREC) && ((index < psREC->end) || (cmd == 'b') || (cmd == 'g')))
+        {
+            if (n < 2) arg1 = 1;
+            switch(cmd)
             {
-                DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (RESET) ", pc, pc, code);
-                DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x(%3d)\n", ptr, ptr, ram[ptr], ram[ptr]);
-                pc = 0;
-                ptr = 0;
-                for (i = 0; i < MAXRAM; i++) ram[i] = 0x00;
-                printf("Hit Enter to Reset\n");
-                while(1)
+                case 'b' : index = ((uint64_t)arg1 < index)? index - arg1 : 0; break;
+                case 's' : index = ((uint64_t)arg1 < psREC->end - index)? index + arg1 : psREC->end; break;
+                case 'g' : index = (n >= 2)? (uint64_t)arg1 : index; break;
+                case 'c' : index = psREC->end; break;
+                default  :
                 {
-                    int ch = getchar();
-                    if ((ch == '\n') || (ch == '\r')) break;
+                    printf("Step over is not available in the History.\n");
+                    continue;
                 }
-                break;
             }
-            // CODE_NOP     15
-            case CODE_NOP :
+            if (index > psREC->end)
             {
-                DUAL_printf(fp, "PC=0x%02x ROM[0x%02x]=0x%1x (NOP  ) ", pc, pc, code);
-                DUAL_printf(fp, "--> PTR=0x%02x RAM[0x%02x]=0x%02x(%3d)\n", ptr, ptr, ram[ptr], ram[ptr]);
-                pc = INC_PC(pc);
-                break;
+                printf("Index is beyond the End #%" PRIu64 ".\n", psREC->end);
+                continue;
             }
-            // Never Reach Here
-            default :
+            event = REPLAY_Goto(psREC, index);
+            if ((event != BFSIM_EV_LIMIT) && (REPLAY_Index(psREC) != index)) printf("Replay stopped before #%" PRIu64 ".\n", index);
+            dbg.resume = index;
+            if (cmd == 'c') return 1;
+            Sim_Debug_State(psSIM, psREC);
+            continue;
+        }
+        if ((cmd == 'b') || (cmd == 'g'))
+        {
+            printf("No History (--record).\n");
+            continue;
+        }
+        //
+        // Resume the Run
+        if ((cmd == 'n') && (Sim_Debug_Over(psSIM, rom) == 0)) {cmd = 's'; n = 1;}
+        if (cmd == 's') dbg.step_to = index + (((n < 2) || (arg1 == 0))? 1 : (uint64_t)arg1);
+        dbg.resume = index;
+        return 1;
+    }
+}
+
+//----------------------------------
+// bfCPU Model
+//----------------------------------
+void bfCPU_Model(FILE *fp, unsigned char *rom, sOBJINFO *psOBJ, char *fname_dump)
+{
+    sBFSIM *psSIM;
+    sBFSIM_CONFIG config;
+    sBFSIM_STATE state;
+    sREPLAY *psREC = NULL;
+    unsigned char *ram;
+    uint32_t size;
+    uint64_t index;
+    int  event;
+    int  stop;
+    int  aborted;
+    //
+    // Create Machine
+    config.rom_size  = MAXROM;
+    config.ram_size  = MAXRAM;
+    config.entry     = psOBJ->entry;
+    config.data      = psOBJ->data;
+    config.data_addr = psOBJ->data_addr;
+    config.data_size = psOBJ->data_size;
+    psSIM = BFSIM_Create(rom, &config);
+    if (psSIM == NULL)
+    {
+        fprintf(stderr, "======== ERROR: Can't allocate RAM area.\n");
+        exit(EXIT_FAILURE);
+    }
+    //
+    // Trace only if Logged (Fast Model otherwise)
+    if ((VERBOSE) || (fp)) BFSIM_Set_Trace(psSIM, Sim_Trace, fp);
+    //
+    // Profile the Run, or fuse Superinstructions by a Profile
+    if ((PROFILE_FILE) && (BFSIM_Set_Profile(psSIM, 1) != BFSIM_OK))
+    {
+        fprintf(stderr, "======== ERROR: Can't allocate Profile area.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (SUPER_FILE) BFSIM_Set_Super(psSIM, Sim_Super_Select(SUPER_FILE));
+    psSIM_ACTIVE = psSIM;
+    fname_dump_active = fname_dump;
+    //
+    // Record the Run
+    if (RECORD)
+    {
+        psREC = REPLAY_Create(psSIM, RECORD);
+        if (psREC == NULL)
+        {
+            fprintf(stderr, "======== ERROR: Can't allocate Snapshot area.\n");
+            exit(EXIT_FAILURE);
+        }
+        psREC_ACTIVE = psREC;
+    }
+    //
+    // Debugger
+    memset(&dbg, 0, sizeof(sDEBUG));
+    dbg.over = UINT32_MAX;
+    stop = DEBUGGER;
+    //
+    // Run
+    while(1)
+    {
+        // Ctrl-C or Debugger Stop ?
+        if ((ctrl_c) || (stop))
+        {
+            if ((psREC == NULL) && (DEBUGGER == 0)) break;
+            BFSIM_Set_Trace(psSIM, NULL, NULL);
+            if (Sim_Debug(psSIM, psREC, rom) == 0) break;
+            if ((VERBOSE) || (fp)) BFSIM_Set_Trace(psSIM, Sim_Trace, fp);
+            ctrl_c = 0;
+            stop = 0;
+        }
+        //
+        index = (dbg.step_to)? Sim_Index(psSIM, psREC) : 0;
+        event = Sim_Run(psSIM, (dbg.step_to > index)? dbg.step_to - index : 0);
+        BFSIM_Get_State(psSIM, &state);
+        if (event == BFSIM_EV_OUT)
+        {
+            Sim_Output(fp, state.event_pc, state.ptr, state.data);
+            IOCMP_Write(fp_io, IOCMP_OUT, state.data, IOCMP_NO_CYCLE);
+            uart_out++;
+            stop = dbg.out;
+            if ((stop) && (ASCII)) printf("\n");
+        }
+        else if (event == BFSIM_EV_IN)
+        {
+            unsigned char data;
+            //
+            DUAL_printf(fp, "%05" PRIu64 " : ", state.count);
+            data = Sim_Input(state.pc);
+            if ((ctrl_c == 0) || ((psREC == NULL) && (DEBUGGER == 0))) // not taken if stopped into the Debugger
             {
-                fprintf(stderr, "======== ERROR: Illegal Code PC=0x%02x Code=0x%1x\n", pc, code);
-                exit(EXIT_FAILURE);
-                break;
+                BFSIM_Feed_Input(psSIM, data);
+                IOCMP_Write(fp_io, IOCMP_IN, data, IOCMP_NO_CYCLE);
+                uart_in++;
+                if (psREC) REPLAY_Input(psREC, data);
             }
         }
-        // Increment or Clear Count
-        count = (code == CODE_RESET)? 0 : count + 1;
-        //
-        // Ctrl-C ?
-        if (ctrl_c) break;
+        else if (event == BFSIM_EV_RESET)
+        {
+            if (psREC) REPLAY_Reset(psREC);
+            else dbg.base = dbg.base + state.count_reset + 1; // RESET counted
+            Sim_Reset_Wait();
+        }
+        else if (event == BFSIM_EV_HANG)
+        {
+            Sim_Hang();
+        }
+        else if (event == BFSIM_EV_ILLEGAL)
+        {
+            fprintf(stderr, "======== ERROR: Illegal Code PC=0x%02x Code=0x%1x\n", state.pc, state.code);
+            exit(EXIT_FAILURE);
+        }
+        else if (event == BFSIM_EV_LIMIT)
+        {
+            if (psREC) REPLAY_Limit(psREC);
+            stop = (dbg.step_to) && (Sim_Index(psSIM, psREC) >= dbg.step_to);
+        }
+        else if (event == BFSIM_EV_BREAK)
+        {
+            // Not again where the Run was resumed from the History
+            stop = (Sim_Index(psSIM, psREC) != dbg.resume);
+            if ((stop) && (state.event_pc != dbg.over)) printf("\nBreakpoint at PC=0x%02x\n", state.event_pc);
+        }
+        else if (event == BFSIM_EV_WATCH)
+        {
+            ram = BFSIM_Get_RAM(psSIM, &size);
+            printf("\nWatchpoint at RAM[0x%02x] : 0x%02x --> 0x%02x by PC=0x%02x\n",
+                state.ptr, state.data, ram[state.ptr], state.event_pc);
+            stop = 1;
+        }
+        else if ((event == BFSIM_EV_STOP) && (psREC == NULL) && (DEBUGGER == 0))
+        {
+            break;
+        }
     }
+    aborted = (ctrl_c) && (psREC == NULL) && (DEBUGGER == 0); // stopped to report the Profile
     ctrl_c = 0;
+    psSIM_ACTIVE = NULL;
+    psREC_ACTIVE = NULL;
+    fname_dump_active = NULL;
+    REPLAY_Destroy(psREC);
+    //
+    // Dump RAM
+    if (fname_dump)
+    {
+        unsigned char *ram;
+        uint32_t size;
+        //
+        ram = BFSIM_Get_RAM(psSIM, &size);
+        Sim_Dump_RAM(ram, size, fname_dump);
+    }
+    Sim_UART_Report();
+    Sim_Profile_Report(psSIM);
+    if (aborted)
+    {
+        BFSIM_Get_State(psSIM, &state);
+        printf("\nAborted: MAXPTR=0x%04x(%u)\n", state.maxptr, state.maxptr);
+        exit(EXIT_FAILURE);
+    }
+    BFSIM_Destroy(psSIM);
 }
 
 //----------------------------------
-// Read Hex File
+// Print a Sweep Result
 //----------------------------------
-void Read_Hex_File(unsigned char *rom, char *obj_str)
+static void Sweep_Print(FILE *fp, const unsigned char *input, const sBFSIM_LANE *psLANE)
 {
-    char *pline;
-    int  bytecount;
-    int  checksum;
-    int  checksum2;
-    int  addr;
-    int  addr_bgn;
-    int  data;
-    int  error;
-    char str[MAXLEN_WORD];
+    uint32_t i, num;
     //
-    // Clear ROM
-    for (addr = 0; addr < MAXROM; addr++) rom[addr] = CODE_NOP;
+    fprintf(fp, "IN=");
+    for (i = 0; i < (uint32_t)SWEEP_IN; i++) fprintf(fp, "%s%02x", (i)? "," : "", input[i]);
+    if (psLANE->event == BFSIM_EV_LIMIT)
+    {
+        fprintf(fp, " LIMIT\n");
+        return;
+    }
+    fprintf(fp, " OUT=");
+    num = (psLANE->num_out < BFSIM_LANE_OUT)? psLANE->num_out : BFSIM_LANE_OUT;
+    for (i = 0; i < num; i++) fprintf(fp, "%s%02x", (i)? "," : "", psLANE->out[i]);
+    if (psLANE->num_out > num) fprintf(fp, ",+%u", psLANE->num_out - num);
+    fprintf(fp, " %s STEPS=%" PRIu64 "\n",
+        (psLANE->event == BFSIM_EV_RESET)? "RESET" : (psLANE->event == BFSIM_EV_IN)? "IN" : "ILLEGAL",
+        psLANE->count);
+}
+
+//----------------------------------
+// Sweep One Input by bfCPU Model
+//     Same stops as a lane, HANG is
+//     reported as LIMIT.
+//----------------------------------
+static void Sweep_One(sBFSIM *psSIM, const unsigned char *input, sBFSIM_LANE *psLANE)
+{
+    sBFSIM_STATE state;
+    uint32_t num_in = 0;
+    int  event;
     //
-    // Read Intel Hex Format
-    error = 0;
-    pline = obj_str;
+    BFSIM_Restart(psSIM);
+    psLANE->num_out = 0;
     while(1)
     {
-        // Start Code
-        if (*pline++ != ':') {error = 1; break;}
-        // Byte Count
-        str[0] = *pline++;
-        str[1] = *pline++;
-        str[2] = '\0';
-        if (sscanf(str, "%02X", (int*)&bytecount) == EOF) {error = 1; break;}
-        checksum = bytecount;
-        // Address
-        str[0] = *pline++;
-        str[1] = *pline++;
-        str[2] = *pline++;
-        str[3] = *pline++;
-        str[4] = '\0';
-        if (sscanf(str, "%04X", (int*)&addr_bgn) == EOF) {error = 1; break;}
-        checksum = checksum + (addr_bgn >> 8) + (addr_bgn & 0x00ff);
-        // Record Type
-        str[0] = *pline++;
-        str[1] = *pline++;
-        str[2] = '\0';
-        if (strcmp(str, "01") == 0) break; // End of Record
-        if (strcmp(str, "00") != 0) {error = 1; break;} // Unsupported Record
-        // Data Record
-        for (addr = addr_bgn; addr < (addr_bgn + bytecount); addr++)
-        {
-            str[0] = *pline++;
-            str[1] = *pline++;
-            str[2] = '\0';
-            if (sscanf(str, "%02X", (int*)&data) == EOF) {error = 1; break;}
-            if ((addr * 2 + 1) >= MAXROM) {error = 2; break;}
-            rom[addr * 2 + 0] = (data >> 0) & 0x0f;
-            rom[addr * 2 + 1] = (data >> 4) & 0x0f;
-            checksum = checksum + data;
-        }
-        if (error) break;
-        // Check Sum        
-        str[0] = *pline++;
-        str[1] = *pline++;
-        str[2] = '\0';
-        if (sscanf(str, "%02X", (int*)&checksum2) == EOF) {error = 1; break;}
-        checksum = (0 - checksum) & 0x00ff;
-        if (checksum != checksum2) {error = 3; break;}
-        // End of Line
-        while(1)
+        event = BFSIM_Run(psSIM, 0);
+        BFSIM_Get_State(psSIM, &state);
+        if (event == BFSIM_EV_OUT)
+        {
+            if (psLANE->num_out < BFSIM_LANE_OUT) psLANE->out[psLANE->num_out] = state.data;
+            psLANE->num_out++;
+            continue;
+        }
+        if ((event == BFSIM_EV_IN) && (num_in < (uint32_t)SWEEP_IN))
+        {
+            BFSIM_Feed_Input(psSIM, input[num_in++]);
+            continue;
+        }
+        psLANE->event = (event == BFSIM_EV_HANG)? BFSIM_EV_LIMIT : event;
+        psLANE->count = (event == BFSIM_EV_RESET)? state.count_reset : state.count;
+        break;
+    }
+}
+
+//----------------------------------
+// Input Sweep
+//     Runs the program for all values of the
+//     first SWEEP_IN bytes taken by IN, on
+//     SWEEP_WIDTH lanes at once (1: one by one
+//     by the bfCPU Model).
+//----------------------------------
+static void Sweep_Model(FILE *fp, unsigned char *rom, sOBJINFO *psOBJ)
+{
+    sBFSIM_CONFIG config;
+    sBFSIM_LANE lane;
+    sBFLANES *psLANES = NULL;
+    sBFSIM   *psSIM = NULL;
+    unsigned char *input;
+    uint64_t total, base;
+    uint64_t steps = 0;
+    uint64_t stops[BFSIM_EV_HANG + 1] = {0};
+    uint32_t lanes, l, k;
+    double   start;
+    //
+    // Create Lanes
+    config.rom_size  = MAXROM;
+    config.ram_size  = MAXRAM;
+    config.entry     = psOBJ->entry;
+    config.data      = psOBJ->data;
+    config.data_addr = psOBJ->data_addr;
+    config.data_size = psOBJ->data_size;
+    total = 1ULL << (8 * SWEEP_IN);
+    lanes = (SWEEP_WIDTH < total)? SWEEP_WIDTH : (uint32_t)total;
+    if (lanes > 1)
+    {
+        psLANES = BFSIM_Lanes_Create(rom, &config, lanes);
+        if (psLANES == NULL) printf("Lanes are not available for this program, run one by one.\n");
+    }
+    if (psLANES == NULL)
+    {
+        lanes = 1;
+        psSIM = BFSIM_Create(rom, &config);
+        if (psSIM == NULL)
         {
-                 if (*pline == '\n') pline++;
-            else if (*pline == '\r') pline++;
-            else                     break;
+            fprintf(stderr, "======== ERROR: Can't allocate RAM area.\n");
+            exit(EXIT_FAILURE);
         }
-        // End of String
-        if (*pline == '\0') break;
+        BFSIM_Set_Limit(psSIM, SWEEP_MAX_STEPS);
     }
-    if (error == 1)
+    input = (unsigned char*)malloc((size_t)lanes * SWEEP_IN);
+    if (input == NULL)
     {
-        fprintf(stderr, "======== ERROR: Hex File Format Error\n");
+        fprintf(stderr, "======== ERROR: Can't allocate Input area.\n");
         exit(EXIT_FAILURE);
     }
-    if (error == 2)
+    //
+    // Run each Batch (first IN changes fastest, it often counts an outer loop)
+    start = Get_Time();
+    for (base = 0; base < total; base = base + lanes)
     {
-        fprintf(stderr, "======== ERROR: Hex File Overflows ROM Size\n");
+        for (l = 0; l < lanes; l++)
+        {
+            for (k = 0; k < (uint32_t)SWEEP_IN; k++)
+                input[l * SWEEP_IN + k] = (unsigned char)((base + l) >> (8 * k));
+        }
+        if (psLANES) BFSIM_Lanes_Run(psLANES, input, SWEEP_IN, SWEEP_MAX_STEPS);
+        for (l = 0; (l < lanes) && (base + l < total); l++)
+        {
+            if (psLANES) BFSIM_Lanes_Get(psLANES, l, &lane);
+            else Sweep_One(psSIM, input + l * SWEEP_IN, &lane);
+            Sweep_Print((fp)? fp : stdout, input + l * SWEEP_IN, &lane);
+            stops[lane.event]++;
+            if (lane.event != BFSIM_EV_LIMIT) steps = steps + lane.count;
+        }
+    }
+    //
+    // Summary
+    printf("Sweep: %" PRIu64 " inputs by %u lane%s, RESET %" PRIu64 ", IN %" PRIu64 ", ILLEGAL %" PRIu64 ", LIMIT %" PRIu64 "\n",
+        total, lanes, (lanes > 1)? "s" : "",
+        stops[BFSIM_EV_RESET], stops[BFSIM_EV_IN], stops[BFSIM_EV_ILLEGAL], stops[BFSIM_EV_LIMIT]);
+    printf("       %" PRIu64 " steps in %.3fs\n", steps, Get_Time() - start);
+    free(input);
+    BFSIM_Lanes_Destroy(psLANES);
+    BFSIM_Destroy(psSIM);
+}
+
+//----------------------------------
+// Fuzzing by bfCPU Model
+//----------------------------------
+static void Fuzz_Model(unsigned char *rom, sOBJINFO *psOBJ)
+{
+    sBFSIM_CONFIG config;
+    //
+    config.rom_size  = MAXROM;
+    config.ram_size  = MAXRAM;
+    config.entry     = psOBJ->entry;
+    config.data      = psOBJ->data;
+    config.data_addr = psOBJ->data_addr;
+    config.data_size = psOBJ->data_size;
+    Do_Fuzz(rom, &config);
+}
+
+//----------------------------------
+// Build SRAM Image for Cycle Model
+//     FPGA   : same as bfRun writes
+//     tb_TOP : same as tb.sv loads
+//----------------------------------
+static void Cycle_SRAM_Image(unsigned char *sram, unsigned char *rom, sOBJINFO *psOBJ)
+{
+    sBAUD baud;
+    uint32_t addr;
+    //
+    if (CYCLE_SIM == CYCLE_TB)
+    {
+        for (addr = 0; addr < CYCLE_SRAM_SIZE; addr++) sram[addr] = (unsigned char)addr;
+        for (addr = 0; addr < psOBJ->code_size; addr++) sram[addr] = rom[addr * 2] | (rom[addr * 2 + 1] << 4);
+        sram[CYCLE_RAM_SIZE + 0x1e] = 0x02; // DIV0
+        sram[CYCLE_RAM_SIZE + 0x1f] = 0x02; // DIV1
+        return;
+    }
+    //
+    // Code, Data Preload and Baud Rate at the top of RAM
+    memset(sram, 0x00, CYCLE_SRAM_SIZE);
+    for (addr = 0; addr < CYCLE_RAM_SIZE; addr++) sram[addr] = rom[addr * 2] | (rom[addr * 2 + 1] << 4);
+    if (psOBJ->entry != 0) fprintf(stderr, "Entry Point 0x%04x is ignored, bfCPU starts from 0x0000.\n", psOBJ->entry);
+    if ((uint64_t)psOBJ->data_addr + psOBJ->data_size > (uint64_t)(CYCLE_RAM_SIZE - 2))
+    {
+        fprintf(stderr, "======== ERROR: Data Preload Overlaps Baud Rate Setting\n");
         exit(EXIT_FAILURE);
     }
-    if (error == 3)
+    if (psOBJ->data) memcpy(sram + CYCLE_RAM_SIZE + psOBJ->data_addr, psOBJ->data, psOBJ->data_size);
+    if (UART_EST) baud = UART_DIV;
+    else BAUD_Search((double)CLKFREQ_DEFAULT, (double)UART_BAUD_DEFAULT, &baud);
+    sram[CYCLE_SRAM_SIZE - 2] = (unsigned char)baud.div0;
+    sram[CYCLE_SRAM_SIZE - 1] = (unsigned char)baud.div1;
+}
+
+//----------------------------------
+// Cycle Model of bfCPU System
+//----------------------------------
+static void Cycle_Model(FILE *fp, unsigned char *rom, sOBJINFO *psOBJ, char *fname_dump)
+{
+    sCYCLE *psCYC;
+    sCYCLE_STATE state;
+    unsigned char *sram;
+    int  event;
+    //
+    // Create System
+    sram = (unsigned char*)malloc(CYCLE_SRAM_SIZE);
+    if (sram == NULL)
     {
-        fprintf(stderr, "======== ERROR: Hex File Check Sum Unmatched\n");
+        fprintf(stderr, "======== ERROR: Can't allocate SRAM area.\n");
         exit(EXIT_FAILURE);
     }
+    Cycle_SRAM_Image(sram, rom, psOBJ);
+    psCYC = CYCLE_Create(sram, (CYCLE_SIM == CYCLE_TB)? CYCLE_MODE_TB : CYCLE_MODE_HW);
+    free(sram);
+    if (psCYC == NULL)
+    {
+        fprintf(stderr, "======== ERROR: Can't allocate SRAM area.\n");
+        exit(EXIT_FAILURE);
+    }
+    //
+    // Trace each Cycle only if Logged
+    if (fp) CYCLE_Set_Trace(psCYC, fp);
+    psCYCLE_ACTIVE = psCYC;
+    fname_dump_active = fname_dump;
+    //
+    // Run as tb_TOP
+    while (CYCLE_SIM == CYCLE_TB)
+    {
+        CYCLE_Get_State(psCYC, &state);
+        if (state.cycle >= CYCLE_TB_FINISH)
+        {
+            DUAL_printf(fp, "***** SIMULATION TIMEOUT ***** at %10" PRIu64 "\n", state.cycle);
+            IOCMP_Write_End(fp_io, state.cycle);
+            break;
+        }
+        event = CYCLE_Run(psCYC, CYCLE_TB_FINISH - state.cycle);
+        CYCLE_Get_State(psCYC, &state);
+        if (event == CYCLE_EV_TXD)
+        {
+            DUAL_printf(fp, "===== UART TxD ===== (OUT) at 0x%02x\n", state.data);
+            IOCMP_Write(fp_io, IOCMP_OUT, state.data, state.cycle);
+        }
+        if (event == CYCLE_EV_RXD)
+        {
+            DUAL_printf(fp, "===== UART RxD ===== (IN ) at 0x%02x\n", state.data);
+            IOCMP_Write(fp_io, IOCMP_IN, state.data, state.cycle);
+        }
+        if (ctrl_c) break;
+    }
+    //
+    // Run as FPGA
+    while (CYCLE_SIM == CYCLE_FPGA)
+    {
+        event = CYCLE_Run(psCYC, 0);
+        CYCLE_Get_State(psCYC, &state);
+        if (event == CYCLE_EV_TXD)
+        {
+            if (ASCII) printf("%c", state.data);
+            if ((ASCII == 0) || (VERBOSE)) printf("CYCLE=%" PRIu64 " OUTPUT=0x%02x(%3d)(%c)\n", state.cycle, state.data, state.data, state.data);
+            if (fp) fprintf(fp, "CYCLE=%" PRIu64 " OUTPUT=0x%02x(%3d)(%c)\n", state.cycle, state.data, state.data, state.data);
+            IOCMP_Write(fp_io, IOCMP_OUT, state.data, state.cycle);
+            fflush(stdout);
+        }
+        else if (event == CYCLE_EV_RXD)
+        {
+            unsigned char data;
+            //
+            data = Sim_Input(state.pc - 1);
+            CYCLE_Feed_RXD(psCYC, data);
+            IOCMP_Write(fp_io, IOCMP_IN, data, state.cycle);
+        }
+        else if (event == CYCLE_EV_RESET)
+        {
+            Sim_Reset_Wait();
+        }
+        if (ctrl_c) break;
+    }
+    if (CYCLE_SIM == CYCLE_FPGA)
+    {
+        CYCLE_Get_State(psCYC, &state);
+        IOCMP_Write_End(fp_io, state.cycle);
+    }
+    ctrl_c = 0;
+    psCYCLE_ACTIVE = NULL;
+    fname_dump_active = NULL;
+    //
+    // Dump RAM
+    if (fname_dump)
+    {
+        unsigned char ram[CYCLE_RAM_SIZE];
+        //
+        CYCLE_Get_RAM(psCYC, ram);
+        Sim_Dump_RAM(ram, CYCLE_RAM_SIZE, fname_dump);
+    }
+    Sim_Cycle_Report(psCYC);
+    CYCLE_Destroy(psCYC);
+}
+
+//----------------------------------
+// Read Hex Image
+//     Decodes Intel Hex text already read
+//     from the Input File, and returns the
+//     Code Size in bytes.
+//----------------------------------
+uint32_t Read_Hex_Image(unsigned char *rom, const unsigned char *buf, uint64_t len)
+{
+    unsigned char *image; // 4bit x 2
+    sHEX_INFO info;
+    int  result;
+    uint32_t addr;
+    uint32_t size;
+    //
+    // Allocate Byte Image
+    size = MAXROM / 2;
+    image = (unsigned char*)malloc(sizeof(unsigned char) * (size + 1));
+    if (image == NULL)
+    {
+        fprintf(stderr, "======== ERROR: Can't allocate ROM area.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(image, (CODE_NOP << 4) | CODE_NOP, size);
+    //
+    // Read Intel Hex Format
+    result = HEX_Read_Buffer(buf, len, image, size, &info);
+    if (result != HEX_OK)
+    {
+        fprintf(stderr, "======== ERROR: %s at line %d, column %d\n",
+            HEX_Error_String(result), info.line, info.column);
+        exit(EXIT_FAILURE);
+    }
+    //
+    // Unpack to ROM (lower address in lower 4bits)
+    memset(rom, CODE_NOP, MAXROM);
+    for (addr = 0; addr < size; addr++)
+    {
+        if ((info.bytes == 0) || (addr > info.addr_max)) break;
+        rom[addr * 2 + 0] = (image[addr] >> 0) & 0x0f;
+        rom[addr * 2 + 1] = (image[addr] >> 4) & 0x0f;
+    }
+    //
+    // Clean Up
+    free(image);
+    return addr;
+}
+
+//----------------------------------
+// Read Binary File
+//     Returns RESULT_NO if the file is
+//     not a Binary Object File, after
+//     loading it as Intel Hex instead.
+//----------------------------------
+int Read_Bin_File(unsigned char *rom, char *fname, sOBJINFO *psOBJ)
+{
+    sBINFILE bin;
+    int  result;
+    uint32_t addr;
+    //
+    // Open and Verify
+    result = BIN_Open(&bin, fname);
+    if (result == BIN_ERR_MAGIC)
+    {
+        psOBJ->code_size = Read_Hex_Image(rom, bin.map.data, bin.map.size);
+        BIN_Close(&bin);
+        return RESULT_NO;
+    }
+    if (result == BIN_ERR_OPEN)
+    {
+        fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", fname);
+        exit(EXIT_FAILURE);
+    }
+    if (result != BIN_OK)
+    {
+        fprintf(stderr, "======== ERROR: %s\n", BIN_Error_String(result));
+        exit(EXIT_FAILURE);
+    }
+    if (((uint64_t)bin.code_size * 2 > (uint64_t)MAXROM) || (bin.entry >= MAXROM))
+    {
+        fprintf(stderr, "======== ERROR: Binary File Overflows ROM Size\n");
+        exit(EXIT_FAILURE);
+    }
+    if ((uint64_t)bin.data_addr + bin.data_size > (uint64_t)MAXRAM)
+    {
+        fprintf(stderr, "======== ERROR: Binary File Overflows RAM Size\n");
+        exit(EXIT_FAILURE);
+    }
+    //
+    // Unpack to ROM (lower address in lower 4bits)
+    memset(rom, CODE_NOP, MAXROM);
+    for (addr = 0; addr < bin.code_size; addr++)
+    {
+        rom[addr * 2 + 0] = (bin.code[addr] >> 0) & 0x0f;
+        rom[addr * 2 + 1] = (bin.code[addr] >> 4) & 0x0f;
+    }
+    //
+    // Keep Data Preload
+    psOBJ->code_size = bin.code_size;
+    psOBJ->entry     = bin.entry;
+    psOBJ->data_addr = bin.data_addr;
+    psOBJ->data_size = bin.data_size;
+    psOBJ->data      = NULL;
+    if (bin.data_size)
+    {
+        psOBJ->data = (unsigned char*)malloc(bin.data_size);
+        if (psOBJ->data == NULL)
+        {
+            fprintf(stderr, "======== ERROR: Can't allocate RAM area.\n");
+            exit(EXIT_FAILURE);
+        }
+        memcpy(psOBJ->data, bin.data, bin.data_size);
+    }
+    BIN_Close(&bin);
+    return RESULT_OK;
 }
 
 //-----------------------------------------
 // Execute Simulation
 //-----------------------------------------
-void Execute_Simulation(sOPTION *psOPTION, unsigned char *rom)
+void Execute_Simulation(sOPTION *psOPTION, unsigned char *rom, sOBJINFO *psOBJ)
 {
     char fname_basename[MAXLEN_WORD];
     char fname_log[MAXLEN_WORD];
@@ -404,11 +1411,47 @@ void Execute_Simulation(sOPTION *psOPTION, unsigned char *rom)
         fp_log = NULL;
     }
     //
+    // Generate I/O Event file
+    if (psOPTION->opt_io)
+    {
+        if (strcmp(psOPTION->input_file_name, psOPTION->opt_io_name) == 0)
+        {
+            fprintf(stderr, "======== ERROR: File Name Confliction\n");
+            exit(EXIT_FAILURE);
+        }
+        fp_io = fopen(psOPTION->opt_io_name, "w");
+        if (fp_io == NULL)
+        {
+            fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", psOPTION->opt_io_name);
+            exit(EXIT_FAILURE);
+        }
+    }
+    //
+    // Inputs of a Recorded Run
+    if (REPLAY_FILE)
+    {
+        if (IOCMP_Read(&replay_in, REPLAY_FILE) != RESULT_OK)
+        {
+            fprintf(stderr, "======== ERROR: Can't open \"%s\".\n", REPLAY_FILE);
+            exit(EXIT_FAILURE);
+        }
+    }
+    //
     // bfCPU Model
-    bfCPU_Model(fp_log, rom);
+    if (SWEEP_IN)
+        Sweep_Model(fp_log, rom, psOBJ);
+    else if (FUZZ_DIR)
+        Fuzz_Model(rom, psOBJ);
+    else if (CYCLE_SIM)
+        Cycle_Model(fp_log, rom, psOBJ, (psOPTION->opt_dump)? psOPTION->opt_dump_name : NULL);
+    else
+        bfCPU_Model(fp_log, rom, psOBJ, (psOPTION->opt_dump)? psOPTION->opt_dump_name : NULL);
     //
     // Close log file
     if (fp_log) fclose(fp_log);
+    if (fp_io) fclose(fp_io);
+    fp_io = NULL;
+    IOCMP_Free(&replay_in);
 }
 
 
@@ -417,9 +1460,9 @@ void Execute_Simulation(sOPTION *psOPTION, unsigned char *rom)
 //-----------------------------------------
 void Do_Sim(sOPTION *psOPTION)
 {
-    char *obj_str;
     unsigned char *rom; // 4bit width
-    int   addr;
+    sOBJINFO obj;
+    uint32_t addr;
     //
     // Allocate ROM
     rom = (unsigned char*)malloc(sizeof(unsigned char) * MAXROM);
@@ -429,18 +1472,22 @@ void Do_Sim(sOPTION *psOPTION)
         exit(EXIT_FAILURE);
     }
     //
-    // Get Hex File as String
-    obj_str = Get_InputFile_as_String(psOPTION);
-    //
-    // Read Hex File
-    Read_Hex_File(rom, obj_str);
+    // Read Object File (Binary or Hex)
+    if (Read_Bin_File(rom, psOPTION->input_file_name, &obj) != RESULT_OK)
+    {
+        obj.entry     = 0;
+        obj.data      = NULL;
+        obj.data_addr = 0;
+        obj.data_size = 0;
+    }
     for (addr = 0; addr < 256; addr++) DEBUG_printf(DEBUG_MAX, "0x%02x 0x%02x\n", addr, rom[addr]);
     //
     // Execute Simulation
-    Execute_Simulation(psOPTION, rom);
+    Execute_Simulation(psOPTION, rom, &obj);
     //
     // Clean Up
-    free(obj_str);
+    if (obj.data) free(obj.data);
+    free(rom);
 }
 
 //===========================================================
@@ -19,13 +19,16 @@
 #define __SIM_H__
 
 //-----------------------------------
-// Increment / Decrement Pointers
-//------------------------------------
-#define INC_PTR(ptr) (((ptr) == (MAXRAM - 1))? 0          : (ptr) + 1)
-#define DEC_PTR(ptr) (((ptr) == 0           )? MAXRAM - 1 : (ptr) - 1)
-//
-#define INC_PC(pc) (((pc) == (MAXROM - 1))? 0          : (pc) + 1)
-#define DEC_PC(pc) (((pc) == 0           )? MAXROM - 1 : (pc) - 1)
+// Object Information
+//-----------------------------------
+typedef struct
+{
+    uint32_t entry;          // Start PC
+    uint32_t code_size;      // Code Size in bytes
+    unsigned char *data;     // Data Preload (NULL if none)
+    uint32_t data_addr;      // Data Preload Address
+    uint32_t data_size;      // Data Preload Size
+} sOBJINFO;
 
 //-------------------------------
 // Prototypes
@@ -20,6 +20,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
+#include <time.h>
 //
 #include "defines.h"
 #include "utility.h"
@@ -199,6 +200,16 @@ int Get_Hex_from_STDIN(unsigned char *hex)
     return RESULT_OK;
 }
 
+//--------------------------------
+// Get Time in Seconds (Monotonic)
+//--------------------------------
+double Get_Time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+}
+
 //------------------------------
 // Get ASCII from STDIN
 //------------------------------
@@ -29,6 +29,7 @@ void String_Concatenate(char *str_1st_half, const char *str_2nd_half, size_t siz
 void String_Copy(char *str_dest, const char *str_src, size_t size);
 int Get_Hex_from_STDIN(unsigned char *hex);
 int Get_ASCII_from_STDIN(unsigned char *ascii);
+double Get_Time(void);
 
 #endif 
 //===========================================================
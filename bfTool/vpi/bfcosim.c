@@ -0,0 +1,556 @@
+//===========================================================
+// bfCPU Assember / Simulator
+//-----------------------------------------------------------
+// File Name   : bfcosim.c
+// Description : Lockstep Co-Simulation with RTL (Icarus VPI)
+//-----------------------------------------------------------
+// History :
+// Rev.01 2026.10.18 M.Maruyama First Release
+//-----------------------------------------------------------
+// Copyright (C) 2025-2026 M.Maruyama
+//===========================================================
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vpi_user.h"
+//
+#include "bfsim.h"
+
+//-----------------------------------------------------------
+// Usage (in Testbench, after the ROM is loaded)
+//     $bfcosim(U_M23LC512.MemoryBlock, U_FPGA.U_TOP.U_CPU);
+//
+//     The first argument is the SRAM array, whose lower half
+//     holds the ROM (two codes per byte, lower nibble first).
+//     The second one is the CPU instance.
+//
+//     The CPU is sampled at every falling edge of CLK after
+//     all events have settled. An instruction retires when
+//     the CPU decodes the next one (or restarts by RESET),
+//     then libbfsim executes it and PC, PTR, the code at PC,
+//     the data memory write and the UART output are compared.
+//     The data memory read of an instruction is compared with
+//     the model before it is executed. Data of IN is taken
+//     from the RTL.
+//
+//     Cells which the RTL does not clear at reset (UART
+//     divider bytes, and 0x1e and above in SIMULATION) get
+//     the value of their first RTL read.
+//-----------------------------------------------------------
+
+//-------------------------------
+// Parameters
+//-------------------------------
+#define COSIM_ROM_SIZE 65536 // codes (PC is 16bits)
+#define COSIM_RAM_SIZE 32768 // bytes (PTR is 15bits)
+#define COSIM_HISTORY  8     // retired instructions shown at mismatch
+//
+#define COSIM_STATE_INIT   0x00 // cpu.sv STATE_INIT
+#define COSIM_STATE_DECODE 0x01 // cpu.sv STATE_DECODE
+#define COSIM_IO_TXD       0x00 // uart.sv TXD/RXD
+
+//-------------------------------
+// CPU Signals
+//-------------------------------
+enum COSIM_SIG
+{
+    SIG_RES,
+    SIG_STATE,
+    SIG_SEQ,
+    SIG_SLOT,
+    SIG_PC,
+    SIG_PTR,
+    SIG_IF_CODE,
+    SIG_DM_REQ,
+    SIG_DM_WRITE,
+    SIG_DM_ADDR,
+    SIG_DM_WDATA,
+    SIG_DM_RDATA,
+    SIG_DM_RDY,
+    SIG_DR_DPHASE,
+    SIG_IO_REQ,
+    SIG_IO_WRITE,
+    SIG_IO_ADDR,
+    SIG_IO_WDATA,
+    SIG_NUM
+};
+//
+static const char *COSIM_SIG_NAME[SIG_NUM] =
+{
+    "RES", "state", "seq", "slot", "pc", "ptr", "if_code",
+    "DM_REQ", "DM_WRITE", "DM_ADDR", "DM_WDATA", "DM_RDATA", "DM_RDY", "dr_do_dphase",
+    "IO_REQ", "IO_WRITE", "IO_ADDR", "IO_WDATA"
+};
+
+//-------------------------------
+// Retired Instruction
+//-------------------------------
+typedef struct
+{
+    uint64_t cycle;
+    uint32_t pc;
+    unsigned char code;
+    uint32_t ptr;       // PTR before execution
+    unsigned char data; // RAM[PTR] after execution
+} sCOSIM_HIST;
+
+//-------------------------------
+// Co-Simulation State
+//-------------------------------
+typedef struct
+{
+    sBFSIM   *psSIM;
+    vpiHandle cpu;
+    vpiHandle clk;
+    vpiHandle sig[SIG_NUM];
+    uint64_t  cycle;   // rising edges after reset
+    uint64_t  retired; // instructions compared
+    uint64_t  adopted; // cells taken from RTL
+    int       failed;
+    //
+    // Decoded, not retired yet
+    int       pending;
+    uint32_t  pend_pc;
+    unsigned char pend_code;
+    uint32_t  pend_ptr;
+    int       dm_write;
+    uint32_t  dm_waddr;
+    unsigned char dm_wdata;
+    int       txd;
+    unsigned char txd_data;
+    //
+    unsigned char known[COSIM_RAM_SIZE]; // written or read by RTL since reset
+    sCOSIM_HIST hist[COSIM_HISTORY];
+    int       hist_pos;
+} sCOSIM;
+//
+static sCOSIM cosim;
+
+//-------------------------------
+// Mnemonic
+//-------------------------------
+static const char *COSIM_Name(unsigned char code)
+{
+    switch(code)
+    {
+        case BFSIM_CODE_PINC  : return "P++  ";
+        case BFSIM_CODE_PDEC  : return "P--  ";
+        case BFSIM_CODE_INC   : return "INC  ";
+        case BFSIM_CODE_DEC   : return "DEC  ";
+        case BFSIM_CODE_OUT   : return "OUT  ";
+        case BFSIM_CODE_IN    : return "IN   ";
+        case BFSIM_CODE_BEGIN : return "BEGIN";
+        case BFSIM_CODE_END   : return "END  ";
+        case BFSIM_CODE_RESET : return "RESET";
+        case BFSIM_CODE_NOP   : return "NOP  ";
+        default               : return "?????";
+    }
+}
+
+//-------------------------------
+// Get Signal Value
+//-------------------------------
+static uint32_t COSIM_Get(int sig)
+{
+    s_vpi_value value;
+    //
+    value.format = vpiIntVal;
+    vpi_get_value(cosim.sig[sig], &value);
+    return (uint32_t)value.value.integer;
+}
+
+//-------------------------------
+// Report Mismatch and Finish
+//-------------------------------
+static void COSIM_Fail(const char *item, uint32_t rtl, uint32_t model)
+{
+    s_vpi_time time;
+    sBFSIM_STATE state;
+    sCOSIM_HIST *psHIST;
+    int i;
+    //
+    time.type = vpiScaledRealTime;
+    vpi_get_time(cosim.cpu, &time);
+    BFSIM_Get_State(cosim.psSIM, &state);
+    //
+    vpi_printf("***** bfCOSIM MISMATCH ***** at Cycle %" PRIu64 " (%.0fns), Instruction %" PRIu64 "\n",
+        cosim.cycle, time.real, cosim.retired);
+    vpi_printf("    %-10s RTL=0x%04x Model=0x%04x\n", item, rtl, model);
+    vpi_printf("    Decoded PC=0x%04x ROM[0x%04x]=0x%1x (%s) PTR=0x%04x\n",
+        cosim.pend_pc, cosim.pend_pc, cosim.pend_code, COSIM_Name(cosim.pend_code), cosim.pend_ptr);
+    vpi_printf("    RTL   : PC=0x%04x PTR=0x%04x STATE=0x%02x SEQ=%d\n",
+        (COSIM_Get(SIG_PC) - 1) & (COSIM_ROM_SIZE - 1), COSIM_Get(SIG_PTR),
+        COSIM_Get(SIG_STATE), COSIM_Get(SIG_SEQ));
+    vpi_printf("    Model : PC=0x%04x PTR=0x%04x RAM[0x%04x]=0x%02x\n",
+        state.pc, state.ptr, state.ptr, BFSIM_Get_RAM(cosim.psSIM, NULL)[state.ptr]);
+    //
+    // Last Retired Instructions
+    vpi_printf("    Last Retired Instructions\n");
+    for (i = 0; i < COSIM_HISTORY; i++)
+    {
+        psHIST = &cosim.hist[(cosim.hist_pos + i) % COSIM_HISTORY];
+        if (psHIST->cycle == 0) continue;
+        vpi_printf("    %10" PRIu64 " : PC=0x%04x ROM[0x%04x]=0x%1x (%s) --> PTR=0x%04x RAM[0x%04x]=0x%02x\n",
+            psHIST->cycle, psHIST->pc, psHIST->pc, psHIST->code, COSIM_Name(psHIST->code),
+            psHIST->ptr, psHIST->ptr, psHIST->data);
+    }
+    //
+    cosim.failed = 1;
+    vpi_control(vpiFinish, 1);
+}
+
+//-------------------------------
+// Data Memory Read by RTL
+//-------------------------------
+static void COSIM_Read(uint32_t addr, unsigned char data)
+{
+    unsigned char *ram = BFSIM_Get_RAM(cosim.psSIM, NULL);
+    //
+    if (cosim.known[addr] == 0)
+    {
+        ram[addr] = data;
+        cosim.known[addr] = 1;
+        cosim.adopted++;
+        return;
+    }
+    if (ram[addr] != data) COSIM_Fail("DM Read", data, ram[addr]);
+}
+
+//-------------------------------
+// Data Memory Write by RTL
+//-------------------------------
+static void COSIM_Write(uint32_t addr, unsigned char data, uint32_t state)
+{
+    unsigned char *ram = BFSIM_Get_RAM(cosim.psSIM, NULL);
+    //
+    cosim.known[addr] = 1;
+    //
+    // Clear at Reset, the model has already cleared RAM
+    if (state == COSIM_STATE_INIT)
+    {
+        if (ram[addr] != data) COSIM_Fail("DM Clear", data, ram[addr]);
+        return;
+    }
+    // Compared at Retire
+    if (cosim.dm_write)
+    {
+        COSIM_Fail("DM Writes", 2, 1);
+        return;
+    }
+    cosim.dm_write = 1;
+    cosim.dm_waddr = addr;
+    cosim.dm_wdata = data;
+}
+
+//-------------------------------
+// Retire Pending Instruction
+//-------------------------------
+static void COSIM_Retire(void)
+{
+    unsigned char *ram = BFSIM_Get_RAM(cosim.psSIM, NULL);
+    sBFSIM_STATE state;
+    sCOSIM_HIST *psHIST;
+    int event;
+    int model_write;
+    //
+    cosim.pending = 0;
+    event = BFSIM_Step(cosim.psSIM);
+    BFSIM_Get_State(cosim.psSIM, &state);
+    //
+    switch(event)
+    {
+        case BFSIM_EV_IN :
+        {
+            if (cosim.dm_write == 0) {COSIM_Fail("IN Data", 0, 1); return;}
+            BFSIM_Feed_Input(cosim.psSIM, cosim.dm_wdata);
+            break;
+        }
+        case BFSIM_EV_OUT :
+        {
+            if (cosim.txd == 0) {COSIM_Fail("UART TXD", 0, 1); return;}
+            if (cosim.txd_data != state.data) {COSIM_Fail("OUT Data", cosim.txd_data, state.data); return;}
+            cosim.txd = 0;
+            break;
+        }
+        case BFSIM_EV_RESET :
+        {
+            memset(cosim.known, 0, sizeof(cosim.known));
+            break;
+        }
+        case BFSIM_EV_LIMIT :
+        {
+            break;
+        }
+        default :
+        {
+            COSIM_Fail("Model Event", 0, event);
+            return;
+        }
+    }
+    if (cosim.txd) {COSIM_Fail("UART TXD", 1, 0); return;}
+    //
+    // Data Memory Write
+    model_write = (cosim.pend_code == BFSIM_CODE_INC)
+               || (cosim.pend_code == BFSIM_CODE_DEC)
+               || (cosim.pend_code == BFSIM_CODE_IN);
+    if (cosim.dm_write != model_write) {COSIM_Fail("DM Write", cosim.dm_write, model_write); return;}
+    if (cosim.dm_write)
+    {
+        if (cosim.dm_waddr != cosim.pend_ptr) {COSIM_Fail("DM Address", cosim.dm_waddr, cosim.pend_ptr); return;}
+        if (cosim.dm_wdata != ram[cosim.dm_waddr]) {COSIM_Fail("DM Data", cosim.dm_wdata, ram[cosim.dm_waddr]); return;}
+    }
+    //
+    // History
+    psHIST = &cosim.hist[cosim.hist_pos];
+    psHIST->cycle = cosim.cycle;
+    psHIST->pc    = cosim.pend_pc;
+    psHIST->code  = cosim.pend_code;
+    psHIST->ptr   = cosim.pend_ptr;
+    psHIST->data  = ram[cosim.pend_ptr];
+    cosim.hist_pos = (cosim.hist_pos + 1) % COSIM_HISTORY;
+    cosim.retired++;
+}
+
+//-------------------------------
+// Instruction Decoded by RTL
+//-------------------------------
+static void COSIM_Decode(void)
+{
+    sBFSIM_STATE state;
+    uint32_t pc, ptr, code;
+    //
+    // PC has already been incremented by the fetch
+    pc   = (COSIM_Get(SIG_PC) - 1) & (COSIM_ROM_SIZE - 1);
+    ptr  = COSIM_Get(SIG_PTR);
+    code = COSIM_Get(SIG_IF_CODE);
+    //
+    BFSIM_Get_State(cosim.psSIM, &state);
+    if (state.pc   != pc  ) {COSIM_Fail("PC",   pc,   state.pc  ); return;}
+    if (state.ptr  != ptr ) {COSIM_Fail("PTR",  ptr,  state.ptr ); return;}
+    if (state.code != code) {COSIM_Fail("Code", code, state.code); return;}
+    //
+    cosim.pending   = 1;
+    cosim.pend_pc   = pc;
+    cosim.pend_code = (unsigned char)code;
+    cosim.pend_ptr  = ptr;
+    cosim.dm_write  = 0;
+    cosim.txd       = 0;
+}
+
+//-------------------------------
+// Sample CPU (Read Only Synch)
+//-------------------------------
+static PLI_INT32 COSIM_Sample(p_cb_data psCB)
+{
+    uint32_t state;
+    //
+    (void)psCB;
+    if (cosim.failed) return 0;
+    if (COSIM_Get(SIG_RES)) return 0;
+    state = COSIM_Get(SIG_STATE);
+    //
+    // Restarted by RESET
+    if ((state == COSIM_STATE_INIT) && cosim.pending) COSIM_Retire();
+    if (cosim.failed) return 0;
+    //
+    // Data Memory Read Data
+    if (COSIM_Get(SIG_DR_DPHASE) && COSIM_Get(SIG_DM_RDY))
+    {
+        COSIM_Read(COSIM_Get(SIG_PTR), (unsigned char)COSIM_Get(SIG_DM_RDATA));
+        if (cosim.failed) return 0;
+    }
+    // Data Memory Write
+    if (COSIM_Get(SIG_DM_REQ) && COSIM_Get(SIG_DM_WRITE))
+    {
+        COSIM_Write(COSIM_Get(SIG_DM_ADDR), (unsigned char)COSIM_Get(SIG_DM_WDATA), state);
+        if (cosim.failed) return 0;
+    }
+    // UART Transmit
+    if (COSIM_Get(SIG_IO_REQ) && COSIM_Get(SIG_IO_WRITE) && (COSIM_Get(SIG_IO_ADDR) == COSIM_IO_TXD))
+    {
+        cosim.txd = 1;
+        cosim.txd_data = (unsigned char)COSIM_Get(SIG_IO_WDATA);
+    }
+    // Decode Next Instruction
+    if ((state == COSIM_STATE_DECODE) && (COSIM_Get(SIG_SEQ) == 0) && COSIM_Get(SIG_SLOT))
+    {
+        if (cosim.pending) COSIM_Retire();
+        if (cosim.failed) return 0;
+        COSIM_Decode();
+    }
+    return 0;
+}
+
+//-------------------------------
+// Clock Edge
+//-------------------------------
+static PLI_INT32 COSIM_Clock(p_cb_data psCB)
+{
+    s_cb_data cb;
+    s_vpi_time time;
+    //
+    if (cosim.failed) return 0;
+    if (psCB->value->value.scalar == vpi1)
+    {
+        if (COSIM_Get(SIG_RES) == 0) cosim.cycle++;
+        return 0;
+    }
+    if (psCB->value->value.scalar != vpi0) return 0;
+    //
+    // Sample after all events at the falling edge
+    time.type = vpiSimTime;
+    time.high = 0;
+    time.low  = 0;
+    memset(&cb, 0, sizeof(cb));
+    cb.reason    = cbReadOnlySynch;
+    cb.cb_rtn    = COSIM_Sample;
+    cb.time      = &time;
+    vpi_register_cb(&cb);
+    return 0;
+}
+
+//-------------------------------
+// End of Simulation
+//-------------------------------
+static PLI_INT32 COSIM_End(p_cb_data psCB)
+{
+    (void)psCB;
+    if (cosim.psSIM == NULL) return 0;
+    if (cosim.failed == 0)
+    {
+        vpi_printf("bfCOSIM: %" PRIu64 " Instructions in %" PRIu64 " Cycles Matched (%" PRIu64 " Cells Taken from RTL).\n",
+            cosim.retired, cosim.cycle, cosim.adopted);
+    }
+    BFSIM_Destroy(cosim.psSIM);
+    cosim.psSIM = NULL;
+    return 0;
+}
+
+//-------------------------------
+// Get Handle in CPU Scope
+//-------------------------------
+static vpiHandle COSIM_Signal(const char *name)
+{
+    char fullname[256];
+    vpiHandle handle;
+    //
+    snprintf(fullname, sizeof(fullname), "%s.%s", vpi_get_str(vpiFullName, cosim.cpu), name);
+    handle = vpi_handle_by_name(fullname, NULL);
+    if (handle == NULL) vpi_printf("bfCOSIM: Can't find %s.\n", fullname);
+    return handle;
+}
+
+//-------------------------------
+// Load ROM from SRAM Array
+//-------------------------------
+static void COSIM_Load_ROM(vpiHandle mem, unsigned char *rom)
+{
+    s_vpi_value value;
+    vpiHandle word;
+    uint32_t addr;
+    //
+    value.format = vpiIntVal;
+    for (addr = 0; addr < COSIM_ROM_SIZE / 2; addr++)
+    {
+        word = vpi_handle_by_index(mem, (PLI_INT32)addr);
+        vpi_get_value(word, &value);
+        rom[addr * 2 + 0] = (unsigned char)((value.value.integer >> 0) & 0x0f);
+        rom[addr * 2 + 1] = (unsigned char)((value.value.integer >> 4) & 0x0f);
+    }
+}
+
+//-------------------------------
+// $bfcosim(mem, cpu)
+//-------------------------------
+static PLI_INT32 COSIM_Calltf(PLI_BYTE8 *user)
+{
+    static unsigned char rom[COSIM_ROM_SIZE];
+    static s_vpi_value clk_value;
+    static s_vpi_time  clk_time;
+    sBFSIM_CONFIG config;
+    s_cb_data cb;
+    vpiHandle args, mem;
+    int i;
+    //
+    (void)user;
+    args = vpi_iterate(vpiArgument, vpi_handle(vpiSysTfCall, NULL));
+    mem        = (args)? vpi_scan(args) : NULL;
+    cosim.cpu  = (mem )? vpi_scan(args) : NULL;
+    if (cosim.cpu) vpi_free_object(args);
+    if (cosim.cpu == NULL)
+    {
+        vpi_printf("bfCOSIM: Usage $bfcosim(sram_array, cpu_instance);\n");
+        vpi_control(vpiFinish, 1);
+        return 0;
+    }
+    //
+    // Signals
+    cosim.clk = COSIM_Signal("CLK");
+    for (i = 0; i < SIG_NUM; i++) cosim.sig[i] = COSIM_Signal(COSIM_SIG_NAME[i]);
+    for (i = 0; i < SIG_NUM; i++) if (cosim.sig[i] == NULL) break;
+    if ((cosim.clk == NULL) || (i < SIG_NUM))
+    {
+        vpi_control(vpiFinish, 1);
+        return 0;
+    }
+    //
+    // Model
+    COSIM_Load_ROM(mem, rom);
+    memset(&config, 0, sizeof(config));
+    config.rom_size = COSIM_ROM_SIZE;
+    config.ram_size = COSIM_RAM_SIZE;
+    config.entry    = 0;
+    cosim.psSIM = BFSIM_Create(rom, &config);
+    if (cosim.psSIM == NULL)
+    {
+        vpi_printf("bfCOSIM: Can't create the model.\n");
+        vpi_control(vpiFinish, 1);
+        return 0;
+    }
+    //
+    // Callbacks
+    clk_value.format = vpiScalarVal;
+    clk_time.type    = vpiSuppressTime;
+    memset(&cb, 0, sizeof(cb));
+    cb.reason = cbValueChange;
+    cb.cb_rtn = COSIM_Clock;
+    cb.obj    = cosim.clk;
+    cb.time   = &clk_time;
+    cb.value  = &clk_value;
+    vpi_register_cb(&cb);
+    //
+    memset(&cb, 0, sizeof(cb));
+    cb.reason = cbEndOfSimulation;
+    cb.cb_rtn = COSIM_End;
+    vpi_register_cb(&cb);
+    //
+    vpi_printf("bfCOSIM: Lockstep with %s Started.\n", vpi_get_str(vpiFullName, cosim.cpu));
+    return 0;
+}
+
+//-------------------------------
+// Register System Task
+//-------------------------------
+static void COSIM_Register(void)
+{
+    s_vpi_systf_data tf;
+    //
+    memset(&tf, 0, sizeof(tf));
+    tf.type   = vpiSysTask;
+    tf.tfname = "$bfcosim";
+    tf.calltf = COSIM_Calltf;
+    vpi_register_systf(&tf);
+}
+//
+void (*vlog_startup_routines[])(void) =
+{
+    COSIM_Register,
+    0
+};
+
+//===========================================================
+// End of File
+//===========================================================